@@ -0,0 +1,81 @@
+// timing_wheel 的测试：回调中调度的定时器
+// 编译运行：g++ -std=c++11 -I../TinySTL timing_wheel_test.cpp -o timing_wheel_test && ./timing_wheel_test
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "timing_wheel.h"
+
+// 回调中调度到当前时间的定时器在下一次 advance 时触发，即使这次 advance 把时间推进到更晚的位置
+static void test_schedule_at_current_tick_in_callback()
+{
+    mystl::timing_wheel<int> w;
+    w.schedule(10, 1);
+    size_t n = w.advance(20, [&](uint64_t, int& v) { if (v == 1) w.schedule(10, 2); });
+    assert(n == 1);
+    assert(w.size() == 1);
+    assert(w.next_event() == 20);
+
+    int fired = 0;
+    n = w.advance(100000, [&](uint64_t d, int& v) { assert(v == 2 && d == 20); ++fired; });
+    assert(n == 1 && fired == 1);
+    assert(w.empty());
+}
+
+// 随机地在回调中调度过去、当前与将来的定时器：每个定时器恰好触发一次，
+// 触发的时间不早于请求的到期时间，且按时间顺序触发
+static void test_random_schedule_in_callback()
+{
+    std::mt19937_64 rng(5);
+    for (int it = 0; it < 500; ++it)
+    {
+        const uint64_t start = it % 2 ? 0 : (rng() >> 2);
+        mystl::timing_wheel<int> w(start);
+        std::vector<int> fired;
+        std::vector<uint64_t> requested;
+        uint64_t now = start, last_fire = start;
+        auto schedule = [&](uint64_t d)
+        {
+            requested.push_back(d);
+            fired.push_back(0);
+            w.schedule(d, static_cast<int>(fired.size() - 1));
+        };
+        for (int k = 0; k < 20; ++k)
+            schedule(now + rng() % 200);
+        for (int op = 0; op < 200; ++op)
+        {
+            const uint64_t t = now + rng() % (op % 7 == 0 ? 100000 : 100);
+            w.advance(t, [&](uint64_t d, int& v)
+            {
+                assert(d <= t && d >= last_fire && d >= requested[v] && !fired[v]);
+                fired[v] = 1;
+                last_fire = d;
+                switch (rng() % 4)
+                {
+                    case 0: schedule(d); break;
+                    case 1: schedule(d > start + 3 ? d - 3 : d); break;
+                    case 2: schedule(d + rng() % 300); break;
+                    default: break;
+                }
+            });
+            now = t;
+            assert(w.now() == t);
+            size_t pending = 0;
+            for (size_t i = 0; i < fired.size(); ++i)
+                pending += fired[i] == 0;
+            assert(pending == w.size());
+            assert(w.empty() || w.next_event() != UINT64_MAX);
+        }
+    }
+}
+
+int main()
+{
+    test_schedule_at_current_tick_in_callback();
+    test_random_schedule_in_callback();
+    std::puts("timing_wheel_test passed");
+    return 0;
+}
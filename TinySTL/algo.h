@@ -9,12 +9,17 @@
 // 这个头文件包含了 mystl 的一系列算法
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <limits>
+#include <type_traits>
 
 #include "algobase.h"
 #include "memory.h"
 #include "heap_algo.h"
 #include "functional.h"
+#include "random.h"
 
 namespace mystl
 {
@@ -67,9 +72,10 @@ namespace mystl
     /*****************************************************************************************/
     // count
     // 对[first, last)区间内的元素与给定值进行比较，缺省使用 operator==，返回元素相等的个数
+    // 算术类型的指针区间(包括 vector 的迭代器)使用 SIMD 内核
     /*****************************************************************************************/
     template <class InputIter, class T>
-        size_t count(InputIter first, InputIter last, const T& value)
+        size_t count_dispatch(InputIter first, InputIter last, const T& value, m_false_type)
         {
             size_t n = 0;
             for (; first != last; ++first)
@@ -80,6 +86,22 @@ namespace mystl
             return n;
         }
 
+    // 算术类型的连续区间使用 SIMD 内核
+    template <class Tp, class T>
+        size_t count_dispatch(Tp* first, Tp* last, const T& value, m_true_type)
+        {
+            typedef typename std::remove_cv<Tp>::type value_type;
+            if (!mystl::simd_representable<value_type>(value))
+                return 0;
+            return mystl::simd_count<value_type>(first, last, static_cast<value_type>(value));
+        }
+
+    template <class InputIter, class T>
+        size_t count(InputIter first, InputIter last, const T& value)
+        {
+            return mystl::count_dispatch(first, last, value, is_simd_find<InputIter, T>());
+        }
+
     /*****************************************************************************************/
     // count_if
     // 对[first, last)区间内的每个元素都进行一元 unary_pred 操作，返回结果为 true 的个数
@@ -99,16 +121,35 @@ namespace mystl
     /*****************************************************************************************/
     // find
     // 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
+    // 算术类型的指针区间(包括 vector 的迭代器)使用 SIMD 内核
     /*****************************************************************************************/
     template <class InputIter, class T>
         InputIter
-        find(InputIter first, InputIter last, const T& value)
+        find_dispatch(InputIter first, InputIter last, const T& value, m_false_type)
         {
             while (first != last && *first != value)
                 ++first;
             return first;
         }
 
+    // 算术类型的连续区间使用 SIMD 内核
+    template <class Tp, class T>
+        Tp*
+        find_dispatch(Tp* first, Tp* last, const T& value, m_true_type)
+        {
+            typedef typename std::remove_cv<Tp>::type value_type;
+            if (!mystl::simd_representable<value_type>(value))
+                return last;
+            return first + (mystl::simd_find<value_type>(first, last, static_cast<value_type>(value)) - first);
+        }
+
+    template <class InputIter, class T>
+        InputIter
+        find(InputIter first, InputIter last, const T& value)
+        {
+            return mystl::find_dispatch(first, last, value, is_simd_find<InputIter, T>());
+        }
+
     /*****************************************************************************************/
     // find_if
     // 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
@@ -138,11 +179,12 @@ namespace mystl
     /*****************************************************************************************/
     // search
     // 在[first1, last1)中查找[first2, last2)的首次出现点
+    // 单字节元素的连续区间使用 SIMD 首尾字节过滤，长模式可以使用 searcher.h 中的搜索器
     /*****************************************************************************************/
     template <class ForwardIter1, class ForwardIter2>
         ForwardIter1
-        search(ForwardIter1 first1, ForwardIter1 last1,
-                ForwardIter2 first2, ForwardIter2 last2)
+        search_dispatch(ForwardIter1 first1, ForwardIter1 last1,
+                ForwardIter2 first2, ForwardIter2 last2, m_false_type)
         {
             auto d1 = mystl::distance(first1, last1);
             auto d2 = mystl::distance(first2, last2);
@@ -174,6 +216,22 @@ namespace mystl
             return first1;
         }
 
+    template <class Tp, class Up>
+        Tp* search_dispatch(Tp* first1, Tp* last1, Up* first2, Up* last2, m_true_type)
+        {
+            typedef typename std::remove_cv<Tp>::type value_type;
+            return first1 + (mystl::simd_search<value_type>(first1, last1, first2, last2) - first1);
+        }
+
+    template <class ForwardIter1, class ForwardIter2>
+        ForwardIter1
+        search(ForwardIter1 first1, ForwardIter1 last1,
+                ForwardIter2 first2, ForwardIter2 last2)
+        {
+            return mystl::search_dispatch(first1, last1, first2, last2,
+                                          is_simd_search<ForwardIter1, ForwardIter2>());
+        }
+
     // 重载版本使用函数对象 comp 代替比较操作
     template <class ForwardIter1, class ForwardIter2, class Compared>
         ForwardIter1
@@ -769,6 +827,147 @@ namespace mystl
             return mystl::ubound_dispatch(first, last, value, iterator_category(first), comp);
         }
 
+    /*****************************************************************************************/
+    // branchless_lower_bound / branchless_upper_bound
+    // 与 lower_bound / upper_bound 的结果相同，只接受随机访问迭代器
+    // 每次比较后以条件传送更新区间的起点，循环次数固定为 ceil(log2(N))，不依赖分支预测；
+    // 同时预取下一轮可能访问的两个位置，适合在较大的静态有序表中做大量随机查询
+    /*****************************************************************************************/
+    // 预取 p 所在的缓存行，不支持的编译器上什么都不做
+    inline void prefetch_read(const void* p) noexcept
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(p, 0, 1);
+#else
+        (void)p;
+#endif
+    }
+
+    template <class RandomIter, class T, class Compared>
+        RandomIter
+        branchless_lower_bound(RandomIter first, RandomIter last, const T& value, Compared comp)
+        {
+            auto len = last - first;
+            if (len == 0)
+                return first;
+            while (len > 1)
+            {  // 答案始终位于 [first, first + len] 中
+                const auto half = len >> 1;
+                const auto next_half = (len - half) >> 1;
+                mystl::prefetch_read(mystl::address_of(first[next_half]));
+                mystl::prefetch_read(mystl::address_of(first[half + next_half]));
+                first = comp(first[half], value) ? first + half : first;
+                len -= half;
+            }
+            return first + static_cast<int>(comp(*first, value));
+        }
+
+    template <class RandomIter, class T>
+        RandomIter
+        branchless_lower_bound(RandomIter first, RandomIter last, const T& value)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            return mystl::branchless_lower_bound(first, last, value, mystl::less<value_type>());
+        }
+
+    template <class RandomIter, class T, class Compared>
+        RandomIter
+        branchless_upper_bound(RandomIter first, RandomIter last, const T& value, Compared comp)
+        {
+            auto len = last - first;
+            if (len == 0)
+                return first;
+            while (len > 1)
+            {
+                const auto half = len >> 1;
+                const auto next_half = (len - half) >> 1;
+                mystl::prefetch_read(mystl::address_of(first[next_half]));
+                mystl::prefetch_read(mystl::address_of(first[half + next_half]));
+                first = !comp(value, first[half]) ? first + half : first;
+                len -= half;
+            }
+            return first + static_cast<int>(!comp(value, *first));
+        }
+
+    template <class RandomIter, class T>
+        RandomIter
+        branchless_upper_bound(RandomIter first, RandomIter last, const T& value)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            return mystl::branchless_upper_bound(first, last, value, mystl::less<value_type>());
+        }
+
+    /*****************************************************************************************/
+    // gallop_forward / gallop_backward
+    // 倍增查找(galloping)：在分界点离起点很近时只需 O(log d) 次比较，d 为到分界点的距离
+    // 用于 stable_sort 的合并，以及长度相差悬殊的有序区间之间的 includes 与集合运算
+    /*****************************************************************************************/
+    constexpr static size_t kGallopRatio = 32;  // 两个有序区间的长度相差该倍数以上时改用倍增查找
+
+    // [first, last) 中满足 pred 的元素都在不满足的元素之前
+    // 从 first 开始以 1, 2, 4, ... 的步长向后试探，再二分查找第一个不满足 pred 的位置
+    template <class RandomIter, class Predicate>
+        RandomIter gallop_forward(RandomIter first, RandomIter last, Predicate pred)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type Distance;
+            const Distance len = last - first;
+            Distance lo = 0;    // [first, first + lo) 都满足 pred
+            Distance hi = len;  // first + hi 不满足 pred 或者为 last
+            Distance step = 1;
+            while (lo + step - 1 < len)
+            {
+                const Distance probe = lo + step - 1;
+                if (!pred(*(first + probe)))
+                {
+                    hi = probe;
+                    break;
+                }
+                lo = probe + 1;
+                step <<= 1;
+            }
+            while (lo < hi)
+            {
+                const Distance mid = lo + (hi - lo) / 2;
+                if (pred(*(first + mid)))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return first + lo;
+        }
+
+    // [first, last) 中不满足 pred 的元素都在满足的元素之前
+    // 从 last 开始向前倍增试探，返回第一个满足 pred 的位置
+    template <class RandomIter, class Predicate>
+        RandomIter gallop_backward(RandomIter first, RandomIter last, Predicate pred)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type Distance;
+            const Distance len = last - first;
+            Distance lo = 0;    // 末尾 lo 个元素都满足 pred
+            Distance hi = len;  // 末尾第 hi + 1 个元素不满足 pred 或者不存在
+            Distance step = 1;
+            while (lo + step <= len)
+            {
+                const Distance probe = lo + step;
+                if (!pred(*(last - probe)))
+                {
+                    hi = probe - 1;
+                    break;
+                }
+                lo = probe;
+                step <<= 1;
+            }
+            while (lo < hi)
+            {
+                const Distance mid = hi - (hi - lo) / 2;
+                if (pred(*(last - mid)))
+                    lo = mid;
+                else
+                    hi = mid - 1;
+            }
+            return last - lo;
+        }
+
     /*****************************************************************************************/
     // binary_search
     // 二分查找，如果在[first, last)内有等同于 value 的元素，返回 true，否则返回 false
@@ -784,7 +983,7 @@ namespace mystl
     template <class ForwardIter, class T, class Compared>
         bool binary_search(ForwardIter first, ForwardIter last, const T& value, Compared comp)
         {
-            auto i = mystl::lower_bound(first, last, value);
+            auto i = mystl::lower_bound(first, last, value, comp);
             return i != last && !comp(value, *i);
         }
 
@@ -971,18 +1170,19 @@ namespace mystl
     /*****************************************************************************************/
     // includes
     // 判断序列一S1 是否包含序列二S2
+    // 两者都是随机访问迭代器且 S1 的长度是 S2 的 kGallopRatio 倍以上时，在 S1 中倍增查找 S2 的每个元素
     /*****************************************************************************************/
-    template <class InputIter1, class InputIter2>
-        bool includes(InputIter1 first1, InputIter1 last1,
-                InputIter2 first2, InputIter2 last2)
+    template <class InputIter1, class InputIter2, class Compared>
+        bool includes_dispatch(InputIter1 first1, InputIter1 last1,
+                InputIter2 first2, InputIter2 last2, Compared comp, m_false_type)
         {
             while (first1 != last1 && first2 != last2)
             {
-                if (*first2 < *first1)
+                if (comp(*first2, *first1))
                 {
                     return false;
                 }
-                else if (*first1 < *first2)
+                else if (comp(*first1, *first2))
                 {
                     ++first1;
                 }
@@ -994,20 +1194,26 @@ namespace mystl
             return first2 == last2;
         }
 
-    // 重载版本使用函数对象 comp 代替比较操作
-    template <class InputIter1, class InputIter2, class Compared>
-        bool includes(InputIter1 first1, InputIter1 last1,
-                InputIter2 first2, InputIter2 last2, Compared comp)
+    template <class RandomIter1, class RandomIter2, class Compared>
+        bool includes_dispatch(RandomIter1 first1, RandomIter1 last1,
+                RandomIter2 first2, RandomIter2 last2, Compared comp, m_true_type)
         {
+            typedef typename iterator_traits<RandomIter1>::value_type value_type;
+            const size_t len1 = static_cast<size_t>(last1 - first1);
+            const size_t len2 = static_cast<size_t>(last2 - first2);
+            if (len2 > len1)
+                return false;
+            if (len1 / kGallopRatio <= len2)
+                return mystl::includes_dispatch(first1, last1, first2, last2, comp, m_false_type());
             while (first1 != last1 && first2 != last2)
             {
                 if (comp(*first2, *first1))
-                {
                     return false;
-                }
-                else if (comp(*first1, *first2))
+                if (comp(*first1, *first2))
                 {
-                    ++first1;
+                    const auto& value = *first2;
+                    first1 = mystl::gallop_forward(first1 + 1, last1, [&](const value_type& x)
+                                                   { return comp(x, value); });
                 }
                 else
                 {
@@ -1017,6 +1223,26 @@ namespace mystl
             return first2 == last2;
         }
 
+    template <class InputIter1, class InputIter2>
+        bool includes(InputIter1 first1, InputIter1 last1,
+                InputIter2 first2, InputIter2 last2)
+        {
+            typedef typename iterator_traits<InputIter1>::value_type value_type;
+            return mystl::includes_dispatch(first1, last1, first2, last2, mystl::less<value_type>(),
+                m_bool_constant<is_random_access_iterator<InputIter1>::value &&
+                                is_random_access_iterator<InputIter2>::value>());
+        }
+
+    // 重载版本使用函数对象 comp 代替比较操作
+    template <class InputIter1, class InputIter2, class Compared>
+        bool includes(InputIter1 first1, InputIter1 last1,
+                InputIter2 first2, InputIter2 last2, Compared comp)
+        {
+            return mystl::includes_dispatch(first1, last1, first2, last2, comp, m_bool_constant<
+                is_random_access_iterator<InputIter1>::value &&
+                is_random_access_iterator<InputIter2>::value>());
+        }
+
     /*****************************************************************************************/
     // is_heap
     // 检查[first, last)内的元素是否为一个堆，如果是，则返回 true
@@ -1130,10 +1356,11 @@ namespace mystl
 
     /*****************************************************************************************/
     // max_element
-    // 返回一个迭代器，指向序列中最大的元素
+    // 返回一个迭代器，指向序列中最大的元素，有多个时指向第一个
+    // 算术类型的指针区间(包括 vector 的迭代器)使用 SIMD 内核
     /*****************************************************************************************/
     template <class ForwardIter>
-        ForwardIter max_element(ForwardIter first, ForwardIter last)
+        ForwardIter max_element_dispatch(ForwardIter first, ForwardIter last, m_false_type)
         {
             if (first == last)
                 return first;
@@ -1146,6 +1373,23 @@ namespace mystl
             return result;
         }
 
+    template <class Tp>
+        Tp* max_element_dispatch(Tp* first, Tp* last, m_true_type)
+        {
+            typedef typename std::remove_cv<Tp>::type value_type;
+            const value_type* min_pos;
+            const value_type* max_pos;
+            if (mystl::simd_minmax_element<value_type>(first, last, min_pos, max_pos, false))
+                return first + (max_pos - first);
+            return mystl::max_element_dispatch(first, last, m_false_type());
+        }
+
+    template <class ForwardIter>
+        ForwardIter max_element(ForwardIter first, ForwardIter last)
+        {
+            return mystl::max_element_dispatch(first, last, is_simd_minmax<ForwardIter>());
+        }
+
     // 重载版本使用函数对象 comp 代替比较操作
     template <class ForwardIter, class Compared>
         ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp)
@@ -1163,10 +1407,11 @@ namespace mystl
 
     /*****************************************************************************************/
     // min_element
-    // 返回一个迭代器，指向序列中最小的元素
+    // 返回一个迭代器，指向序列中最小的元素，有多个时指向第一个
+    // 算术类型的指针区间(包括 vector 的迭代器)使用 SIMD 内核
     /*****************************************************************************************/
     template <class ForwardIter>
-        ForwardIter min_elememt(ForwardIter first, ForwardIter last)
+        ForwardIter min_element_dispatch(ForwardIter first, ForwardIter last, m_false_type)
         {
             if (first == last)
                 return first;
@@ -1179,9 +1424,26 @@ namespace mystl
             return result;
         }
 
+    template <class Tp>
+        Tp* min_element_dispatch(Tp* first, Tp* last, m_true_type)
+        {
+            typedef typename std::remove_cv<Tp>::type value_type;
+            const value_type* min_pos;
+            const value_type* max_pos;
+            if (mystl::simd_minmax_element<value_type>(first, last, min_pos, max_pos, false))
+                return first + (min_pos - first);
+            return mystl::min_element_dispatch(first, last, m_false_type());
+        }
+
+    template <class ForwardIter>
+        ForwardIter min_element(ForwardIter first, ForwardIter last)
+        {
+            return mystl::min_element_dispatch(first, last, is_simd_minmax<ForwardIter>());
+        }
+
     // 重载版本使用函数对象 comp 代替比较操作
     template <class ForwardIter, class Compared>
-        ForwardIter min_elememt(ForwardIter first, ForwardIter last, Compared comp)
+        ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp)
         {
             if (first == last)
                 return first;
@@ -1194,6 +1456,92 @@ namespace mystl
             return result;
         }
 
+    // 旧的拼写，保留以兼容已有的代码
+    template <class ForwardIter>
+        ForwardIter min_elememt(ForwardIter first, ForwardIter last)
+        {
+            return mystl::min_element(first, last);
+        }
+
+    template <class ForwardIter, class Compared>
+        ForwardIter min_elememt(ForwardIter first, ForwardIter last, Compared comp)
+        {
+            return mystl::min_element(first, last, comp);
+        }
+
+    /*****************************************************************************************/
+    // minmax_element
+    // 返回一对迭代器，分别指向序列中第一个最小的元素和最后一个最大的元素
+    // 每次取出两个元素，先比较二者，较小的与当前最小值比较，较大的与当前最大值比较，
+    // 最多进行 3 * (N / 2) 次比较
+    /*****************************************************************************************/
+    template <class ForwardIter, class Compared>
+        mystl::pair<ForwardIter, ForwardIter>
+        minmax_element(ForwardIter first, ForwardIter last, Compared comp)
+        {
+            mystl::pair<ForwardIter, ForwardIter> result(first, first);
+            if (first == last || ++first == last)
+                return result;
+            if (comp(*first, *result.first))
+                result.first = first;
+            else
+                result.second = first;
+            while (++first != last)
+            {
+                auto i = first;
+                if (++first == last)
+                {  // 只剩下一个元素
+                    if (comp(*i, *result.first))
+                        result.first = i;
+                    else if (!comp(*i, *result.second))
+                        result.second = i;
+                    break;
+                }
+                if (comp(*first, *i))
+                {
+                    if (comp(*first, *result.first))
+                        result.first = first;
+                    if (!comp(*i, *result.second))
+                        result.second = i;
+                }
+                else
+                {
+                    if (comp(*i, *result.first))
+                        result.first = i;
+                    if (!comp(*first, *result.second))
+                        result.second = first;
+                }
+            }
+            return result;
+        }
+
+    template <class ForwardIter>
+        mystl::pair<ForwardIter, ForwardIter>
+        minmax_element_dispatch(ForwardIter first, ForwardIter last, m_false_type)
+        {
+            typedef typename iterator_traits<ForwardIter>::value_type value_type;
+            return mystl::minmax_element(first, last, mystl::less<value_type>());
+        }
+
+    template <class Tp>
+        mystl::pair<Tp*, Tp*>
+        minmax_element_dispatch(Tp* first, Tp* last, m_true_type)
+        {
+            typedef typename std::remove_cv<Tp>::type value_type;
+            const value_type* min_pos;
+            const value_type* max_pos;
+            if (mystl::simd_minmax_element<value_type>(first, last, min_pos, max_pos, true))
+                return mystl::make_pair(first + (min_pos - first), first + (max_pos - first));
+            return mystl::minmax_element_dispatch(first, last, m_false_type());
+        }
+
+    template <class ForwardIter>
+        mystl::pair<ForwardIter, ForwardIter>
+        minmax_element(ForwardIter first, ForwardIter last)
+        {
+            return mystl::minmax_element_dispatch(first, last, is_simd_minmax<ForwardIter>());
+        }
+
     /*****************************************************************************************/
     // swap_ranges
     // 将[first1, last1)从 first2 开始，交换相同个数元素
@@ -1417,22 +1765,42 @@ namespace mystl
         }
 
     /*****************************************************************************************/
-    // random_shuffle
-    // 将[first, last)内的元素次序随机重排
-    // 重载版本使用一个产生随机数的函数对象 rand
+    // shuffle
+    // 以随机数引擎 g 将[first, last)内的元素次序随机重排(Fisher-Yates)，每种排列出现的概率相同
+    // 随机下标由 uniform_int 产生，没有取模带来的偏差；相同的引擎状态总是得到相同的结果
     /*****************************************************************************************/
-    template <class RandomIter>
-        void random_shuffle(RandomIter first, RandomIter last)
+    template <class RandomIter, class URBG>
+        void shuffle(RandomIter first, RandomIter last, URBG&& g)
         {
             if (first == last)
                 return;
-            srand((unsigned)time(0));
-            for (auto i = first + 1; i != last; ++i)
+            const uint64_t len = static_cast<uint64_t>(last - first);
+            for (uint64_t i = 1; i < len; ++i)
             {
-                mystl::iter_swap(i, first + (rand() % (i - first + 1)));
+                mystl::iter_swap(first + i, first + mystl::uniform_int(g, i + 1));
             }
         }
 
+    /*****************************************************************************************/
+    // random_shuffle
+    // 将[first, last)内的元素次序随机重排
+    // 第一个版本使用每个线程各自的 default_random_engine，首次使用时以时间和线程的地址为种子，
+    // 需要复现结果时使用 shuffle 并指定引擎
+    // 重载版本使用一个产生随机数的函数对象 rand，rand(n) 返回 [0, n) 中的随机数
+    /*****************************************************************************************/
+    inline default_random_engine& thread_random_engine()
+    {
+        static thread_local default_random_engine engine(
+            static_cast<uint64_t>(time(0)) ^ reinterpret_cast<uintptr_t>(&engine));
+        return engine;
+    }
+
+    template <class RandomIter>
+        void random_shuffle(RandomIter first, RandomIter last)
+        {
+            mystl::shuffle(first, last, mystl::thread_random_engine());
+        }
+
     // 重载版本使用一个产生随机数的函数对象 rand
     template <class RandomIter, class RandomNumberGenerator>
         void random_shuffle(RandomIter first, RandomIter last,
@@ -1440,11 +1808,62 @@ namespace mystl
         {
             if (first == last)
                 return;
-            auto len = mystl::distance(first, last);
             for (auto i = first + 1; i != last; ++i)
             {
-                mystl::iter_swap(i, first + (rand(i - first + 1) % len));
+                mystl::iter_swap(i, first + rand(i - first + 1));
+            }
+        }
+
+    /*****************************************************************************************/
+    // sample
+    // 从[first, last)中不重复地随机选出 n 个元素(不足 n 个时选出全部)写入 out，返回输出的尾部
+    // 前向迭代器使用选择抽样(selection sampling)：依次以 剩余需要的个数 / 剩余元素个数 的概率选中
+    // 当前元素，结果保持原来的相对次序，只遍历一次
+    // 输入迭代器使用蓄水池抽样(reservoir sampling)：先放入前 n 个元素，之后第 i 个元素以 n / i
+    // 的概率替换蓄水池中随机的一个，out 必须是随机访问迭代器，结果的次序是随机的
+    /*****************************************************************************************/
+    template <class ForwardIter, class OutputIter, class Distance, class URBG>
+        OutputIter
+        sample_dispatch(ForwardIter first, ForwardIter last, OutputIter out, Distance n,
+                        URBG& g, forward_iterator_tag)
+        {
+            uint64_t remain = static_cast<uint64_t>(mystl::distance(first, last));
+            uint64_t need = !(n > 0) ? 0 : mystl::min(static_cast<uint64_t>(n), remain);
+            for (; need != 0; ++first, --remain)
+            {
+                if (mystl::uniform_int(g, remain) < need)
+                {
+                    *out = *first;
+                    ++out;
+                    --need;
+                }
+            }
+            return out;
+        }
+
+    template <class InputIter, class RandomIter, class Distance, class URBG>
+        RandomIter
+        sample_dispatch(InputIter first, InputIter last, RandomIter out, Distance n,
+                        URBG& g, input_iterator_tag)
+        {
+            uint64_t k = 0;
+            const uint64_t size = !(n > 0) ? 0 : static_cast<uint64_t>(n);
+            for (; first != last && k < size; ++first, ++k)
+                out[k] = *first;
+            for (uint64_t seen = k; first != last; ++first)
+            {
+                const uint64_t r = mystl::uniform_int(g, ++seen);
+                if (r < size)
+                    out[r] = *first;
             }
+            return out + k;
+        }
+
+    template <class InputIter, class OutputIter, class Distance, class URBG>
+        OutputIter
+        sample(InputIter first, InputIter last, OutputIter out, Distance n, URBG&& g)
+        {
+            return mystl::sample_dispatch(first, last, out, n, g, iterator_category(first));
         }
 
     /*****************************************************************************************/
@@ -2167,6 +2586,36 @@ namespace mystl
             mystl::inplace_merge_aux(first, middle, last, value_type(first), comp);
         }
 
+    // 使用调用者提供的缓冲区，缓冲区在调用结束后保留，可以用于下一次调用
+    template <class BidirectionalIter, class Compared, class T>
+        void
+        inplace_merge(BidirectionalIter first, BidirectionalIter middle,
+                BidirectionalIter last, Compared comp, merge_buffer<T>& buffer)
+        {
+            if (first == middle || middle == last)
+                return;
+            auto len1 = mystl::distance(first, middle);
+            auto len2 = mystl::distance(middle, last);
+            buffer.reserve(mystl::min(len1, len2), *first);
+            if (!buffer.begin())
+            {
+                mystl::merge_without_buffer(first, middle, last, len1, len2, comp);
+            }
+            else
+            {
+                mystl::merge_adaptive(first, middle, last, len1, len2, buffer.begin(),
+                                      static_cast<decltype(len1)>(buffer.size()), comp);
+            }
+        }
+
+    template <class BidirectionalIter, class T>
+        void
+        inplace_merge(BidirectionalIter first, BidirectionalIter middle,
+                BidirectionalIter last, merge_buffer<T>& buffer)
+        {
+            mystl::inplace_merge(first, middle, last, mystl::less<T>(), buffer);
+        }
+
     /*****************************************************************************************/
     // partial_sort
     // 对整个序列做部分排序，保证较小的 N 个元素以递增顺序置于[first, first + N)中
@@ -2287,11 +2736,17 @@ namespace mystl
     // partition
     // 对区间内的元素重排，被一元条件运算判定为 true 的元素会放到区间的前段
     // 该函数不保证元素的原始相对位置
+    // 随机访问迭代器使用块分割：从两端各取一块元素，把放错一侧的元素的偏移写入数组，
+    // 偏移数组的长度以判定结果累加，不产生难以预测的分支，再成对交换
+    // 每个元素恰好判定一次
     /*****************************************************************************************/
+    constexpr static size_t kPartitionBlockSize = 64;   // 块分割中每块的元素个数
+
+    // partition 的 bidirectional_iterator_tag 版本
     template <class BidirectionalIter, class UnaryPredicate>
         BidirectionalIter
-        partition(BidirectionalIter first, BidirectionalIter last,
-                UnaryPredicate unary_pred)
+        partition_dispatch(BidirectionalIter first, BidirectionalIter last,
+                UnaryPredicate unary_pred, bidirectional_iterator_tag)
         {
             while (true)
             {
@@ -2314,36 +2769,539 @@ namespace mystl
             return first;
         }
 
-    /*****************************************************************************************/
-    // partition_copy
-    // 行为与 partition 类似，不同的是，将被一元操作符判定为 true 的放到 result_true 的输出区间
-    // 其余放到 result_false 的输出区间，并返回一个 mystl::pair 指向这两个区间的尾部
-    /*****************************************************************************************/
-    template <class InputIter, class OutputIter1, class OutputIter2, class UnaryPredicate>
-        mystl::pair<OutputIter1, OutputIter2>
-        partition_copy(InputIter first, InputIter last,
-                OutputIter1 result_true, OutputIter2 result_false,
-                UnaryPredicate unary_pred)
-        {
-            for (; first != last; ++first)
+    // partition 的 random_access_iterator_tag 版本
+    template <class RandomIter, class UnaryPredicate>
+        RandomIter
+        partition_dispatch(RandomIter first, RandomIter last,
+                UnaryPredicate unary_pred, random_access_iterator_tag)
+        {
+            unsigned char loff[kPartitionBlockSize];  // 左侧块中判定为 false 的元素的偏移
+            unsigned char roff[kPartitionBlockSize];  // 右侧块中判定为 true 的元素到块尾的距离
+            auto lbase = first;
+            auto rbase = last;
+            size_t lnum = 0, rnum = 0, lstart = 0, rstart = 0;
+            while (first < last)
             {
-                if (unary_pred(*first))
+                // 决定本轮两侧各扫描多少元素，剩余不足两块时平分
+                const size_t unknown = static_cast<size_t>(last - first);
+                const size_t lsplit = lnum == 0 ? (rnum == 0 ? unknown / 2 : unknown) : 0;
+                const size_t rsplit = rnum == 0 ? unknown - lsplit : 0;
+                const size_t lcount = mystl::min(lsplit, kPartitionBlockSize);
+                const size_t rcount = mystl::min(rsplit, kPartitionBlockSize);
+                for (size_t i = 0; i < lcount; ++i)
                 {
-                    *result_true++ = *first;
+                    loff[lnum] = static_cast<unsigned char>(i);
+                    lnum += !unary_pred(*first);
+                    ++first;
                 }
-                else
+                for (size_t i = 1; i <= rcount; ++i)
                 {
-                    *result_false++ = *first;
+                    roff[rnum] = static_cast<unsigned char>(i);
+                    rnum += static_cast<bool>(unary_pred(*--last));
+                }
+
+                const size_t n = mystl::min(lnum, rnum);
+                for (size_t i = 0; i < n; ++i)
+                    mystl::iter_swap(lbase + loff[lstart + i], rbase - roff[rstart + i]);
+                lnum -= n;
+                rnum -= n;
+                lstart += n;
+                rstart += n;
+                if (lnum == 0)
+                {
+                    lstart = 0;
+                    lbase = first;
+                }
+                if (rnum == 0)
+                {
+                    rstart = 0;
+                    rbase = last;
+                }
+            }
+
+            // 区间已扫描完，把仍未配对的元素交换到分界处
+            while (lnum != 0)
+            {
+                --lnum;
+                mystl::iter_swap(lbase + loff[lstart + lnum], --last);
+            }
+            while (rnum != 0)
+            {
+                --rnum;
+                mystl::iter_swap(rbase - roff[rstart + rnum], last);
+                ++last;
+            }
+            return last;
+        }
+
+    template <class BidirectionalIter, class UnaryPredicate>
+        BidirectionalIter
+        partition(BidirectionalIter first, BidirectionalIter last,
+                UnaryPredicate unary_pred)
+        {
+            return mystl::partition_dispatch(first, last, unary_pred, iterator_category(first));
+        }
+
+    /*****************************************************************************************/
+    // stable_partition
+    // 对区间内的元素重排，被一元条件运算判定为 true 的元素放到区间的前段，并保持元素的原始相对位置
+    // 缓冲区足够时只扫描一次：判定为 true 的元素依次前移，其余的暂存到缓冲区，最后移回尾部；
+    // 缓冲区不足时把区间分成两半分别处理，再把中间的两段互换
+    // 可以传入 merge_buffer 在多次调用之间复用缓冲区，避免每次调用都申请内存
+    /*****************************************************************************************/
+    // 缓冲区能容纳整个区间时的一次扫描，要求 *first 判定为 false
+    template <class BidirectionalIter, class Pointer, class UnaryPredicate>
+        BidirectionalIter
+        stable_partition_buffered(BidirectionalIter first, BidirectionalIter last,
+                Pointer buffer, UnaryPredicate unary_pred, m_false_type)
+        {
+            auto result = first;
+            auto buffer_end = buffer;
+            for (; first != last; ++first)
+            {
+                if (unary_pred(*first))
+                {
+                    *result = mystl::move(*first);
+                    ++result;
+                }
+                else
+                {
+                    *buffer_end = mystl::move(*first);
+                    ++buffer_end;
+                }
+            }
+            mystl::move(buffer, buffer_end, result);
+            return result;
+        }
+
+    // 随机访问迭代器且元素可以平凡复制时，每个元素同时写入两个目标，
+    // 以判定结果推进其中一个下标，消除分支
+    template <class RandomIter, class Pointer, class UnaryPredicate>
+        RandomIter
+        stable_partition_buffered(RandomIter first, RandomIter last,
+                Pointer buffer, UnaryPredicate unary_pred, m_true_type)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            size_t t = 0, f = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto value = first[i];
+                const bool p = static_cast<bool>(unary_pred(value));
+                first[t] = value;
+                buffer[f] = value;
+                t += p;
+                f += !p;
+            }
+            mystl::copy(buffer, buffer + f, first + t);
+            return first + t;
+        }
+
+    // 要求 *first 判定为 false，len 为区间的长度
+    template <class BidirectionalIter, class Pointer, class Distance, class UnaryPredicate>
+        BidirectionalIter
+        stable_partition_adaptive(BidirectionalIter first, BidirectionalIter last,
+                UnaryPredicate unary_pred, Distance len,
+                Pointer buffer, Distance buffer_size)
+        {
+            typedef typename iterator_traits<BidirectionalIter>::value_type value_type;
+            typedef typename iterator_traits<BidirectionalIter>::iterator_category Category;
+            if (len == 1)
+                return first;
+            if (len <= buffer_size)
+            {
+                return mystl::stable_partition_buffered(first, last, buffer, unary_pred,
+                    m_bool_constant<std::is_trivially_copyable<value_type>::value &&
+                                    std::is_convertible<Category, random_access_iterator_tag>::value>());
+            }
+            const Distance half = len / 2;
+            auto middle = first;
+            mystl::advance(middle, half);
+            auto left_split = mystl::stable_partition_adaptive(first, middle, unary_pred, half,
+                                                               buffer, buffer_size);
+            // 右半段开头判定为 true 的元素已经就位
+            Distance right_len = len - half;
+            auto right_split = middle;
+            while (right_len > 0 && unary_pred(*right_split))
+            {
+                ++right_split;
+                --right_len;
+            }
+            if (right_len > 0)
+            {
+                right_split = mystl::stable_partition_adaptive(right_split, last, unary_pred,
+                                                               right_len, buffer, buffer_size);
+            }
+            if (left_split == middle)
+                return right_split;
+            if (middle == right_split)
+                return left_split;
+            return mystl::rotate_adaptive(left_split, middle, right_split,
+                                          mystl::distance(left_split, middle),
+                                          mystl::distance(middle, right_split),
+                                          buffer, buffer_size);
+        }
+
+    template <class BidirectionalIter, class UnaryPredicate, class T>
+        BidirectionalIter
+        stable_partition(BidirectionalIter first, BidirectionalIter last,
+                UnaryPredicate unary_pred, merge_buffer<T>& buffer)
+        {
+            // 跳过开头判定为 true 与末尾判定为 false 的元素
+            first = mystl::find_if_not(first, last, unary_pred);
+            if (first == last)
+                return first;
+            --last;
+            while (first != last && !unary_pred(*last))
+                --last;
+            if (first == last)
+                return first;
+            ++last;
+            const auto len = mystl::distance(first, last);
+            buffer.reserve(len, *first);
+            return mystl::stable_partition_adaptive(first, last, unary_pred, len, buffer.begin(),
+                                                    static_cast<decltype(len)>(buffer.size()));
+        }
+
+    template <class BidirectionalIter, class UnaryPredicate>
+        BidirectionalIter
+        stable_partition(BidirectionalIter first, BidirectionalIter last,
+                UnaryPredicate unary_pred)
+        {
+            typedef typename iterator_traits<BidirectionalIter>::value_type value_type;
+            merge_buffer<value_type> buffer;
+            return mystl::stable_partition(first, last, unary_pred, buffer);
+        }
+
+    /*****************************************************************************************/
+    // partition_copy
+    // 行为与 partition 类似，不同的是，将被一元操作符判定为 true 的放到 result_true 的输出区间
+    // 其余放到 result_false 的输出区间，并返回一个 mystl::pair 指向这两个区间的尾部
+    /*****************************************************************************************/
+    template <class InputIter, class OutputIter1, class OutputIter2, class UnaryPredicate>
+        mystl::pair<OutputIter1, OutputIter2>
+        partition_copy(InputIter first, InputIter last,
+                OutputIter1 result_true, OutputIter2 result_false,
+                UnaryPredicate unary_pred)
+        {
+            for (; first != last; ++first)
+            {
+                if (unary_pred(*first))
+                {
+                    *result_true++ = *first;
+                }
+                else
+                {
+                    *result_false++ = *first;
                 }
             }
             return mystl::pair<OutputIter1, OutputIter2>(result_true, result_false);
         }
 
+    /*****************************************************************************************/
+    // radix_sort
+    // LSD 基数排序：用函数对象 key 从元素中提取算术类型的关键字，按关键字的字节从低到高做稳定的计数排序
+    // 第一遍扫描同时统计所有字节的直方图，所有元素在某个字节上都相同时跳过该趟
+    // 关键字被映射为保持大小顺序的无符号整数：有符号整数翻转符号位，浮点数按符号位取反或翻转符号位
+    // msd_radix_sort：对字节串(支持 size() 与 operator[])按字节从高到低做原地的 MSD 基数排序
+    // 元素个数较少的桶改用插入排序
+    /*****************************************************************************************/
+    // 以下函数定义见后文 sort
+    template <class RandomIter, class Compared>
+        void insertion_sort(RandomIter first, RandomIter last, Compared comp);
+    template <class RandomIter, class Compared>
+        void sort(RandomIter first, RandomIter last, Compared comp);
+
+    constexpr static size_t kRadixSortThreshold = 64;     // 元素个数小于该值时使用插入排序
+    constexpr static size_t kRadixSortRouteSize = 1024;   // sort 在元素个数不小于该值时改用 radix_sort
+    constexpr static size_t kMsdRadixSortThreshold = 32;  // msd_radix_sort 中小于该值的桶使用插入排序
+
+    // 与关键字字节数相同的无符号整数类型
+    template <size_t N>
+        struct radix_unsigned {};
+
+    template <> struct radix_unsigned<1> { typedef uint8_t  type; };
+    template <> struct radix_unsigned<2> { typedef uint16_t type; };
+    template <> struct radix_unsigned<4> { typedef uint32_t type; };
+    template <> struct radix_unsigned<8> { typedef uint64_t type; };
+
+    // 判断 T 能否作为基数排序的关键字：不超过 8 字节的整数，以及 IEEE 754 的 float / double
+    template <class T>
+        struct is_radix_sortable : public m_bool_constant<
+                                   (std::is_integral<T>::value && sizeof(T) <= 8) ||
+                                   (std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559 &&
+                                    (sizeof(T) == 4 || sizeof(T) == 8))> {};
+
+    // 将关键字映射为保持大小顺序的无符号整数
+    template <class T, bool = std::is_floating_point<T>::value>
+        struct radix_key_traits
+        {
+            typedef typename radix_unsigned<sizeof(T)>::type key_type;
+
+            static key_type encode(T x) noexcept
+            {
+                const key_type sign = std::is_signed<T>::value
+                    ? static_cast<key_type>(key_type(1) << (sizeof(T) * 8 - 1)) : key_type(0);
+                return static_cast<key_type>(static_cast<key_type>(x) ^ sign);
+            }
+        };
+
+    template <class T>
+        struct radix_key_traits<T, true>
+        {
+            typedef typename radix_unsigned<sizeof(T)>::type key_type;
+
+            static key_type encode(T x) noexcept
+            {
+                key_type bits;
+                std::memcpy(&bits, &x, sizeof(T));
+                const key_type sign = static_cast<key_type>(key_type(1) << (sizeof(T) * 8 - 1));
+                // 负数取反使其按绝对值逆序排列，非负数翻转符号位使其排在负数之后
+                return (bits & sign) ? static_cast<key_type>(~bits) : static_cast<key_type>(bits ^ sign);
+            }
+        };
+
+    // 默认的关键字提取函数对象，关键字即元素本身
+    template <class T>
+        struct radix_identity : public unarg_function<T, T>
+    {
+        const T& operator()(const T& x) const { return x; }
+    };
+
+    // 按提取出的关键字比较两个元素，用于插入排序与申请缓冲区失败时的退化情况
+    template <class KeyFunc>
+        struct radix_key_less
+        {
+            KeyFunc key;
+
+            explicit radix_key_less(KeyFunc k) : key(k) {}
+
+            template <class T>
+                bool operator()(const T& x, const T& y) const
+                {
+                    typedef typename std::decay<decltype(key(x))>::type key_value;
+                    return radix_key_traits<key_value>::encode(key(x)) <
+                        radix_key_traits<key_value>::encode(key(y));
+                }
+        };
+
+    // 按第 pass 个字节把[first, last)分配到 result 开始的区间中
+    template <class InputIter, class OutputIter, class KeyFunc>
+        void radix_scatter(InputIter first, InputIter last, OutputIter result,
+                           size_t* offset, size_t pass, KeyFunc& key)
+        {
+            typedef typename std::decay<decltype(key(*first))>::type key_value;
+            const size_t shift = pass * 8;
+            for (; first != last; ++first)
+            {
+                const size_t byte = static_cast<size_t>(
+                    (radix_key_traits<key_value>::encode(key(*first)) >> shift) & 0xff);
+                *(result + offset[byte]++) = mystl::move(*first);
+            }
+        }
+
+    // LSD 基数排序的主体，buffer 的长度不小于 last - first
+    template <class RandomIter, class Pointer, class KeyFunc>
+        void radix_sort_lsd(RandomIter first, RandomIter last, Pointer buffer, KeyFunc& key)
+        {
+            typedef typename std::decay<decltype(key(*first))>::type key_value;
+            typedef typename radix_key_traits<key_value>::key_type   key_type;
+            const size_t passes = sizeof(key_type);
+            const size_t n = static_cast<size_t>(last - first);
+
+            // 直方图预处理：一次扫描统计所有字节
+            size_t count[sizeof(key_type)][256] = {};
+            for (auto it = first; it != last; ++it)
+            {
+                key_type k = radix_key_traits<key_value>::encode(key(*it));
+                for (size_t p = 0; p < passes; ++p, k = static_cast<key_type>(k >> 4 >> 4))
+                    ++count[p][k & 0xff];
+            }
+
+            bool in_buffer = false;  // 当前数据是否位于缓冲区中
+            for (size_t p = 0; p < passes; ++p)
+            {
+                size_t* c = count[p];
+                size_t sum = 0;
+                bool trivial = false;
+                for (size_t b = 0; b < 256; ++b)
+                {
+                    if (c[b] == n)
+                    { // 所有元素在该字节上都相同，跳过这一趟
+                        trivial = true;
+                        break;
+                    }
+                    const size_t tmp = c[b];
+                    c[b] = sum;
+                    sum += tmp;
+                }
+                if (trivial)
+                    continue;
+                if (in_buffer)
+                    mystl::radix_scatter(buffer, buffer + n, first, c, p, key);
+                else
+                    mystl::radix_scatter(first, last, buffer, c, p, key);
+                in_buffer = !in_buffer;
+            }
+            if (in_buffer)
+                mystl::move(buffer, buffer + n, first);
+        }
+
+    template <class RandomIter, class KeyFunc, class T>
+        void radix_sort_aux(RandomIter first, RandomIter last, KeyFunc& key, T*)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            scratch_buffer<T> buf(first, n, std::nothrow);
+            if (buf.size() < n)
+            { // 申请缓冲区失败，改用比较排序
+                mystl::sort(first, last, radix_key_less<KeyFunc>(key));
+                return;
+            }
+            mystl::radix_sort_lsd(first, last, buf.begin(), key);
+        }
+
+    template <class RandomIter, class KeyFunc>
+        void radix_sort(RandomIter first, RandomIter last, KeyFunc key)
+        {
+            if (static_cast<size_t>(last - first) < kRadixSortThreshold)
+            {
+                mystl::insertion_sort(first, last, radix_key_less<KeyFunc>(key));
+                return;
+            }
+            mystl::radix_sort_aux(first, last, key, value_type(first));
+        }
+
+    template <class RandomIter>
+        void radix_sort(RandomIter first, RandomIter last)
+        {
+            mystl::radix_sort(first, last,
+                              radix_identity<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    // msd_radix_sort
+    // 第 depth 个字节所在的桶，字符串已经结束时为 0 号桶
+    template <class String>
+        size_t radix_string_bucket(const String& s, size_t depth)
+        {
+            return depth < static_cast<size_t>(s.size())
+                ? static_cast<size_t>(static_cast<unsigned char>(s[depth])) + 1 : 0;
+        }
+
+    // 从第 depth 个字节开始按无符号字节比较两个字符串
+    struct radix_string_less
+    {
+        size_t depth;
+
+        explicit radix_string_less(size_t d) : depth(d) {}
+
+        template <class String>
+            bool operator()(const String& x, const String& y) const
+            {
+                const size_t xn = static_cast<size_t>(x.size());
+                const size_t yn = static_cast<size_t>(y.size());
+                const size_t n = xn < yn ? xn : yn;
+                for (size_t i = depth; i < n; ++i)
+                {
+                    const unsigned char a = static_cast<unsigned char>(x[i]);
+                    const unsigned char b = static_cast<unsigned char>(y[i]);
+                    if (a != b)
+                        return a < b;
+                }
+                return xn < yn;
+            }
+    };
+
+    template <class RandomIter>
+        void msd_radix_sort_aux(RandomIter first, RandomIter last, size_t depth)
+        {
+            while (true)
+            {
+                const size_t n = static_cast<size_t>(last - first);
+                if (n < kMsdRadixSortThreshold)
+                {
+                    mystl::insertion_sort(first, last, radix_string_less(depth));
+                    return;
+                }
+                size_t count[257] = {};
+                for (auto it = first; it != last; ++it)
+                    ++count[mystl::radix_string_bucket(*it, depth)];
+                if (count[0] == n)  // 所有字符串都已结束
+                    return;
+
+                bool single = false;
+                for (size_t b = 1; b < 257; ++b)
+                {
+                    if (count[b] == n)
+                    {
+                        single = true;
+                        break;
+                    }
+                }
+                if (single)
+                { // 所有元素在该字节上都相同，直接比较下一个字节
+                    ++depth;
+                    continue;
+                }
+
+                // American flag sort：原地把每个元素交换到所属的桶中
+                RandomIter head[257];
+                RandomIter tail[257];
+                RandomIter pos = first;
+                for (size_t b = 0; b < 257; ++b)
+                {
+                    head[b] = pos;
+                    pos += count[b];
+                    tail[b] = pos;
+                }
+                for (size_t b = 0; b < 257; ++b)
+                {
+                    while (head[b] != tail[b])
+                    {
+                        const size_t v = mystl::radix_string_bucket(*head[b], depth);
+                        if (v == b)
+                        {
+                            ++head[b];
+                        }
+                        else
+                        {
+                            mystl::iter_swap(head[b], head[v]);
+                            ++head[v];
+                        }
+                    }
+                }
+
+                // 0 号桶中的字符串都已结束且相等，其余的桶比较下一个字节
+                pos = first + count[0];
+                for (size_t b = 1; b < 257; ++b)
+                {
+                    if (count[b] > 1)
+                        mystl::msd_radix_sort_aux(pos, pos + count[b], depth + 1);
+                    pos += count[b];
+                }
+                return;
+            }
+        }
+
+    template <class RandomIter>
+        void msd_radix_sort(RandomIter first, RandomIter last)
+        {
+            if (last - first > 1)
+                mystl::msd_radix_sort_aux(first, last, 0);
+        }
+
     /*****************************************************************************************/
     // sort
     // 将[first, last)内的元素以递增的方式排序
+    // 采用 pattern-defeating quicksort(pdqsort)：
+    //   已经有序或严格逆序的区间经一次线性扫描后直接返回
+    //   长区间用 ninther 选取枢轴，枢轴与左侧相邻区间的元素相等时把相等的元素一次分出
+    //   分割极不平衡时打乱部分元素以破坏输入的模式，次数过多时改用 heap sort
+    //   分割时没有发生交换则尝试有限步的插入排序，近乎有序的输入只需线性时间
+    //   算术类型配合 less / greater 时使用无分支的块分割
     /*****************************************************************************************/
-    constexpr static size_t kSmallSectionSize = 128;  // 小型区间的大小，在这个大小内采用插入排序
+    constexpr static size_t kPdqInsertionSortThreshold = 24;    // 小于该长度的区间使用插入排序
+    constexpr static size_t kPdqNintherThreshold = 128;         // 大于该长度的区间使用 ninther 选取枢轴
+    constexpr static size_t kPdqPartialInsertionSortLimit = 8;  // 尝试插入排序时最多移动的元素个数
+    constexpr static size_t kPdqBlockSize = 64;                 // 块分割中每块的元素个数
 
     // 用于控制分割恶化的情况
     template <class Size>
@@ -2374,25 +3332,6 @@ namespace mystl
             }
         }
 
-    // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-    template <class RandomIter, class Size>
-        void intro_sort(RandomIter first, RandomIter last, Size depth_limit)
-        {
-            while (static_cast<size_t>(last - first) > kSmallSectionSize)
-            {
-                if (depth_limit == 0)
-                {                      // 到达最大分割深度限制
-                    mystl::partial_sort(first, last, last);  // 改用 heap_sort
-                    return;
-                }
-                --depth_limit;
-                auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
-                auto cut = mystl::unchecked_partition(first, last, mid);
-                mystl::intro_sort(cut, last, depth_limit);
-                last = cut;
-            }
-        }
-
     // 插入排序辅助函数 unchecked_linear_insert
     template <class RandomIter, class T>
         void unchecked_linear_insert(RandomIter last, const T& value)
@@ -2408,16 +3347,6 @@ namespace mystl
             *last = value;
         }
 
-    // 插入排序函数 unchecked_insertion_sort
-    template <class RandomIter>
-        void unchecked_insertion_sort(RandomIter first, RandomIter last)
-        {
-            for (auto i = first; i != last; ++i)
-            {
-                mystl::unchecked_linear_insert(i, *i);
-            }
-        }
-
     // 插入排序函数 insertion_sort
     template <class RandomIter>
         void insertion_sort(RandomIter first, RandomIter last)
@@ -2439,32 +3368,6 @@ namespace mystl
             }
         }
 
-    // 最终插入排序函数 final_insertion_sort
-    template <class RandomIter>
-        void final_insertion_sort(RandomIter first, RandomIter last)
-        {
-            if (static_cast<size_t>(last - first) > kSmallSectionSize)
-            {
-                mystl::insertion_sort(first, first + kSmallSectionSize);
-                mystl::unchecked_insertion_sort(first + kSmallSectionSize, last);
-            }
-            else
-            {
-                mystl::insertion_sort(first, last);
-            }
-        }
-
-    template <class RandomIter>
-        void sort(RandomIter first, RandomIter last)
-        {
-            if (first != last)
-            {
-                // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-                mystl::intro_sort(first, last, slg2(last - first) * 2);
-                mystl::final_insertion_sort(first, last);
-            }
-        }
-
     // 重载版本使用函数对象 comp 代替比较操作
     // 分割函数 unchecked_partition
     template <class RandomIter, class T, class Compared>
@@ -2486,26 +3389,6 @@ namespace mystl
             }
         }
 
-    // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-    template <class RandomIter, class Size, class Compared>
-        void intro_sort(RandomIter first, RandomIter last,
-                Size depth_limit, Compared comp)
-        {
-            while (static_cast<size_t>(last - first) > kSmallSectionSize)
-            {
-                if (depth_limit == 0)
-                {                            // 到达最大分割深度限制
-                    mystl::partial_sort(first, last, last, comp);  // 改用 heap_sort
-                    return;
-                }
-                --depth_limit;
-                auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
-                auto cut = mystl::unchecked_partition(first, last, mid, comp);
-                mystl::intro_sort(cut, last, depth_limit, comp);
-                last = cut;
-            }
-        }
-
     // 插入排序辅助函数 unchecked_linear_insert
     template <class RandomIter, class T, class Compared>
         void unchecked_linear_insert(RandomIter last, const T& value, Compared comp)
@@ -2521,17 +3404,6 @@ namespace mystl
             *last = value;
         }
 
-    // 插入排序函数 unchecked_insertion_sort
-    template <class RandomIter, class Compared>
-        void unchecked_insertion_sort(RandomIter first, RandomIter last,
-                Compared comp)
-        {
-            for (auto i = first; i != last; ++i)
-            {
-                mystl::unchecked_linear_insert(i, *i, comp);
-            }
-        }
-
     // 插入排序函数 insertion_sort
     template <class RandomIter, class Compared>
         void insertion_sort(RandomIter first, RandomIter last, Compared comp)
@@ -2553,53 +3425,973 @@ namespace mystl
             }
         }
 
-    // 最终插入排序函数 final_insertion_sort
+    // 判断是否使用无分支的块分割：元素为算术类型且比较函数为 less / greater 时，
+    // 比较没有副作用且代价很低，把比较结果写入偏移数组可以消除分支预测失败
+    template <class T, class Compared>
+        struct pdq_use_branchless : public m_bool_constant<std::is_arithmetic<T>::value &&
+            (std::is_same<Compared, mystl::less<T>>::value ||
+             std::is_same<Compared, mystl::greater<T>>::value)> {};
+
+    // pdqsort 使用的插入排序，以移动代替复制
     template <class RandomIter, class Compared>
-        void final_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+        void pdq_insertion_sort(RandomIter first, RandomIter last, Compared comp)
         {
-            if (static_cast<size_t>(last - first) > kSmallSectionSize)
-            {
-                mystl::insertion_sort(first, first + kSmallSectionSize, comp);
-                mystl::unchecked_insertion_sort(first + kSmallSectionSize, last, comp);
-            }
-            else
+            if (first == last)
+                return;
+            for (auto cur = first + 1; cur != last; ++cur)
             {
-                mystl::insertion_sort(first, last, comp);
+                auto sift = cur;
+                auto prev = cur - 1;
+                if (comp(*sift, *prev))
+                {
+                    auto tmp = mystl::move(*sift);
+                    do
+                    {
+                        *sift-- = mystl::move(*prev);
+                    } while (sift != first && comp(tmp, *--prev));
+                    *sift = mystl::move(tmp);
+                }
             }
         }
 
+    // 无边界检查的插入排序，要求 *(first - 1) 不大于区间内的任何元素
+    template <class RandomIter, class Compared>
+        void pdq_unguarded_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+        {
+            if (first == last)
+                return;
+            for (auto cur = first + 1; cur != last; ++cur)
+            {
+                auto sift = cur;
+                auto prev = cur - 1;
+                if (comp(*sift, *prev))
+                {
+                    auto tmp = mystl::move(*sift);
+                    do
+                    {
+                        *sift-- = mystl::move(*prev);
+                    } while (comp(tmp, *--prev));
+                    *sift = mystl::move(tmp);
+                }
+            }
+        }
+
+    // 尝试插入排序，移动的元素超过 kPdqPartialInsertionSortLimit 时放弃并返回 false
+    template <class RandomIter, class Compared>
+        bool pdq_partial_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+        {
+            if (first == last)
+                return true;
+            size_t moved = 0;
+            for (auto cur = first + 1; cur != last; ++cur)
+            {
+                auto sift = cur;
+                auto prev = cur - 1;
+                if (comp(*sift, *prev))
+                {
+                    auto tmp = mystl::move(*sift);
+                    do
+                    {
+                        *sift-- = mystl::move(*prev);
+                    } while (sift != first && comp(tmp, *--prev));
+                    *sift = mystl::move(tmp);
+                    moved += static_cast<size_t>(cur - sift);
+                }
+                if (moved > kPdqPartialInsertionSortLimit)
+                    return false;
+            }
+            return true;
+        }
+
+    // 对三个位置上的元素排序
+    template <class RandomIter, class Compared>
+        void pdq_sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp)
+        {
+            if (comp(*b, *a))
+                mystl::iter_swap(a, b);
+            if (comp(*c, *b))
+                mystl::iter_swap(b, c);
+            if (comp(*b, *a))
+                mystl::iter_swap(a, b);
+        }
+
+    // 以 *first 为枢轴分割区间，与枢轴相等的元素放在右侧
+    // 返回枢轴的最终位置，以及分割前区间是否已经分割好
+    template <class RandomIter, class Compared>
+        mystl::pair<RandomIter, bool>
+        pdq_partition_right(RandomIter first, RandomIter last, Compared comp, m_false_type)
+        {
+            auto pivot = mystl::move(*first);
+            auto begin = first;
+            // 区间中存在不小于枢轴的元素（ninther 的结果），左侧的扫描不会越界
+            while (comp(*++first, pivot))
+                ;
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot))
+                    ;
+            }
+            else
+            {
+                while (!comp(*--last, pivot))
+                    ;
+            }
+            const bool already_partitioned = first >= last;
+            while (first < last)
+            {
+                mystl::iter_swap(first, last);
+                while (comp(*++first, pivot))
+                    ;
+                while (!comp(*--last, pivot))
+                    ;
+            }
+            auto pivot_pos = first - 1;
+            *begin = mystl::move(*pivot_pos);
+            *pivot_pos = mystl::move(pivot);
+            return mystl::make_pair(pivot_pos, already_partitioned);
+        }
+
+    // 按偏移数组交换左右两侧放错位置的元素
+    // 左右偏移个数相等时逐对交换，否则沿环形依次移动，减少一半的赋值
+    template <class RandomIter>
+        void pdq_swap_offsets(RandomIter lbase, RandomIter rbase,
+                              const unsigned char* loff, const unsigned char* roff,
+                              size_t n, bool use_swaps)
+        {
+            if (use_swaps)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    mystl::iter_swap(lbase + loff[i], rbase - roff[i]);
+            }
+            else if (n > 0)
+            {
+                auto l = lbase + loff[0];
+                auto r = rbase - roff[0];
+                auto tmp = mystl::move(*l);
+                *l = mystl::move(*r);
+                for (size_t i = 1; i < n; ++i)
+                {
+                    l = lbase + loff[i];
+                    *r = mystl::move(*l);
+                    r = rbase - roff[i];
+                    *l = mystl::move(*r);
+                }
+                *r = mystl::move(tmp);
+            }
+        }
+
+    // 无分支的块分割（BlockQuicksort）
+    // 每次从左右两端各取 kPdqBlockSize 个元素，把放错一侧的元素的偏移写入数组，再成对交换
+    template <class RandomIter, class Compared>
+        mystl::pair<RandomIter, bool>
+        pdq_partition_right(RandomIter first, RandomIter last, Compared comp, m_true_type)
+        {
+            auto pivot = mystl::move(*first);
+            auto begin = first;
+            while (comp(*++first, pivot))
+                ;
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot))
+                    ;
+            }
+            else
+            {
+                while (!comp(*--last, pivot))
+                    ;
+            }
+            const bool already_partitioned = first >= last;
+            if (!already_partitioned)
+            {
+                mystl::iter_swap(first, last);
+                ++first;
+
+                unsigned char loff[kPdqBlockSize];
+                unsigned char roff[kPdqBlockSize];
+                auto lbase = first;
+                auto rbase = last;
+                size_t lnum = 0, rnum = 0, lstart = 0, rstart = 0;
+                while (first < last)
+                {
+                    // 决定本轮两侧各扫描多少元素，剩余不足两块时平分
+                    const size_t unknown = static_cast<size_t>(last - first);
+                    const size_t lsplit = lnum == 0 ? (rnum == 0 ? unknown / 2 : unknown) : 0;
+                    const size_t rsplit = rnum == 0 ? unknown - lsplit : 0;
+
+                    if (lsplit >= kPdqBlockSize)
+                    {
+                        for (size_t i = 0; i < kPdqBlockSize; ++i)
+                        {
+                            loff[lnum] = static_cast<unsigned char>(i);
+                            lnum += !comp(*first, pivot);
+                            ++first;
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < lsplit; ++i)
+                        {
+                            loff[lnum] = static_cast<unsigned char>(i);
+                            lnum += !comp(*first, pivot);
+                            ++first;
+                        }
+                    }
+
+                    if (rsplit >= kPdqBlockSize)
+                    {
+                        for (size_t i = 1; i <= kPdqBlockSize; ++i)
+                        {
+                            roff[rnum] = static_cast<unsigned char>(i);
+                            rnum += comp(*--last, pivot);
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 1; i <= rsplit; ++i)
+                        {
+                            roff[rnum] = static_cast<unsigned char>(i);
+                            rnum += comp(*--last, pivot);
+                        }
+                    }
+
+                    const size_t n = mystl::min(lnum, rnum);
+                    mystl::pdq_swap_offsets(lbase, rbase, loff + lstart, roff + rstart,
+                                            n, lnum == rnum);
+                    lnum -= n;
+                    rnum -= n;
+                    lstart += n;
+                    rstart += n;
+                    if (lnum == 0)
+                    {
+                        lstart = 0;
+                        lbase = first;
+                    }
+                    if (rnum == 0)
+                    {
+                        rstart = 0;
+                        rbase = last;
+                    }
+                }
+
+                // 区间已扫描完，把仍未配对的元素交换到分界处
+                if (lnum != 0)
+                {
+                    while (lnum--)
+                        mystl::iter_swap(lbase + loff[lstart + lnum], --last);
+                    first = last;
+                }
+                if (rnum != 0)
+                {
+                    while (rnum--)
+                    {
+                        mystl::iter_swap(rbase - roff[rstart + rnum], first);
+                        ++first;
+                    }
+                }
+            }
+            auto pivot_pos = first - 1;
+            *begin = mystl::move(*pivot_pos);
+            *pivot_pos = mystl::move(pivot);
+            return mystl::make_pair(pivot_pos, already_partitioned);
+        }
+
+    // 以 *first 为枢轴分割区间，与枢轴相等的元素放在左侧，返回枢轴的最终位置
+    // 只在枢轴等于前一个区间的枢轴时调用，此时左侧的元素全部等于枢轴，不需要再排序
+    template <class RandomIter, class Compared>
+        RandomIter pdq_partition_left(RandomIter first, RandomIter last, Compared comp)
+        {
+            auto pivot = mystl::move(*first);
+            auto begin = first;
+            auto end = last;
+            while (comp(pivot, *--last))
+                ;
+            if (last + 1 == end)
+            {
+                while (first < last && !comp(pivot, *++first))
+                    ;
+            }
+            else
+            {
+                while (!comp(pivot, *++first))
+                    ;
+            }
+            while (first < last)
+            {
+                mystl::iter_swap(first, last);
+                while (comp(pivot, *--last))
+                    ;
+                while (!comp(pivot, *++first))
+                    ;
+            }
+            *begin = mystl::move(*last);
+            *last = mystl::move(pivot);
+            return last;
+        }
+
+    // 打乱区间两端的部分元素，破坏导致分割不平衡的模式
+    template <class RandomIter, class Distance>
+        void pdq_break_patterns(RandomIter first, RandomIter last, Distance n)
+        {
+            if (static_cast<size_t>(n) < kPdqInsertionSortThreshold)
+                return;
+            const Distance q = n / 4;
+            mystl::iter_swap(first, first + q);
+            mystl::iter_swap(last - 1, last - q);
+            if (static_cast<size_t>(n) > kPdqNintherThreshold)
+            {
+                mystl::iter_swap(first + 1, first + (q + 1));
+                mystl::iter_swap(first + 2, first + (q + 2));
+                mystl::iter_swap(last - 2, last - (q + 1));
+                mystl::iter_swap(last - 3, last - (q + 2));
+            }
+        }
+
+    // pdqsort 的主循环，leftmost 表示区间是否位于整个序列的最左端
+    template <class RandomIter, class Compared, class Branchless>
+        void pdq_sort_loop(RandomIter first, RandomIter last, Compared comp,
+                           size_t bad_allowed, bool leftmost, Branchless branchless)
+        {
+            while (true)
+            {
+                const auto len = last - first;
+                if (static_cast<size_t>(len) < kPdqInsertionSortThreshold)
+                {
+                    if (leftmost)
+                        mystl::pdq_insertion_sort(first, last, comp);
+                    else
+                        mystl::pdq_unguarded_insertion_sort(first, last, comp);
+                    return;
+                }
+
+                // 选取枢轴并放到 *first
+                const auto half = len / 2;
+                if (static_cast<size_t>(len) > kPdqNintherThreshold)
+                {
+                    mystl::pdq_sort3(first, first + half, last - 1, comp);
+                    mystl::pdq_sort3(first + 1, first + (half - 1), last - 2, comp);
+                    mystl::pdq_sort3(first + 2, first + (half + 1), last - 3, comp);
+                    mystl::pdq_sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    mystl::iter_swap(first, first + half);
+                }
+                else
+                {
+                    mystl::pdq_sort3(first + half, first, last - 1, comp);
+                }
+
+                // 枢轴等于左侧相邻区间的某个元素，说明存在大量重复元素，把相等的元素一次分出
+                if (!leftmost && !comp(*(first - 1), *first))
+                {
+                    first = mystl::pdq_partition_left(first, last, comp) + 1;
+                    continue;
+                }
+
+                auto result = mystl::pdq_partition_right(first, last, comp, branchless);
+                auto pivot_pos = result.first;
+                const auto llen = pivot_pos - first;
+                const auto rlen = last - (pivot_pos + 1);
+                if (llen < len / 8 || rlen < len / 8)
+                { // 分割极不平衡
+                    if (--bad_allowed == 0)
+                    { // 改用 heap sort
+                        mystl::make_heap(first, last, comp);
+                        mystl::sort_heap(first, last, comp);
+                        return;
+                    }
+                    mystl::pdq_break_patterns(first, pivot_pos, llen);
+                    mystl::pdq_break_patterns(pivot_pos + 1, last, rlen);
+                }
+                else if (result.second &&
+                         mystl::pdq_partial_insertion_sort(first, pivot_pos, comp) &&
+                         mystl::pdq_partial_insertion_sort(pivot_pos + 1, last, comp))
+                { // 分割时没有发生交换，且两侧都近乎有序
+                    return;
+                }
+
+                // 递归处理左侧，循环处理右侧
+                mystl::pdq_sort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+
+    // 线性扫描检查区间是否已经有序或严格逆序，逆序时将其翻转，两种情况都返回 true
+    // 严格逆序才翻转，保证相等元素不会被交换到错误的一侧
+    template <class RandomIter, class Compared>
+        bool pdq_presorted(RandomIter first, RandomIter last, Compared comp)
+        {
+            auto cur = first + 1;
+            if (comp(*cur, *first))
+            {
+                while (++cur != last && comp(*cur, *(cur - 1)))
+                    ;
+                if (cur != last)
+                    return false;
+                mystl::reverse(first, last);
+                return true;
+            }
+            while (++cur != last && !comp(*cur, *(cur - 1)))
+                ;
+            return cur == last;
+        }
+
+    template <class RandomIter, class Compared>
+        void pdq_sort(RandomIter first, RandomIter last, Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            if (last - first < 2 || mystl::pdq_presorted(first, last, comp))
+                return;
+            mystl::pdq_sort_loop(first, last, comp, slg2(static_cast<size_t>(last - first)), true,
+                                 pdq_use_branchless<value_type, Compared>());
+        }
+
+    template <class RandomIter>
+        void sort_dispatch(RandomIter first, RandomIter last, m_false_type)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            mystl::pdq_sort(first, last, mystl::less<value_type>());
+        }
+
+    // 元素为算术类型时，较长的区间改用基数排序
+    template <class RandomIter>
+        void sort_dispatch(RandomIter first, RandomIter last, m_true_type)
+        {
+            if (static_cast<size_t>(last - first) >= kRadixSortRouteSize)
+                mystl::radix_sort(first, last);
+            else
+                mystl::sort_dispatch(first, last, m_false_type());
+        }
+
+    template <class RandomIter>
+        void sort(RandomIter first, RandomIter last)
+        {
+            mystl::sort_dispatch(first, last,
+                                 is_radix_sortable<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template <class RandomIter, class Compared>
+        void sort_dispatch(RandomIter first, RandomIter last, Compared comp, m_false_type)
+        {
+            mystl::pdq_sort(first, last, comp);
+        }
+
+    // 比较函数为 mystl::less 且元素为算术类型时，与不带 comp 的版本相同
+    template <class RandomIter, class Compared>
+        void sort_dispatch(RandomIter first, RandomIter last, Compared, m_true_type)
+        {
+            mystl::sort_dispatch(first, last, m_true_type());
+        }
+
     template <class RandomIter, class Compared>
         void sort(RandomIter first, RandomIter last, Compared comp)
         {
-            if (first != last)
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            mystl::sort_dispatch(first, last, comp, m_bool_constant<
+                                 std::is_same<Compared, mystl::less<value_type>>::value &&
+                                 is_radix_sortable<value_type>::value>());
+        }
+
+    /*****************************************************************************************/
+    // stable_sort
+    // 将[first, last)内的元素以递增的方式排序，相等元素的相对位置保持不变
+    // 采用自适应的归并排序：
+    //   从左到右找出天然有序的区间(run)，严格递减的 run 原地翻转，过短的 run 用插入排序补足
+    //   按 powersort 的规则决定 run 的合并顺序，使合并树接近最优
+    //   合并时先跳过两端已经就位的元素，一侧连续胜出时改用倍增查找(galloping)整段移动
+    // 合并只需要较短一侧 run 大小的缓冲区，可以传入 merge_buffer 在多次调用之间复用
+    /*****************************************************************************************/
+    constexpr static size_t kStableSortMinMerge = 64;   // 短于该长度的区间直接使用插入排序
+    constexpr static size_t kStableSortMinGallop = 7;   // 一侧连续胜出该次数后进入 galloping
+    constexpr static size_t kStableSortStackSize = 85;  // run 栈的最大深度，栈中 power 严格递增，不超过 log2(n) + 1
+
+    // 计算 run 的最小长度，使 n / minrun 恰好为或略小于 2 的幂
+    template <class Distance>
+        Distance stable_sort_min_run(Distance n)
+        {
+            Distance r = 0;
+            while (n >= static_cast<Distance>(kStableSortMinMerge))
+            {
+                r |= n & 1;
+                n >>= 1;
+            }
+            return n + r;
+        }
+
+    // 插入排序，[first, sorted) 已经有序，把 [sorted, last) 的元素依次插入
+    template <class RandomIter, class Compared>
+        void run_insertion_sort(RandomIter first, RandomIter sorted,
+                RandomIter last, Compared comp)
+        {
+            for (; sorted != last; ++sorted)
+            {
+                auto sift = sorted;
+                auto prev = sorted - 1;
+                if (comp(*sift, *prev))
+                {
+                    auto tmp = mystl::move(*sift);
+                    do
+                    {
+                        *sift-- = mystl::move(*prev);
+                    } while (sift != first && comp(tmp, *--prev));
+                    *sift = mystl::move(tmp);
+                }
+            }
+        }
+
+    // 找出从 first 开始的 run 的末尾，run 严格递减时将其翻转
+    template <class RandomIter, class Compared>
+        RandomIter count_run_and_make_ascending(RandomIter first, RandomIter last, Compared comp)
+        {
+            auto cur = first + 1;
+            if (cur == last)
+                return last;
+            if (comp(*cur, *first))
+            {  // 只翻转严格递减的 run，保证相等元素的相对位置不变
+                while (++cur != last && comp(*cur, *(cur - 1)))
+                    ;
+                mystl::reverse(first, cur);
+            }
+            else
+            {
+                while (++cur != last && !comp(*cur, *(cur - 1)))
+                    ;
+            }
+            return cur;
+        }
+
+    // 计算 run [s1, s1 + n1) 与 [s1 + n1, s1 + n1 + n2) 之间边界的 power
+    // 即两个 run 的中点除以 n 后，二进制小数部分第一个不同的位
+    inline size_t powersort_power(size_t s1, size_t n1, size_t n2, size_t n)
+    {
+        size_t result = 0;
+        size_t a = 2 * s1 + n1;   // 第一个 run 中点的两倍
+        size_t b = a + n1 + n2;   // 第二个 run 中点的两倍
+        while (true)
+        {
+            ++result;
+            if (a >= n)
+            {
+                a -= n;
+                b -= n;
+            }
+            else if (b >= n)
+            {
+                break;
+            }
+            a <<= 1;
+            b <<= 1;
+        }
+        return result;
+    }
+
+    // 较短的 run 在左侧：把它移入缓冲区，从前向后合并
+    template <class RandomIter, class Pointer, class Compared>
+        void merge_lo(RandomIter first, RandomIter middle, RandomIter last,
+                Pointer buffer, size_t& min_gallop, Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            Pointer b = buffer;
+            Pointer b_last = mystl::move(first, middle, buffer);
+            RandomIter r = middle;
+            RandomIter out = first;
+            size_t count1 = 0, count2 = 0;  // 两侧连续胜出的次数
+            bool galloping = false;
+            while (b != b_last && r != last)
+            {
+                if (!galloping)
+                {
+                    if (comp(*r, *b))
+                    {
+                        *out++ = mystl::move(*r++);
+                        ++count2;
+                        count1 = 0;
+                    }
+                    else
+                    {
+                        *out++ = mystl::move(*b++);
+                        ++count1;
+                        count2 = 0;
+                    }
+                    galloping = count1 >= min_gallop || count2 >= min_gallop;
+                }
+                else
+                {  // 整段移动缓冲区中不大于 *r 的元素，再整段移动右侧小于 *b 的元素
+                    auto p = mystl::gallop_forward(b, b_last, [&](const value_type& x)
+                                                   { return !comp(*r, x); });
+                    const size_t n1 = static_cast<size_t>(p - b);
+                    out = mystl::move(b, p, out);
+                    b = p;
+                    if (b == b_last)
+                        break;
+                    auto q = mystl::gallop_forward(r, last, [&](const value_type& x)
+                                                   { return comp(x, *b); });
+                    const size_t n2 = static_cast<size_t>(q - r);
+                    out = mystl::move(r, q, out);
+                    r = q;
+                    if (n1 < kStableSortMinGallop && n2 < kStableSortMinGallop)
+                    {  // galloping 收益不大，回到逐个比较并提高进入的门槛
+                        galloping = false;
+                        count1 = count2 = 0;
+                        min_gallop += 2;
+                    }
+                    else if (min_gallop > 1)
+                    {
+                        --min_gallop;
+                    }
+                }
+            }
+            mystl::move(b, b_last, out);
+        }
+
+    // 较短的 run 在右侧：把它移入缓冲区，从后向前合并
+    template <class RandomIter, class Pointer, class Compared>
+        void merge_hi(RandomIter first, RandomIter middle, RandomIter last,
+                Pointer buffer, size_t& min_gallop, Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            Pointer b_last = mystl::move(middle, last, buffer);
+            RandomIter l = middle;
+            RandomIter out = last;
+            size_t count1 = 0, count2 = 0;
+            bool galloping = false;
+            while (buffer != b_last && first != l)
+            {
+                if (!galloping)
+                {
+                    if (comp(*(b_last - 1), *(l - 1)))
+                    {
+                        *--out = mystl::move(*--l);
+                        ++count1;
+                        count2 = 0;
+                    }
+                    else
+                    {
+                        *--out = mystl::move(*--b_last);
+                        ++count2;
+                        count1 = 0;
+                    }
+                    galloping = count1 >= min_gallop || count2 >= min_gallop;
+                }
+                else
+                {  // 整段移动左侧大于缓冲区末尾的元素，再整段移动缓冲区中不小于左侧末尾的元素
+                    auto p = mystl::gallop_backward(first, l, [&](const value_type& x)
+                                                    { return comp(*(b_last - 1), x); });
+                    const size_t n1 = static_cast<size_t>(l - p);
+                    out = mystl::move_backward(p, l, out);
+                    l = p;
+                    if (first == l)
+                        break;
+                    auto q = mystl::gallop_backward(buffer, b_last, [&](const value_type& x)
+                                                    { return !comp(x, *(l - 1)); });
+                    const size_t n2 = static_cast<size_t>(b_last - q);
+                    out = mystl::move_backward(q, b_last, out);
+                    b_last = q;
+                    if (n1 < kStableSortMinGallop && n2 < kStableSortMinGallop)
+                    {
+                        galloping = false;
+                        count1 = count2 = 0;
+                        min_gallop += 2;
+                    }
+                    else if (min_gallop > 1)
+                    {
+                        --min_gallop;
+                    }
+                }
+            }
+            mystl::move_backward(buffer, b_last, out);
+        }
+
+    // 合并相邻的两个 run [first, middle) 与 [middle, last)
+    template <class RandomIter, class T, class Compared>
+        void merge_runs(RandomIter first, RandomIter middle, RandomIter last,
+                merge_buffer<T>& buffer, size_t& min_gallop, Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type      value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type Distance;
+            // 左侧不大于 *middle 的元素与右侧不小于 *(middle - 1) 的元素已经就位
+            first = mystl::gallop_forward(first, middle, [&](const value_type& x)
+                                          { return !comp(*middle, x); });
+            if (first == middle)
+                return;
+            last = mystl::gallop_backward(middle, last, [&](const value_type& x)
+                                          { return !comp(x, *(middle - 1)); });
+            const Distance len1 = middle - first;
+            const Distance len2 = last - middle;
+            const Distance len = mystl::min(len1, len2);
+            if (buffer.size() < len && buffer.reserve(len, *first) < len)
+            {  // 缓冲区不足，改用分段的合并
+                mystl::merge_adaptive(first, middle, last, len1, len2, buffer.begin(),
+                                      static_cast<Distance>(buffer.size()), comp);
+                return;
+            }
+            if (len1 <= len2)
+                mystl::merge_lo(first, middle, last, buffer.begin(), min_gallop, comp);
+            else
+                mystl::merge_hi(first, middle, last, buffer.begin(), min_gallop, comp);
+        }
+
+    template <class RandomIter, class T, class Compared>
+        void adaptive_merge_sort(RandomIter first, RandomIter last,
+                merge_buffer<T>& buffer, Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type Distance;
+            struct run
+            {
+                RandomIter first;
+                Distance   len;
+                size_t     power;  // 与栈中前一个 run 之间边界的 power
+            };
+
+            const Distance n = last - first;
+            if (n < 2)
+                return;
+            if (n < static_cast<Distance>(kStableSortMinMerge))
+            {
+                mystl::run_insertion_sort(first,
+                                             mystl::count_run_and_make_ascending(first, last, comp),
+                                             last, comp);
+                return;
+            }
+
+            const Distance min_run = mystl::stable_sort_min_run(n);
+            size_t min_gallop = kStableSortMinGallop;
+            run stack[kStableSortStackSize];
+            size_t top = 0;
+            auto cur = first;
+            while (cur != last)
+            {
+                auto run_last = mystl::count_run_and_make_ascending(cur, last, comp);
+                if (run_last - cur < min_run)
+                {  // run 过短，用插入排序补足到 min_run
+                    auto force = last - cur > min_run ? cur + min_run : last;
+                    mystl::run_insertion_sort(cur, run_last, force, comp);
+                    run_last = force;
+                }
+                size_t power = 0;
+                if (top > 0)
+                {
+                    power = mystl::powersort_power(static_cast<size_t>(stack[top - 1].first - first),
+                                                   static_cast<size_t>(stack[top - 1].len),
+                                                   static_cast<size_t>(run_last - cur),
+                                                   static_cast<size_t>(n));
+                    // 合并栈顶 power 更大的边界
+                    while (top > 1 && stack[top - 1].power > power)
+                    {
+                        run& left = stack[top - 2];
+                        run& right = stack[top - 1];
+                        mystl::merge_runs(left.first, right.first, right.first + right.len,
+                                          buffer, min_gallop, comp);
+                        left.len += right.len;
+                        --top;
+                    }
+                }
+                stack[top].first = cur;
+                stack[top].len = run_last - cur;
+                stack[top].power = power;
+                ++top;
+                cur = run_last;
+            }
+            for (; top > 1; --top)
             {
-                // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-                mystl::intro_sort(first, last, slg2(last - first) * 2, comp);
-                mystl::final_insertion_sort(first, last, comp);
+                run& left = stack[top - 2];
+                run& right = stack[top - 1];
+                mystl::merge_runs(left.first, right.first, right.first + right.len,
+                                  buffer, min_gallop, comp);
+                left.len += right.len;
             }
         }
 
+    template <class RandomIter>
+        void stable_sort(RandomIter first, RandomIter last)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            merge_buffer<value_type> buffer;
+            mystl::adaptive_merge_sort(first, last, buffer, mystl::less<value_type>());
+        }
+
+    // 使用调用者提供的缓冲区，缓冲区在调用结束后保留，可以用于下一次调用
+    template <class RandomIter, class T>
+        void stable_sort(RandomIter first, RandomIter last, merge_buffer<T>& buffer)
+        {
+            mystl::adaptive_merge_sort(first, last, buffer, mystl::less<T>());
+        }
+
+    // 重载版本使用函数对象 comp 代替比较操作
+    template <class RandomIter, class Compared>
+        void stable_sort(RandomIter first, RandomIter last, Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            merge_buffer<value_type> buffer;
+            mystl::adaptive_merge_sort(first, last, buffer, comp);
+        }
+
+    template <class RandomIter, class Compared, class T>
+        void stable_sort(RandomIter first, RandomIter last, Compared comp, merge_buffer<T>& buffer)
+        {
+            mystl::adaptive_merge_sort(first, last, buffer, comp);
+        }
+
     /*****************************************************************************************/
     // nth_element
     // 对序列重排，使得所有小于第 n 个元素的元素出现在它的前面，大于它的出现在它的后面
+    // 使用 introselect：枢轴的选取与分割与 pdq_sort 相同，只继续处理 nth 所在的一侧，平均为线性时间；
+    // 枢轴与左侧相邻的枢轴相等时把相等的元素一次分出，大量重复元素时不会退化
+    // 分割极不平衡的次数超过 kSelectBadAllowed 时，改用以中位数的中位数为枢轴的三路分割(mom_select)；
+    // 次数限制为常数，极不平衡的分割总共只多花费 O(N)，保证最坏情况下也是线性时间
     /*****************************************************************************************/
-    template <class RandomIter>
-        void nth_element(RandomIter first, RandomIter nth,
-                RandomIter last)
+    constexpr static size_t kSelectBadAllowed = 4;  // introselect 允许的极不平衡分割的次数
+
+    // 以 *pivot 为枢轴三路分割，返回与枢轴相等的区间 [lt, gt)，左侧小于枢轴，右侧大于枢轴
+    template <class RandomIter, class Compared>
+        mystl::pair<RandomIter, RandomIter>
+        three_way_partition(RandomIter first, RandomIter last, RandomIter pivot, Compared comp)
+        {
+            mystl::iter_swap(first, pivot);
+            // [first, lt) 小于枢轴，[lt, i) 等于枢轴，[gt, last) 大于枢轴，*lt 总是等于枢轴
+            auto lt = first;
+            auto i = first + 1;
+            auto gt = last;
+            while (i < gt)
+            {
+                if (comp(*i, *lt))
+                {
+                    mystl::iter_swap(lt, i);
+                    ++lt;
+                    ++i;
+                }
+                else if (comp(*lt, *i))
+                {
+                    mystl::iter_swap(i, --gt);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            return mystl::pair<RandomIter, RandomIter>(lt, gt);
+        }
+
+    // 以中位数的中位数为枢轴的选择算法(BFPRT)：每 5 个元素取中位数，递归地选出这些中位数的中位数，
+    // 它两侧各至少有约 3 / 10 的元素，最坏情况下为线性时间
+    template <class RandomIter, class Compared>
+        void mom_select(RandomIter first, RandomIter nth, RandomIter last, Compared comp)
         {
-            if (nth == last)
-                return;
-            while (last - first > 3)
+            while (static_cast<size_t>(last - first) >= kPdqInsertionSortThreshold)
+            {
+                const auto groups = (last - first) / 5;
+                for (decltype(last - first) i = 0; i < groups; ++i)
+                {
+                    auto group = first + i * 5;
+                    mystl::pdq_insertion_sort(group, group + 5, comp);
+                    mystl::iter_swap(first + i, group + 2);
+                }
+                auto mid = first + groups / 2;
+                mystl::mom_select(first, mid, first + groups, comp);
+                auto equal = mystl::three_way_partition(first, last, mid, comp);
+                if (nth < equal.first)
+                    last = equal.first;
+                else if (nth < equal.second)
+                    return;
+                else
+                    first = equal.second;
+            }
+            mystl::pdq_insertion_sort(first, last, comp);
+        }
+
+    // introselect 的主循环，[nth_first, nth_last) 为按升序排列的若干个位置，都位于 [first, last) 中
+    // 每次分割后把位置分为枢轴左侧、右侧两组，递归处理左侧，循环处理右侧
+    // leftmost 表示区间是否位于整个序列的最左端，否则 *(first - 1) 不大于区间内的任何元素
+    template <class RandomIter, class NthIter, class Compared, class Branchless>
+        void intro_select_loop(RandomIter first, RandomIter last, NthIter nth_first, NthIter nth_last,
+                               Compared comp, size_t bad_allowed, bool leftmost, Branchless branchless)
+        {
+            while (nth_first != nth_last)
             {
-                auto cut = mystl::unchecked_partition(first, last, mystl::median(*first,
-                            *(first + (last - first) / 2),
-                            *(last - 1)));
-                if (cut <= nth)  // 如果 nth 位于右段
-                    first = cut;   // 对右段进行分割
+                const auto len = last - first;
+                if (static_cast<size_t>(len) < kPdqInsertionSortThreshold)
+                {
+                    if (leftmost)
+                        mystl::pdq_insertion_sort(first, last, comp);
+                    else
+                        mystl::pdq_unguarded_insertion_sort(first, last, comp);
+                    return;
+                }
+                if (bad_allowed == 0)
+                { // 分割多次极不平衡，从中间的位置开始逐个改用 mom_select
+                    auto mid = nth_first + (nth_last - nth_first) / 2;
+                    const RandomIter pos = *mid;
+                    mystl::mom_select(first, pos, last, comp);
+                    mystl::intro_select_loop(first, pos, nth_first, mid, comp, 0, leftmost, branchless);
+                    while (mid != nth_last && !(pos < *mid))
+                        ++mid;
+                    first = pos + 1;
+                    nth_first = mid;
+                    leftmost = false;
+                    continue;
+                }
+
+                // 选取枢轴并放到 *first
+                const auto half = len / 2;
+                if (static_cast<size_t>(len) > kPdqNintherThreshold)
+                {
+                    mystl::pdq_sort3(first, first + half, last - 1, comp);
+                    mystl::pdq_sort3(first + 1, first + (half - 1), last - 2, comp);
+                    mystl::pdq_sort3(first + 2, first + (half + 1), last - 3, comp);
+                    mystl::pdq_sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    mystl::iter_swap(first, first + half);
+                }
                 else
-                    last = cut;    // 对左段进行分割
+                {
+                    mystl::pdq_sort3(first + half, first, last - 1, comp);
+                }
+
+                // 枢轴等于左侧相邻的枢轴，[first, cut] 中的元素都与它相等，已经就位
+                if (!leftmost && !comp(*(first - 1), *first))
+                {
+                    auto cut = mystl::pdq_partition_left(first, last, comp);
+                    while (nth_first != nth_last && !(cut < *nth_first))
+                        ++nth_first;
+                    first = cut + 1;
+                    continue;
+                }
+
+                auto pivot_pos = mystl::pdq_partition_right(first, last, comp, branchless).first;
+                const auto llen = pivot_pos - first;
+                const auto rlen = last - (pivot_pos + 1);
+                if (llen < len / 8 || rlen < len / 8)
+                { // 分割极不平衡
+                    --bad_allowed;
+                    mystl::pdq_break_patterns(first, pivot_pos, llen);
+                    mystl::pdq_break_patterns(pivot_pos + 1, last, rlen);
+                }
+
+                auto mid = mystl::lower_bound(nth_first, nth_last, pivot_pos);
+                mystl::intro_select_loop(first, pivot_pos, nth_first, mid, comp,
+                                         bad_allowed, leftmost, branchless);
+                while (mid != nth_last && !(pivot_pos < *mid))
+                    ++mid;
+                first = pivot_pos + 1;
+                nth_first = mid;
+                leftmost = false;
             }
-            mystl::insertion_sort(first, last);
+        }
+
+    template <class RandomIter, class NthIter, class Compared>
+        void intro_select(RandomIter first, RandomIter last, NthIter nth_first, NthIter nth_last,
+                          Compared comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            while (nth_first != nth_last && *(nth_last - 1) == last)
+                --nth_last;  // 忽略等于 last 的位置
+            mystl::intro_select_loop(first, last, nth_first, nth_last, comp, kSelectBadAllowed, true,
+                                     pdq_use_branchless<value_type, Compared>());
+        }
+
+    template <class RandomIter>
+        void nth_element(RandomIter first, RandomIter nth,
+                RandomIter last)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            mystl::intro_select(first, last, &nth, &nth + 1, mystl::less<value_type>());
         }
 
     // 重载版本使用函数对象 comp 代替比较操作
@@ -2607,19 +4399,29 @@ namespace mystl
         void nth_element(RandomIter first, RandomIter nth,
                 RandomIter last, Compared comp)
         {
-            if (nth == last)
-                return;
-            while (last - first > 3)
-            {
-                auto cut = mystl::unchecked_partition(first, last, mystl::median(*first, 
-                            *(first + (last - first) / 2),
-                            *(last - 1)), comp);
-                if (cut <= nth)  // 如果 nth 位于右段
-                    first = cut;   // 对右段进行分割
-                else
-                    last = cut;    // 对左段进行分割
-            }
-            mystl::insertion_sort(first, last, comp);
+            mystl::intro_select(first, last, &nth, &nth + 1, comp);
+        }
+
+    /*****************************************************************************************/
+    // nth_elements
+    // 一次选出多个位置上的元素：[nth_first, nth_last) 为指向[first, last)中的若干个迭代器，按升序排列
+    // 结束后每个位置上的元素都与排序后相同，相邻两个位置之间的元素位于它们之间
+    // 每次分割都同时服务于落在两侧的所有位置，选出 k 个位置的代价为 O(N log k)，
+    // 适合在同一批数据上一次求出多个分位数
+    /*****************************************************************************************/
+    template <class RandomIter, class NthIter>
+        void nth_elements(RandomIter first, RandomIter last, NthIter nth_first, NthIter nth_last)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            mystl::intro_select(first, last, nth_first, nth_last, mystl::less<value_type>());
+        }
+
+    // 重载版本使用函数对象 comp 代替比较操作
+    template <class RandomIter, class NthIter, class Compared>
+        void nth_elements(RandomIter first, RandomIter last, NthIter nth_first, NthIter nth_last,
+                          Compared comp)
+        {
+            mystl::intro_select(first, last, nth_first, nth_last, comp);
         }
 
     /*****************************************************************************************/
@@ -7,6 +7,7 @@
 
 #include "iterator.h"
 #include "util.h"
+#include "simd.h"
 
 namespace mystl
 {
@@ -350,7 +351,7 @@ move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIt
 // 比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+bool equal_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, m_false_type)
 {
   for (; first1 != last1; ++first1, ++first2)
   {
@@ -360,6 +361,19 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
   return true;
 }
 
+// 相同算术类型的指针区间使用 SIMD 内核
+template <class Tp, class Up>
+bool equal_dispatch(Tp* first1, Tp* last1, Up* first2, m_true_type)
+{
+  return mystl::simd_equal<typename std::remove_cv<Tp>::type>(first1, last1, first2);
+}
+
+template <class InputIter1, class InputIter2>
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+{
+  return mystl::equal_dispatch(first1, last1, first2, is_simd_equal<InputIter1, InputIter2>());
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compared>
 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp)
@@ -426,7 +440,7 @@ template <class RandomIter, class T>
 void fill_cat(RandomIter first, RandomIter last, const T& value,
               mystl::random_access_iterator_tag)
 {
-  fill_n(first, last - first, value);
+  mystl::fill_n(first, last - first, value);
 }
 
 template <class ForwardIter, class T>
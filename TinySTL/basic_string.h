@@ -5,9 +5,25 @@
 // 模板类 basic_string
 // 用于表示字符串类型
 
+// notes:
+//
+// 采用短字符串优化(SSO)：对象本身占三个指针大小的空间，即指针、长度与容量，
+// 较短的字符串直接保存在这块空间中，不分配内存，64 位平台上 char 最多可以保存 22 个字符
+// 空间的最后一个字节兼作标志：短字符串时保存长度(小于 0x80)，长字符串时为容量的一部分，最高位为 1
+// 短字符串没有指向自身的指针，移动与交换只需复制这块空间
+// 所有字符操作都通过 CharTraits 进行，字符串总是以 CharType() 结尾，c_str() 与 data() 相同
+
 #include <iostream>
+#include <initializer_list>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+
+#include "iterator.h"
 #include "memory.h"
 #include "functional.h"
+#include "simd.h"
 #include "exceptdef.h"
 
 namespace mystl
@@ -76,7 +92,1396 @@ namespace mystl
                 *dst = ch;
             return r;
         }
+
+        // 在字符串的前 n 个字符中查找字符 ch，找不到时返回 nullptr
+        static const char_type* find(const char_type* str, size_t n, const char_type& ch)
+        {
+            for (; n > 0; --n, ++str)
+            {
+                if (*str == ch)
+                    return str;
+            }
+            return nullptr;
+        }
     };
+
+    // char 与 wchar_t 的特化版本使用 C 库函数，它们通常已经按处理器的指令集向量化
+    // 注意 compare 与 std::char_traits 一样按无符号字节比较，不受 char 是否有符号的影响
+    template <>
+    struct char_traits<char>
+    {
+        typedef char char_type;
+
+        static size_t length(const char_type* str) noexcept
+        { return std::strlen(str); }
+
+        static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+        { return n == 0 ? 0 : std::memcmp(s1, s2, n); }
+
+        static char_type* copy(char_type* dst, const char_type* src, size_t n) noexcept
+        {
+            MYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            return n == 0 ? dst : static_cast<char_type*>(std::memcpy(dst, src, n));
+        }
+
+        static char_type* move(char_type* dst, const char_type* src, size_t n) noexcept
+        { return n == 0 ? dst : static_cast<char_type*>(std::memmove(dst, src, n)); }
+
+        static char_type* fill(char_type* dst, char_type ch, size_t count) noexcept
+        { return count == 0 ? dst : static_cast<char_type*>(std::memset(dst, ch, count)); }
+
+        static const char_type* find(const char_type* str, size_t n, const char_type& ch) noexcept
+        { return n == 0 ? nullptr : static_cast<const char_type*>(std::memchr(str, ch, n)); }
+    };
+
+    template <>
+    struct char_traits<wchar_t>
+    {
+        typedef wchar_t char_type;
+
+        static size_t length(const char_type* str) noexcept
+        { return std::wcslen(str); }
+
+        static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+        { return n == 0 ? 0 : std::wmemcmp(s1, s2, n); }
+
+        static char_type* copy(char_type* dst, const char_type* src, size_t n) noexcept
+        {
+            MYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            return n == 0 ? dst : std::wmemcpy(dst, src, n);
+        }
+
+        static char_type* move(char_type* dst, const char_type* src, size_t n) noexcept
+        { return n == 0 ? dst : std::wmemmove(dst, src, n); }
+
+        static char_type* fill(char_type* dst, char_type ch, size_t count) noexcept
+        { return count == 0 ? dst : std::wmemset(dst, ch, count); }
+
+        static const char_type* find(const char_type* str, size_t n, const char_type& ch) noexcept
+        { return n == 0 ? nullptr : std::wmemchr(str, ch, n); }
+    };
+
+    // char16_t 与 char32_t 没有对应的 C 库函数，改用 simd.h 中的内核：find 调用 simd_find(支持时使用 AVX2)，
+    // length 与 compare 以 SSE2 每次比较 16 字节，用一次 movemask 得到相等的字符的位置；
+    // 移动使用 memmove，复制保留简单的循环，由编译器转换为 memcpy
+    // (直接调用 memcpy 时 GCC 会对以字面量构造的短字符串给出误报的越界警告)
+    template <class CharType>
+    struct wide_char_traits
+    {
+        typedef CharType char_type;
+
+#if MYSTL_HAS_SIMD
+        typedef typename simd_tag<char_type>::type tag;
+
+        static constexpr size_t kLanes = 16 / sizeof(char_type);
+
+        // 从 str 所在的 16 字节对齐的位置开始读，读取的范围不会跨过内存页，
+        // 但可能读到字符串之前与之后的字节，因此不参与地址检查
+        __attribute__((no_sanitize_address))
+        static size_t length(const char_type* str) noexcept
+        {
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(str);
+            MYSTL_DEBUG(addr % sizeof(char_type) == 0);
+            const __m128i* p = reinterpret_cast<const __m128i*>(addr & ~static_cast<uintptr_t>(15));
+            const __m128i zero = _mm_setzero_si128();
+            unsigned mask = sse2_eq_mask(_mm_load_si128(p), zero, tag()) & (0xffffu << (addr & 15));
+            while (mask == 0)
+                mask = sse2_eq_mask(_mm_load_si128(++p), zero, tag());
+            const char* hit = reinterpret_cast<const char*>(p) + __builtin_ctz(mask);
+            return static_cast<size_t>(hit - reinterpret_cast<const char*>(str)) / sizeof(char_type);
+        }
+
+        static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+        {
+            for (; n >= kLanes; n -= kLanes, s1 += kLanes, s2 += kLanes)
+            {
+                const unsigned mask = sse2_eq_mask(sse2_load(s1), sse2_load(s2), tag());
+                if (mask != 0xffff)
+                {
+                    const size_t i = static_cast<size_t>(__builtin_ctz(~mask)) / sizeof(char_type);
+                    return s1[i] < s2[i] ? -1 : 1;
+                }
+            }
+            for (; n != 0; --n, ++s1, ++s2)
+            {
+                if (*s1 != *s2)
+                    return *s1 < *s2 ? -1 : 1;
+            }
+            return 0;
+        }
+#else
+        static size_t length(const char_type* str) noexcept
+        {
+            size_t len = 0;
+            for (; *str != char_type(0); ++str)
+                ++len;
+            return len;
+        }
+
+        static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+        {
+            for (; n != 0; --n, ++s1, ++s2)
+            {
+                if (*s1 != *s2)
+                    return *s1 < *s2 ? -1 : 1;
+            }
+            return 0;
+        }
+#endif
+
+        static const char_type* find(const char_type* str, size_t n, const char_type& ch) noexcept
+        {
+            const char_type* r = mystl::simd_find(str, str + n, ch);
+            return r == str + n ? nullptr : r;
+        }
+
+        static char_type* copy(char_type* dst, const char_type* src, size_t n) noexcept
+        {
+            MYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            for (size_t i = 0; i < n; ++i)
+                dst[i] = src[i];
+            return dst;
+        }
+
+        static char_type* move(char_type* dst, const char_type* src, size_t n) noexcept
+        {
+            if (n != 0)
+                std::memmove(dst, src, n * sizeof(char_type));
+            return dst;
+        }
+
+        static char_type* fill(char_type* dst, char_type ch, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] = ch;
+            return dst;
+        }
+    };
+
+    template <>
+    struct char_traits<char16_t> : public wide_char_traits<char16_t> {};
+
+    template <>
+    struct char_traits<char32_t> : public wide_char_traits<char32_t> {};
+
+    // 模板类 basic_string
+    // 参数一代表字符类型，参数二代表字符类型的萃取方式，缺省使用 mystl::char_traits
+    template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+        class basic_string
+        {
+            static_assert(std::is_trivial<CharType>::value, "basic_string requires a trivial character type");
+
+            public:
+                typedef CharTraits                               traits_type;
+                typedef mystl::allocator<CharType>               allocator_type;
+                typedef mystl::allocator<CharType>               data_allocator;
+
+                typedef typename allocator_type::value_type      value_type;
+                typedef typename allocator_type::pointer         pointer;
+                typedef typename allocator_type::const_pointer   const_pointer;
+                typedef typename allocator_type::reference       reference;
+                typedef typename allocator_type::const_reference const_reference;
+                typedef typename allocator_type::size_type       size_type;
+                typedef typename allocator_type::difference_type difference_type;
+
+                typedef value_type*                              iterator;
+                typedef const value_type*                        const_iterator;
+                typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+                typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+                static constexpr size_type npos = static_cast<size_type>(-1);
+
+            private:
+                struct long_rep
+                {
+                    pointer   data;
+                    size_type size;
+                    size_type cap;   // 经过编码的容量，见 encode_cap
+                };
+
+                static constexpr size_type kRepBytes = sizeof(long_rep);
+                // 最后一个字节用作标志，其余空间保存短字符串及其结尾的空字符
+                static constexpr size_type kShortUnits = (kRepBytes - 1) / sizeof(CharType);
+                static constexpr size_type kShortCap = kShortUnits - 1;
+
+                static_assert(kShortUnits >= 2, "character type too large for the short string buffer");
+
+                union rep
+                {
+                    long_rep      l;
+                    value_type    s[kShortUnits];
+                    unsigned char raw[kRepBytes];
+                };
+
+                rep r_;
+
+            public:
+                // 构造、复制、移动、析构函数
+                basic_string() noexcept
+                { init_short(0); }
+
+                basic_string(size_type n, value_type ch)
+                { init_fill(n, ch); }
+
+                basic_string(const basic_string& other, size_type pos)
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > other.size(), "basic_string<Char, Traits>::basic_string() position out of range");
+                    init(other.data() + pos, other.size() - pos);
+                }
+
+                basic_string(const basic_string& other, size_type pos, size_type count)
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > other.size(), "basic_string<Char, Traits>::basic_string() position out of range");
+                    init(other.data() + pos, mystl::min(count, other.size() - pos));
+                }
+
+                basic_string(const_pointer str)
+                { init(str, traits_type::length(str)); }
+
+                basic_string(const_pointer str, size_type count)
+                { init(str, count); }
+
+                template <class Iter, typename std::enable_if<
+                    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+                    basic_string(Iter first, Iter last)
+                    { init_range(first, last, iterator_category(first)); }
+
+                basic_string(std::initializer_list<value_type> ilist)
+                { init(ilist.begin(), ilist.size()); }
+
+                basic_string(const basic_string& rhs)
+                {
+                    if (rhs.is_long())
+                        init(rhs.r_.l.data, rhs.r_.l.size);
+                    else
+                        r_ = rhs.r_;
+                }
+
+                basic_string(basic_string&& rhs) noexcept
+                    :r_(rhs.r_)
+                {
+                    rhs.init_short(0);
+                }
+
+                basic_string& operator=(const basic_string& rhs)
+                {
+                    if (this != &rhs)
+                        assign(rhs.data(), rhs.size());
+                    return *this;
+                }
+
+                basic_string& operator=(basic_string&& rhs) noexcept
+                {
+                    if (this != &rhs)
+                    {
+                        release();
+                        r_ = rhs.r_;
+                        rhs.init_short(0);
+                    }
+                    return *this;
+                }
+
+                basic_string& operator=(const_pointer str)
+                { return assign(str, traits_type::length(str)); }
+
+                basic_string& operator=(value_type ch)
+                { return assign(size_type(1), ch); }
+
+                basic_string& operator=(std::initializer_list<value_type> ilist)
+                { return assign(ilist.begin(), ilist.size()); }
+
+                ~basic_string() { release(); }
+
+            public:
+                // 迭代器相关操作
+                iterator               begin()         noexcept { return data_ptr(); }
+                const_iterator         begin()   const noexcept { return data_ptr(); }
+                iterator               end()           noexcept { return data_ptr() + size(); }
+                const_iterator         end()     const noexcept { return data_ptr() + size(); }
+
+                reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+                const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+                reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+                const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+                const_iterator         cbegin()  const noexcept { return begin(); }
+                const_iterator         cend()    const noexcept { return end(); }
+                const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+                const_reverse_iterator crend()   const noexcept { return rend(); }
+
+                // 容量相关操作
+                bool      empty()    const noexcept { return size() == 0; }
+                size_type size()     const noexcept
+                { return is_long() ? r_.l.size : static_cast<size_type>(r_.raw[kRepBytes - 1]); }
+                size_type length()   const noexcept { return size(); }
+                size_type capacity() const noexcept { return is_long() ? decode_cap(r_.l.cap) : kShortCap; }
+                size_type max_size() const noexcept { return kMaxCap; }
+
+                void reserve(size_type n)
+                {
+                    if (n > capacity())
+                    {
+                        THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+                        reallocate(n);
+                    }
+                }
+
+                void shrink_to_fit();
+
+                // 访问元素相关操作
+                reference       operator[](size_type n)
+                {
+                    MYSTL_DEBUG(n <= size());
+                    return data_ptr()[n];
+                }
+                const_reference operator[](size_type n) const
+                {
+                    MYSTL_DEBUG(n <= size());
+                    return data_ptr()[n];
+                }
+
+                reference       at(size_type n)
+                {
+                    THROW_OUT_OF_RANGE_IF(n >= size(), "basic_string<Char, Traits>::at() subscript out of range");
+                    return data_ptr()[n];
+                }
+                const_reference at(size_type n) const
+                {
+                    THROW_OUT_OF_RANGE_IF(n >= size(), "basic_string<Char, Traits>::at() subscript out of range");
+                    return data_ptr()[n];
+                }
+
+                reference       front()
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *begin();
+                }
+                const_reference front() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *begin();
+                }
+                reference       back()
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *(end() - 1);
+                }
+                const_reference back()  const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *(end() - 1);
+                }
+
+                const_pointer data()  const noexcept { return data_ptr(); }
+                pointer       data()        noexcept { return data_ptr(); }
+                const_pointer c_str() const noexcept { return data_ptr(); }
+
+                // 赋值
+                basic_string& assign(const basic_string& str)
+                { return *this = str; }
+                basic_string& assign(basic_string&& str) noexcept
+                { return *this = mystl::move(str); }
+                basic_string& assign(const basic_string& str, size_type pos, size_type count = npos)
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > str.size(), "basic_string<Char, Traits>::assign() position out of range");
+                    return assign(str.data() + pos, mystl::min(count, str.size() - pos));
+                }
+                basic_string& assign(const_pointer str, size_type count)
+                { return replace_aux(0, size(), str, count); }
+                basic_string& assign(const_pointer str)
+                { return assign(str, traits_type::length(str)); }
+                basic_string& assign(size_type count, value_type ch)
+                { return replace_fill(0, size(), count, ch); }
+                template <class Iter, typename std::enable_if<
+                    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+                    basic_string& assign(Iter first, Iter last)
+                    { return *this = basic_string(first, last); }
+                basic_string& assign(std::initializer_list<value_type> ilist)
+                { return assign(ilist.begin(), ilist.size()); }
+
+                // 插入
+                basic_string& insert(size_type pos, size_type count, value_type ch)
+                {
+                    check_pos(pos, "basic_string<Char, Traits>::insert() position out of range");
+                    return replace_fill(pos, 0, count, ch);
+                }
+                basic_string& insert(size_type pos, const_pointer str)
+                { return insert(pos, str, traits_type::length(str)); }
+                basic_string& insert(size_type pos, const_pointer str, size_type count)
+                {
+                    check_pos(pos, "basic_string<Char, Traits>::insert() position out of range");
+                    return replace_aux(pos, 0, str, count);
+                }
+                basic_string& insert(size_type pos, const basic_string& str)
+                { return insert(pos, str.data(), str.size()); }
+                basic_string& insert(size_type pos, const basic_string& str, size_type pos2, size_type count = npos)
+                {
+                    THROW_OUT_OF_RANGE_IF(pos2 > str.size(), "basic_string<Char, Traits>::insert() position out of range");
+                    return insert(pos, str.data() + pos2, mystl::min(count, str.size() - pos2));
+                }
+                iterator insert(const_iterator p, value_type ch)
+                { return insert(p, size_type(1), ch); }
+                iterator insert(const_iterator p, size_type count, value_type ch)
+                {
+                    const size_type pos = p - begin();
+                    replace_fill(pos, 0, count, ch);
+                    return begin() + pos;
+                }
+                template <class Iter, typename std::enable_if<
+                    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+                    iterator insert(const_iterator p, Iter first, Iter last)
+                    {
+                        const size_type pos = p - begin();
+                        const basic_string tmp(first, last);
+                        replace_aux(pos, 0, tmp.data(), tmp.size());
+                        return begin() + pos;
+                    }
+                iterator insert(const_iterator p, std::initializer_list<value_type> ilist)
+                {
+                    const size_type pos = p - begin();
+                    replace_aux(pos, 0, ilist.begin(), ilist.size());
+                    return begin() + pos;
+                }
+
+                // 在尾部追加
+                void push_back(value_type ch)
+                {
+                    const size_type n = size();
+                    if (n == capacity())
+                        reallocate(recommend(n + 1));
+                    pointer p = data_ptr();
+                    traits_type::fill(p + n, ch, 1);
+                    set_size(n + 1);
+                }
+
+                void pop_back()
+                {
+                    MYSTL_DEBUG(!empty());
+                    set_size(size() - 1);
+                }
+
+                basic_string& append(const basic_string& str)
+                { return append(str.data(), str.size()); }
+                basic_string& append(const basic_string& str, size_type pos, size_type count = npos)
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > str.size(), "basic_string<Char, Traits>::append() position out of range");
+                    return append(str.data() + pos, mystl::min(count, str.size() - pos));
+                }
+                basic_string& append(const_pointer str, size_type count);
+                basic_string& append(const_pointer str)
+                { return append(str, traits_type::length(str)); }
+                basic_string& append(size_type count, value_type ch)
+                { return replace_fill(size(), 0, count, ch); }
+                template <class Iter, typename std::enable_if<
+                    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+                    basic_string& append(Iter first, Iter last)
+                    {
+                        const basic_string tmp(first, last);
+                        return append(tmp.data(), tmp.size());
+                    }
+                basic_string& append(std::initializer_list<value_type> ilist)
+                { return append(ilist.begin(), ilist.size()); }
+
+                basic_string& operator+=(const basic_string& str) { return append(str.data(), str.size()); }
+                basic_string& operator+=(const_pointer str)       { return append(str, traits_type::length(str)); }
+                basic_string& operator+=(value_type ch)           { push_back(ch); return *this; }
+                basic_string& operator+=(std::initializer_list<value_type> ilist)
+                { return append(ilist.begin(), ilist.size()); }
+
+                // 删除
+                basic_string& erase(size_type pos = 0, size_type count = npos)
+                {
+                    check_pos(pos, "basic_string<Char, Traits>::erase() position out of range");
+                    return replace_aux(pos, clamp(pos, count), nullptr, 0);
+                }
+                iterator erase(const_iterator p)
+                {
+                    MYSTL_DEBUG(p != end());
+                    const size_type pos = p - begin();
+                    replace_aux(pos, 1, nullptr, 0);
+                    return begin() + pos;
+                }
+                iterator erase(const_iterator first, const_iterator last)
+                {
+                    const size_type pos = first - begin();
+                    replace_aux(pos, static_cast<size_type>(last - first), nullptr, 0);
+                    return begin() + pos;
+                }
+
+                void clear() noexcept { set_size(0); }
+
+                // 改变大小
+                void resize(size_type count) { resize(count, value_type()); }
+                void resize(size_type count, value_type ch)
+                {
+                    const size_type n = size();
+                    if (count < n)
+                        set_size(count);
+                    else
+                        append(count - n, ch);
+                }
+
+                // 替换
+                basic_string& replace(size_type pos, size_type count, const basic_string& str)
+                { return replace(pos, count, str.data(), str.size()); }
+                basic_string& replace(size_type pos, size_type count, const basic_string& str,
+                                      size_type pos2, size_type count2 = npos)
+                {
+                    THROW_OUT_OF_RANGE_IF(pos2 > str.size(), "basic_string<Char, Traits>::replace() position out of range");
+                    return replace(pos, count, str.data() + pos2, mystl::min(count2, str.size() - pos2));
+                }
+                basic_string& replace(size_type pos, size_type count, const_pointer str, size_type count2)
+                {
+                    check_pos(pos, "basic_string<Char, Traits>::replace() position out of range");
+                    return replace_aux(pos, clamp(pos, count), str, count2);
+                }
+                basic_string& replace(size_type pos, size_type count, const_pointer str)
+                { return replace(pos, count, str, traits_type::length(str)); }
+                basic_string& replace(size_type pos, size_type count, size_type count2, value_type ch)
+                {
+                    check_pos(pos, "basic_string<Char, Traits>::replace() position out of range");
+                    return replace_fill(pos, clamp(pos, count), count2, ch);
+                }
+                basic_string& replace(const_iterator first, const_iterator last, const basic_string& str)
+                { return replace_aux(first - begin(), last - first, str.data(), str.size()); }
+                basic_string& replace(const_iterator first, const_iterator last, const_pointer str, size_type count2)
+                { return replace_aux(first - begin(), last - first, str, count2); }
+                basic_string& replace(const_iterator first, const_iterator last, const_pointer str)
+                { return replace_aux(first - begin(), last - first, str, traits_type::length(str)); }
+                basic_string& replace(const_iterator first, const_iterator last, size_type count2, value_type ch)
+                { return replace_fill(first - begin(), last - first, count2, ch); }
+                template <class Iter, typename std::enable_if<
+                    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+                    basic_string& replace(const_iterator first, const_iterator last, Iter first2, Iter last2)
+                    {
+                        const basic_string tmp(first2, last2);
+                        return replace_aux(first - begin(), last - first, tmp.data(), tmp.size());
+                    }
+
+                // 复制 [pos, pos + count) 到 dst，不添加结尾的空字符，返回复制的字符个数
+                size_type copy(pointer dst, size_type count, size_type pos = 0) const
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::copy() position out of range");
+                    count = clamp(pos, count);
+                    traits_type::copy(dst, data_ptr() + pos, count);
+                    return count;
+                }
+
+                basic_string substr(size_type pos = 0, size_type count = npos) const
+                { return basic_string(*this, pos, count); }
+
+                void swap(basic_string& rhs) noexcept
+                {
+                    if (this != &rhs)
+                    {
+                        rep tmp = r_;
+                        r_ = rhs.r_;
+                        rhs.r_ = tmp;
+                    }
+                }
+
+                // 比较
+                int compare(const basic_string& str) const noexcept
+                { return compare_aux(data_ptr(), size(), str.data(), str.size()); }
+                int compare(size_type pos, size_type count, const basic_string& str) const
+                { return compare(pos, count, str.data(), str.size()); }
+                int compare(size_type pos, size_type count, const basic_string& str,
+                            size_type pos2, size_type count2 = npos) const
+                {
+                    THROW_OUT_OF_RANGE_IF(pos2 > str.size(), "basic_string<Char, Traits>::compare() position out of range");
+                    return compare(pos, count, str.data() + pos2, mystl::min(count2, str.size() - pos2));
+                }
+                int compare(const_pointer str) const
+                { return compare_aux(data_ptr(), size(), str, traits_type::length(str)); }
+                int compare(size_type pos, size_type count, const_pointer str) const
+                { return compare(pos, count, str, traits_type::length(str)); }
+                int compare(size_type pos, size_type count, const_pointer str, size_type count2) const
+                {
+                    check_pos(pos, "basic_string<Char, Traits>::compare() position out of range");
+                    return compare_aux(data_ptr() + pos, clamp(pos, count), str, count2);
+                }
+
+                // 查找，找不到时返回 npos
+                size_type find(const basic_string& str, size_type pos = 0) const noexcept
+                { return find(str.data(), pos, str.size()); }
+                size_type find(const_pointer str, size_type pos, size_type count) const noexcept;
+                size_type find(const_pointer str, size_type pos = 0) const noexcept
+                { return find(str, pos, traits_type::length(str)); }
+                size_type find(value_type ch, size_type pos = 0) const noexcept;
+
+                size_type rfind(const basic_string& str, size_type pos = npos) const noexcept
+                { return rfind(str.data(), pos, str.size()); }
+                size_type rfind(const_pointer str, size_type pos, size_type count) const noexcept;
+                size_type rfind(const_pointer str, size_type pos = npos) const noexcept
+                { return rfind(str, pos, traits_type::length(str)); }
+                size_type rfind(value_type ch, size_type pos = npos) const noexcept;
+
+                size_type find_first_of(const basic_string& str, size_type pos = 0) const noexcept
+                { return find_first_of(str.data(), pos, str.size()); }
+                size_type find_first_of(const_pointer str, size_type pos, size_type count) const noexcept;
+                size_type find_first_of(const_pointer str, size_type pos = 0) const noexcept
+                { return find_first_of(str, pos, traits_type::length(str)); }
+                size_type find_first_of(value_type ch, size_type pos = 0) const noexcept
+                { return find(ch, pos); }
+
+                size_type find_last_of(const basic_string& str, size_type pos = npos) const noexcept
+                { return find_last_of(str.data(), pos, str.size()); }
+                size_type find_last_of(const_pointer str, size_type pos, size_type count) const noexcept;
+                size_type find_last_of(const_pointer str, size_type pos = npos) const noexcept
+                { return find_last_of(str, pos, traits_type::length(str)); }
+                size_type find_last_of(value_type ch, size_type pos = npos) const noexcept
+                { return rfind(ch, pos); }
+
+                size_type find_first_not_of(const basic_string& str, size_type pos = 0) const noexcept
+                { return find_first_not_of(str.data(), pos, str.size()); }
+                size_type find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept;
+                size_type find_first_not_of(const_pointer str, size_type pos = 0) const noexcept
+                { return find_first_not_of(str, pos, traits_type::length(str)); }
+                size_type find_first_not_of(value_type ch, size_type pos = 0) const noexcept
+                { return find_first_not_of(&ch, pos, 1); }
+
+                size_type find_last_not_of(const basic_string& str, size_type pos = npos) const noexcept
+                { return find_last_not_of(str.data(), pos, str.size()); }
+                size_type find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept;
+                size_type find_last_not_of(const_pointer str, size_type pos = npos) const noexcept
+                { return find_last_not_of(str, pos, traits_type::length(str)); }
+                size_type find_last_not_of(value_type ch, size_type pos = npos) const noexcept
+                { return find_last_not_of(&ch, pos, 1); }
+
+            private:
+                // 容量的编码：保证 rep 的最后一个字节的最高位为 1
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                static constexpr size_type kMaxCap = (static_cast<size_type>(-1) >> 8) / sizeof(CharType) - 1;
+                static size_type encode_cap(size_type cap) noexcept { return cap << 8 | 0x80; }
+                static size_type decode_cap(size_type x)   noexcept { return x >> 8; }
+#else
+                static constexpr size_type kLongFlag = static_cast<size_type>(1) << (sizeof(size_type) * 8 - 1);
+                static constexpr size_type kMaxCap = (static_cast<size_type>(-1) >> 1) / sizeof(CharType) - 1;
+                static size_type encode_cap(size_type cap) noexcept { return cap | kLongFlag; }
+                static size_type decode_cap(size_type x)   noexcept { return x & ~kLongFlag; }
+#endif
+
+                bool is_long() const noexcept { return (r_.raw[kRepBytes - 1] & 0x80) != 0; }
+
+                pointer       data_ptr()       noexcept { return is_long() ? r_.l.data : r_.s; }
+                const_pointer data_ptr() const noexcept { return is_long() ? r_.l.data : r_.s; }
+
+                // 设置长度并写入结尾的空字符
+                void set_size(size_type n) noexcept
+                {
+                    if (is_long())
+                    {
+                        r_.l.size = n;
+                        r_.l.data[n] = value_type();
+                    }
+                    else
+                    {
+                        r_.raw[kRepBytes - 1] = static_cast<unsigned char>(n);
+                        r_.s[n] = value_type();
+                    }
+                }
+
+                void init_short(size_type n) noexcept
+                {
+                    r_.raw[kRepBytes - 1] = static_cast<unsigned char>(n);
+                    r_.s[n] = value_type();
+                }
+
+                void set_long(pointer p, size_type n, size_type cap) noexcept
+                {
+                    r_.l.data = p;
+                    r_.l.size = n;
+                    r_.l.cap = encode_cap(cap);
+                    p[n] = value_type();
+                }
+
+                // 分配可以保存 cap 个字符及结尾的空字符的空间
+                static pointer allocate(size_type cap) { return data_allocator::allocate(cap + 1); }
+
+                void release() noexcept
+                {
+                    if (is_long())
+                        data_allocator::deallocate(r_.l.data, decode_cap(r_.l.cap) + 1);
+                }
+
+                // 长度增长到 n 时的新容量，至少为原来的两倍
+                size_type recommend(size_type n) const
+                {
+                    THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+                    const size_type cap = capacity();
+                    if (cap >= max_size() / 2)
+                        return max_size();
+                    return mystl::max(n, cap * 2);
+                }
+
+                void check_pos(size_type pos, const char* what) const
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > size(), what);
+                }
+
+                // 从 pos 起至多 count 个字符时实际的字符个数
+                size_type clamp(size_type pos, size_type count) const noexcept
+                { return mystl::min(count, size() - pos); }
+
+                static int compare_aux(const_pointer s1, size_type n1, const_pointer s2, size_type n2) noexcept
+                {
+                    const int r = traits_type::compare(s1, s2, mystl::min(n1, n2));
+                    if (r != 0)
+                        return r;
+                    return n1 < n2 ? -1 : (n2 < n1 ? 1 : 0);
+                }
+
+                void init(const_pointer str, size_type n);
+                void init_fill(size_type n, value_type ch);
+                template <class IIter>
+                    void init_range(IIter first, IIter last, input_iterator_tag);
+                template <class FIter>
+                    void init_range(FIter first, FIter last, forward_iterator_tag);
+
+                void reallocate(size_type cap);
+
+                basic_string& replace_aux(size_type pos, size_type n1, const_pointer str, size_type n2);
+                basic_string& replace_fill(size_type pos, size_type n1, size_type n2, value_type ch);
+        };
+
+    template <class CharType, class CharTraits>
+        constexpr typename basic_string<CharType, CharTraits>::size_type basic_string<CharType, CharTraits>::npos;
+
+    /*****************************************************************************************/
+    // helper function
+
+    // 以 [str, str + n) 初始化，较短时保存在对象内部
+    template <class CharType, class CharTraits>
+        void basic_string<CharType, CharTraits>::init(const_pointer str, size_type n)
+        {
+            if (n <= kShortCap)
+            {
+                traits_type::copy(r_.s, str, n);
+                init_short(n);
+                return;
+            }
+            THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+            pointer p = allocate(n);
+            traits_type::copy(p, str, n);
+            set_long(p, n, n);
+        }
+
+    template <class CharType, class CharTraits>
+        void basic_string<CharType, CharTraits>::init_fill(size_type n, value_type ch)
+        {
+            if (n <= kShortCap)
+            {
+                traits_type::fill(r_.s, ch, n);
+                init_short(n);
+                return;
+            }
+            THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+            pointer p = allocate(n);
+            traits_type::fill(p, ch, n);
+            set_long(p, n, n);
+        }
+
+    template <class CharType, class CharTraits>
+        template <class IIter>
+        void basic_string<CharType, CharTraits>::init_range(IIter first, IIter last, input_iterator_tag)
+        {
+            init_short(0);
+            try
+            {
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+    template <class CharType, class CharTraits>
+        template <class FIter>
+        void basic_string<CharType, CharTraits>::init_range(FIter first, FIter last, forward_iterator_tag)
+        {
+            const size_type n = static_cast<size_type>(mystl::distance(first, last));
+            pointer p;
+            if (n <= kShortCap)
+            {
+                p = r_.s;
+            }
+            else
+            {
+                THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+                p = allocate(n);
+            }
+            try
+            {
+                for (pointer cur = p; first != last; ++first, ++cur)
+                    *cur = *first;
+            }
+            catch (...)
+            {
+                if (p != r_.s)
+                    data_allocator::deallocate(p, n + 1);
+                throw;
+            }
+            if (p == r_.s)
+                init_short(n);
+            else
+                set_long(p, n, n);
+        }
+
+    // 把容量改为 cap(不小于当前长度)，保留原有的字符
+    template <class CharType, class CharTraits>
+        void basic_string<CharType, CharTraits>::reallocate(size_type cap)
+        {
+            const size_type n = size();
+            pointer p = allocate(cap);
+            traits_type::copy(p, data_ptr(), n);
+            release();
+            set_long(p, n, cap);
+        }
+
+    template <class CharType, class CharTraits>
+        void basic_string<CharType, CharTraits>::shrink_to_fit()
+        {
+            if (!is_long())
+                return;
+            const size_type n = r_.l.size;
+            const size_type cap = decode_cap(r_.l.cap);
+            if (n <= kShortCap)
+            {  // 放回对象内部
+                pointer p = r_.l.data;
+                traits_type::copy(r_.s, p, n);
+                init_short(n);
+                data_allocator::deallocate(p, cap + 1);
+            }
+            else if (n < cap)
+            {
+                reallocate(n);
+            }
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>&
+        basic_string<CharType, CharTraits>::append(const_pointer str, size_type count)
+        {
+            const size_type n = size();
+            if (count <= capacity() - n)
+            {  // 写入的位置在原有字符之后，str 即使指向自身也不会被覆盖
+                traits_type::copy(data_ptr() + n, str, count);
+                set_size(n + count);
+                return *this;
+            }
+            THROW_LENGTH_ERROR_IF(count > max_size() - n, "basic_string<Char, Traits>'s size too big");
+            const size_type cap = recommend(n + count);
+            pointer p = allocate(cap);
+            traits_type::copy(p, data_ptr(), n);
+            traits_type::copy(p + n, str, count);
+            release();
+            set_long(p, n + count, cap);
+            return *this;
+        }
+
+    // 把 [pos, pos + n1) 替换为 [str, str + n2)，str 可以指向自身
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>&
+        basic_string<CharType, CharTraits>::replace_aux(size_type pos, size_type n1, const_pointer str, size_type n2)
+        {
+            const size_type old = size();
+            MYSTL_DEBUG(pos <= old && n1 <= old - pos);
+            THROW_LENGTH_ERROR_IF(n2 > n1 && n2 - n1 > max_size() - old,
+                                  "basic_string<Char, Traits>'s size too big");
+            const size_type new_size = old - n1 + n2;
+            const size_type tail = old - pos - n1;
+            if (new_size > capacity())
+            {  // 重新分配时原有的字符仍然有效，str 指向自身也没有关系
+                const size_type cap = recommend(new_size);
+                pointer p = allocate(cap);
+                const_pointer src = data_ptr();
+                traits_type::copy(p, src, pos);
+                traits_type::copy(p + pos, str, n2);
+                traits_type::copy(p + pos + n2, src + pos + n1, tail);
+                release();
+                set_long(p, new_size, cap);
+                return *this;
+            }
+            pointer hole = data_ptr() + pos;
+            const_pointer first = data_ptr();
+            if (str + n2 <= first || first + old <= str)
+            {  // str 不指向自身
+                if (n1 != n2)
+                    traits_type::move(hole + n2, hole + n1, tail);
+                traits_type::copy(hole, str, n2);
+            }
+            else if (n2 <= n1)
+            {  // 先写入 str，再左移后面的字符，写入的范围不超过被替换的范围
+                traits_type::move(hole, str, n2);
+                traits_type::move(hole + n2, hole + n1, tail);
+            }
+            else
+            {  // 先右移后面的字符，位于其中的 str 随之右移 n2 - n1
+                traits_type::move(hole + n2, hole + n1, tail);
+                if (str + n2 <= hole + n1)
+                {
+                    traits_type::move(hole, str, n2);
+                }
+                else if (str >= hole + n1)
+                {
+                    traits_type::copy(hole, str + (n2 - n1), n2);
+                }
+                else
+                {  // str 跨过被替换的范围的末尾，分两段写入
+                    const size_type left = static_cast<size_type>(hole + n1 - str);
+                    traits_type::move(hole, str, left);
+                    traits_type::copy(hole + left, hole + n2, n2 - left);
+                }
+            }
+            set_size(new_size);
+            return *this;
+        }
+
+    // 把 [pos, pos + n1) 替换为 n2 个 ch
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>&
+        basic_string<CharType, CharTraits>::replace_fill(size_type pos, size_type n1, size_type n2, value_type ch)
+        {
+            const size_type old = size();
+            MYSTL_DEBUG(pos <= old && n1 <= old - pos);
+            THROW_LENGTH_ERROR_IF(n2 > n1 && n2 - n1 > max_size() - old,
+                                  "basic_string<Char, Traits>'s size too big");
+            const size_type new_size = old - n1 + n2;
+            const size_type tail = old - pos - n1;
+            if (new_size > capacity())
+            {
+                const size_type cap = recommend(new_size);
+                pointer p = allocate(cap);
+                const_pointer src = data_ptr();
+                traits_type::copy(p, src, pos);
+                traits_type::fill(p + pos, ch, n2);
+                traits_type::copy(p + pos + n2, src + pos + n1, tail);
+                release();
+                set_long(p, new_size, cap);
+                return *this;
+            }
+            pointer hole = data_ptr() + pos;
+            if (n1 != n2)
+                traits_type::move(hole + n2, hole + n1, tail);
+            traits_type::fill(hole, ch, n2);
+            set_size(new_size);
+            return *this;
+        }
+
+    /*****************************************************************************************/
+    // find
+
+    // 以 traits_type::find 跳到首字符出现的位置，再比较其余的字符
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos, size_type count) const noexcept
+        {
+            const size_type n = size();
+            if (count == 0)
+                return pos <= n ? pos : npos;
+            if (pos >= n || count > n - pos)
+                return npos;
+            const_pointer first = data_ptr();
+            const_pointer cur = first + pos;
+            const_pointer last = first + n - count + 1;  // 匹配的起点不能超过 last
+            while (cur < last)
+            {
+                cur = traits_type::find(cur, static_cast<size_type>(last - cur), str[0]);
+                if (cur == nullptr)
+                    return npos;
+                if (traits_type::compare(cur + 1, str + 1, count - 1) == 0)
+                    return static_cast<size_type>(cur - first);
+                ++cur;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::find(value_type ch, size_type pos) const noexcept
+        {
+            const size_type n = size();
+            if (pos >= n)
+                return npos;
+            const_pointer first = data_ptr();
+            const_pointer r = traits_type::find(first + pos, n - pos, ch);
+            return r == nullptr ? npos : static_cast<size_type>(r - first);
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos, size_type count) const noexcept
+        {
+            const size_type n = size();
+            if (count > n)
+                return npos;
+            const_pointer first = data_ptr();
+            for (size_type i = mystl::min(pos, n - count) + 1; i > 0; --i)
+            {
+                if (traits_type::compare(first + i - 1, str, count) == 0)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::rfind(value_type ch, size_type pos) const noexcept
+        {
+            const size_type n = size();
+            if (n == 0)
+                return npos;
+            const_pointer first = data_ptr();
+            for (size_type i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+            {
+                if (first[i - 1] == ch)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::find_first_of(const_pointer str, size_type pos, size_type count) const noexcept
+        {
+            const size_type n = size();
+            const_pointer first = data_ptr();
+            for (size_type i = pos; i < n; ++i)
+            {
+                if (traits_type::find(str, count, first[i]) != nullptr)
+                    return i;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::find_last_of(const_pointer str, size_type pos, size_type count) const noexcept
+        {
+            const size_type n = size();
+            if (n == 0)
+                return npos;
+            const_pointer first = data_ptr();
+            for (size_type i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+            {
+                if (traits_type::find(str, count, first[i - 1]) != nullptr)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept
+        {
+            const size_type n = size();
+            const_pointer first = data_ptr();
+            for (size_type i = pos; i < n; ++i)
+            {
+                if (traits_type::find(str, count, first[i]) == nullptr)
+                    return i;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string<CharType, CharTraits>::size_type
+        basic_string<CharType, CharTraits>::find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept
+        {
+            const size_type n = size();
+            if (n == 0)
+                return npos;
+            const_pointer first = data_ptr();
+            for (size_type i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+            {
+                if (traits_type::find(str, count, first[i - 1]) == nullptr)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    /*****************************************************************************************/
+    // 重载全局操作符
+
+    // 重载 operator+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            basic_string<CharType, CharTraits> tmp;
+            tmp.reserve(lhs.size() + rhs.size());
+            tmp.append(lhs.data(), lhs.size());
+            tmp.append(rhs.data(), rhs.size());
+            return tmp;
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            const size_t n = CharTraits::length(lhs);
+            basic_string<CharType, CharTraits> tmp;
+            tmp.reserve(n + rhs.size());
+            tmp.append(lhs, n);
+            tmp.append(rhs.data(), rhs.size());
+            return tmp;
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(CharType ch, const basic_string<CharType, CharTraits>& rhs)
+        {
+            basic_string<CharType, CharTraits> tmp;
+            tmp.reserve(rhs.size() + 1);
+            tmp.push_back(ch);
+            tmp.append(rhs.data(), rhs.size());
+            return tmp;
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            const size_t n = CharTraits::length(rhs);
+            basic_string<CharType, CharTraits> tmp;
+            tmp.reserve(lhs.size() + n);
+            tmp.append(lhs.data(), lhs.size());
+            tmp.append(rhs, n);
+            return tmp;
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(const basic_string<CharType, CharTraits>& lhs, CharType ch)
+        {
+            basic_string<CharType, CharTraits> tmp;
+            tmp.reserve(lhs.size() + 1);
+            tmp.append(lhs.data(), lhs.size());
+            tmp.push_back(ch);
+            return tmp;
+        }
+
+    // 左操作数为右值时直接在其上追加，连续相加时不必每次都复制
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(basic_string<CharType, CharTraits>&& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return mystl::move(lhs.append(rhs));
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(const basic_string<CharType, CharTraits>& lhs, basic_string<CharType, CharTraits>&& rhs)
+        {
+            return mystl::move(rhs.insert(0, lhs));
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(basic_string<CharType, CharTraits>&& lhs, basic_string<CharType, CharTraits>&& rhs)
+        {
+            return mystl::move(lhs.append(rhs));
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(const CharType* lhs, basic_string<CharType, CharTraits>&& rhs)
+        {
+            return mystl::move(rhs.insert(0, lhs));
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(CharType ch, basic_string<CharType, CharTraits>&& rhs)
+        {
+            rhs.insert(rhs.begin(), ch);
+            return mystl::move(rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(basic_string<CharType, CharTraits>&& lhs, const CharType* rhs)
+        {
+            return mystl::move(lhs.append(rhs));
+        }
+
+    template <class CharType, class CharTraits>
+        basic_string<CharType, CharTraits>
+        operator+(basic_string<CharType, CharTraits>&& lhs, CharType ch)
+        {
+            lhs.push_back(ch);
+            return mystl::move(lhs);
+        }
+
+    // 重载比较操作符
+    template <class CharType, class CharTraits>
+        bool operator==(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return lhs.size() == rhs.size() && CharTraits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator==(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            return lhs.compare(rhs) == 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator==(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return rhs.compare(lhs) == 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator!=(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator!=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator!=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return rhs.compare(lhs) > 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return rhs < lhs;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            return rhs < lhs;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return rhs < lhs;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<=(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>=(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    // 重载 mystl 的 swap
+    template <class CharType, class CharTraits>
+        void swap(basic_string<CharType, CharTraits>& lhs, basic_string<CharType, CharTraits>& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+    // 输入输出，借助标准库的字符串处理宽度与空白字符
+    template <class CharType, class CharTraits>
+        std::basic_ostream<CharType>&
+        operator<<(std::basic_ostream<CharType>& os, const basic_string<CharType, CharTraits>& str)
+        {
+            return os << std::basic_string<CharType>(str.data(), str.size());
+        }
+
+    template <class CharType, class CharTraits>
+        std::basic_istream<CharType>&
+        operator>>(std::basic_istream<CharType>& is, basic_string<CharType, CharTraits>& str)
+        {
+            std::basic_string<CharType> tmp;
+            if (is >> tmp)
+                str.assign(tmp.data(), tmp.size());
+            return is;
+        }
+
+    template <class CharType, class CharTraits>
+        std::basic_istream<CharType>&
+        getline(std::basic_istream<CharType>& is, basic_string<CharType, CharTraits>& str, CharType delim)
+        {
+            std::basic_string<CharType> tmp;
+            if (std::getline(is, tmp, delim))
+                str.assign(tmp.data(), tmp.size());
+            return is;
+        }
+
+    template <class CharType, class CharTraits>
+        std::basic_istream<CharType>&
+        getline(std::basic_istream<CharType>& is, basic_string<CharType, CharTraits>& str)
+        {
+            return mystl::getline(is, str, is.widen('\n'));
+        }
+
+    // 字符串的哈希函数偏特化版本，逐字节计算 FNV-1 哈希
+    template <class CharType, class CharTraits>
+        struct hash<basic_string<CharType, CharTraits>>
+        {
+            size_t operator()(const basic_string<CharType, CharTraits>& str) const noexcept
+            {
+                return bitwise_hash(reinterpret_cast<const unsigned char*>(str.data()),
+                                    str.size() * sizeof(CharType));
+            }
+        };
+
+    typedef basic_string<char>     string;
+    typedef basic_string<wchar_t>  wstring;
+    typedef basic_string<char16_t> u16string;
+    typedef basic_string<char32_t> u32string;
 }
 
 
@@ -0,0 +1,382 @@
+#ifndef MYTINYSTL_CONCURRENT_QUEUE_H_
+#define MYTINYSTL_CONCURRENT_QUEUE_H_
+
+// 这个头文件包含两个无锁的有界队列
+// spsc_queue: 单生产者单消费者队列
+// mpmc_queue: 多生产者多消费者队列
+
+// notes:
+//
+// 两个队列的容量都在构造时指定，并向上取整为 2 的幂，下标通过与掩码按位与得到
+// 读写位置分别放在独立的缓存行中，避免生产者与消费者之间的伪共享
+//
+// spsc_queue 的每个操作都是 wait-free 的：生产者只写 tail_，消费者只写 head_，
+// 双方各自缓存对方的位置，只有在缓存的位置表明队列满或空时才重新读取对方的原子变量
+//
+// mpmc_queue 采用 Dmitry Vyukov 的有界队列设计：每个槽位带有一个序号，
+// 生产者和消费者通过比较序号与位置判断槽位是否可用，并用 CAS 抢占位置
+// 抢占的槽位无法归还，且消费者会一直等待它被发布，因此抢占之后的构造不能抛出异常：
+// 构造可能抛出异常时先在槽位外构造好元素再移动进去，此时要求 T 的移动构造函数为 noexcept
+//
+// try_ 版本的函数在队列满或空时立即返回 false，push / pop 会自旋等待直到成功
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#include "construct.h"  // 构造、析构对象
+#include "allocator.h"  // 内存分配
+#include "util.h"       // 工具函数
+#include "exceptdef.h"  // 异常定义
+
+namespace mystl
+{
+
+    // 缓存行大小
+    constexpr static size_t kCacheLineSize = 64;
+
+    // 将队列容量向上取整为 2 的幂，至少为 2
+    inline size_t concurrent_queue_round_up(size_t n) noexcept
+    {
+        size_t cap = 2;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    /*****************************************************************************************/
+    // spsc_queue
+    // 单生产者单消费者的无锁有界队列
+    /*****************************************************************************************/
+    template <class T>
+        class spsc_queue
+        {
+            public:
+                typedef T      value_type;  // 数据类型
+                typedef size_t size_type;   // 大小类型
+
+            private:
+                typedef mystl::allocator<T> data_allocator;
+
+                // 消费者使用的数据
+                alignas(kCacheLineSize) std::atomic<size_type> head_;  // 下一个要读取的位置
+                size_type cached_tail_;                                // 消费者缓存的 tail_
+
+                // 生产者使用的数据
+                alignas(kCacheLineSize) std::atomic<size_type> tail_;  // 下一个要写入的位置
+                size_type cached_head_;                                // 生产者缓存的 head_
+
+                // 只读数据
+                alignas(kCacheLineSize) T* buf_;  // 缓冲区
+                size_type mask_;                  // 容量减一
+
+            public:
+                // 创建一个容量至少为 n 的队列
+                explicit spsc_queue(size_type n)
+                    :head_(0), cached_tail_(0), tail_(0), cached_head_(0),
+                    buf_(nullptr), mask_(concurrent_queue_round_up(n) - 1)
+                {
+                    buf_ = data_allocator::allocate(mask_ + 1);
+                }
+
+                spsc_queue(const spsc_queue&) = delete;
+                spsc_queue& operator=(const spsc_queue&) = delete;
+
+                ~spsc_queue()
+                {
+                    const size_type t = tail_.load(std::memory_order_relaxed);
+                    for (size_type h = head_.load(std::memory_order_relaxed); h != t; ++h)
+                        mystl::destroy(buf_ + (h & mask_));
+                    data_allocator::deallocate(buf_, mask_ + 1);
+                }
+
+            public:
+                // 容量相关操作，size 与 empty 在并发时只是一个近似值
+                size_type capacity() const noexcept { return mask_ + 1; }
+                size_type size() const noexcept
+                {
+                    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+                }
+                bool empty() const noexcept { return size() == 0; }
+
+                // 生产者调用
+                template <class... Args>
+                    bool try_emplace(Args&& ...args);
+                bool try_push(const value_type& value) { return try_emplace(value); }
+                bool try_push(value_type&& value)      { return try_emplace(mystl::move(value)); }
+
+                template <class... Args>
+                    void emplace(Args&& ...args)
+                    {
+                        while (!try_emplace(mystl::forward<Args>(args)...))
+                            std::this_thread::yield();
+                    }
+                void push(const value_type& value) { emplace(value); }
+                void push(value_type&& value)      { emplace(mystl::move(value)); }
+
+                // 消费者调用
+                value_type* front();  // 队列为空时返回 nullptr
+                void        pop_front();
+                bool        try_pop(value_type& value);
+                void        pop(value_type& value)
+                {
+                    while (!try_pop(value))
+                        std::this_thread::yield();
+                }
+        };
+
+    /*****************************************************************************************/
+
+    // 在队尾构造元素，队列满时返回 false
+    template <class T>
+        template <class... Args>
+        bool spsc_queue<T>::try_emplace(Args&& ...args)
+        {
+            const size_type t = tail_.load(std::memory_order_relaxed);
+            if (t - cached_head_ > mask_)
+            { // 缓存的位置表明队列已满，重新读取 head_
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (t - cached_head_ > mask_)
+                    return false;
+            }
+            mystl::construct(buf_ + (t & mask_), mystl::forward<Args>(args)...);
+            tail_.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+    // 返回队头元素的地址
+    template <class T>
+        typename spsc_queue<T>::value_type* spsc_queue<T>::front()
+        {
+            const size_type h = head_.load(std::memory_order_relaxed);
+            if (h == cached_tail_)
+            { // 缓存的位置表明队列为空，重新读取 tail_
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (h == cached_tail_)
+                    return nullptr;
+            }
+            return buf_ + (h & mask_);
+        }
+
+    // 弹出队头元素，调用前 front() 必须返回非空
+    template <class T>
+        void spsc_queue<T>::pop_front()
+        {
+            const size_type h = head_.load(std::memory_order_relaxed);
+            MYSTL_DEBUG(h != cached_tail_);
+            mystl::destroy(buf_ + (h & mask_));
+            head_.store(h + 1, std::memory_order_release);
+        }
+
+    // 将队头元素移动到 value 并弹出，队列为空时返回 false
+    template <class T>
+        bool spsc_queue<T>::try_pop(value_type& value)
+        {
+            value_type* p = front();
+            if (p == nullptr)
+                return false;
+            value = mystl::move(*p);
+            pop_front();
+            return true;
+        }
+
+    /*****************************************************************************************/
+    // mpmc_queue
+    // 多生产者多消费者的无锁有界队列
+    /*****************************************************************************************/
+    template <class T>
+        class mpmc_queue
+        {
+            public:
+                typedef T      value_type;  // 数据类型
+                typedef size_t size_type;   // 大小类型
+
+            private:
+                // 槽位：seq 与位置相等时可写，等于位置加一时可读
+                struct cell
+                {
+                    std::atomic<size_type> seq;
+                    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+                    T* value() noexcept { return reinterpret_cast<T*>(&storage); }
+                };
+                typedef mystl::allocator<cell> cell_allocator;
+
+                alignas(kCacheLineSize) cell*  cells_;  // 槽位数组
+                size_type mask_;                         // 容量减一
+
+                alignas(kCacheLineSize) std::atomic<size_type> enqueue_pos_;  // 下一个要写入的位置
+                alignas(kCacheLineSize) std::atomic<size_type> dequeue_pos_;  // 下一个要读取的位置
+
+            public:
+                // 创建一个容量至少为 n 的队列
+                explicit mpmc_queue(size_type n)
+                    :cells_(nullptr), mask_(concurrent_queue_round_up(n) - 1),
+                    enqueue_pos_(0), dequeue_pos_(0)
+                {
+                    cells_ = cell_allocator::allocate(mask_ + 1);
+                    for (size_type i = 0; i <= mask_; ++i)
+                        mystl::construct(&cells_[i].seq, i);
+                }
+
+                mpmc_queue(const mpmc_queue&) = delete;
+                mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+                ~mpmc_queue()
+                {
+                    const size_type e = enqueue_pos_.load(std::memory_order_relaxed);
+                    for (size_type d = dequeue_pos_.load(std::memory_order_relaxed); d != e; ++d)
+                        mystl::destroy(cells_[d & mask_].value());
+                    cell_allocator::deallocate(cells_, mask_ + 1);
+                }
+
+            private:
+                template <class... Args>
+                    bool emplace_aux(m_true_type, Args&& ...args);
+                template <class... Args>
+                    bool emplace_aux(m_false_type, Args&& ...args);
+                template <class... Args>
+                    void emplace_wait(m_true_type, Args&& ...args);
+                template <class... Args>
+                    void emplace_wait(m_false_type, Args&& ...args);
+
+            public:
+                // 容量相关操作，size 与 empty 在并发时只是一个近似值
+                size_type capacity() const noexcept { return mask_ + 1; }
+                size_type size() const noexcept
+                {
+                    const size_type d = dequeue_pos_.load(std::memory_order_acquire);
+                    const size_type e = enqueue_pos_.load(std::memory_order_acquire);
+                    return e > d ? e - d : 0;
+                }
+                bool empty() const noexcept { return size() == 0; }
+
+                // 生产者调用
+                template <class... Args>
+                    bool try_emplace(Args&& ...args)
+                    {
+                        return emplace_aux(m_bool_constant<
+                            std::is_nothrow_constructible<T, Args&&...>::value>(),
+                            mystl::forward<Args>(args)...);
+                    }
+                bool try_push(const value_type& value) { return try_emplace(value); }
+                bool try_push(value_type&& value)      { return try_emplace(mystl::move(value)); }
+
+                template <class... Args>
+                    void emplace(Args&& ...args)
+                    {
+                        emplace_wait(m_bool_constant<
+                            std::is_nothrow_constructible<T, Args&&...>::value>(),
+                            mystl::forward<Args>(args)...);
+                    }
+                void push(const value_type& value) { emplace(value); }
+                void push(value_type&& value)      { emplace(mystl::move(value)); }
+
+                // 消费者调用
+                bool try_pop(value_type& value);
+                void pop(value_type& value)
+                {
+                    while (!try_pop(value))
+                        std::this_thread::yield();
+                }
+        };
+
+    /*****************************************************************************************/
+
+    // 抢占一个可写的槽位并构造元素，队列满时返回 false
+    template <class T>
+        template <class... Args>
+        bool mpmc_queue<T>::emplace_aux(m_true_type, Args&& ...args)
+        {
+            cell* c;
+            size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                c = &cells_[pos & mask_];
+                const size_type seq = c->seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<ptrdiff_t>(seq - pos);
+                if (diff == 0)
+                { // 槽位可写，尝试抢占该位置
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                { // 槽位中的元素还未被读取，队列已满
+                    return false;
+                }
+                else
+                { // 其它生产者已抢占该位置
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            mystl::construct(c->value(), mystl::forward<Args>(args)...);
+            c->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+    // 构造可能抛出异常时，先在槽位外构造好元素，抢占的槽位无法归还
+    // 队列满时返回 false，此时以右值传入的参数已被移动到临时对象中
+    template <class T>
+        template <class... Args>
+        bool mpmc_queue<T>::emplace_aux(m_false_type, Args&& ...args)
+        {
+            static_assert(std::is_nothrow_move_constructible<T>::value,
+                          "mpmc_queue<T> requires a noexcept move constructor when construction may throw");
+            value_type tmp(mystl::forward<Args>(args)...);
+            return emplace_aux(m_true_type(), mystl::move(tmp));
+        }
+
+    // 自旋直到抢占到槽位：只有抢占成功后参数才会被转发，重试不会用到已被移动的参数
+    template <class T>
+        template <class... Args>
+        void mpmc_queue<T>::emplace_wait(m_true_type, Args&& ...args)
+        {
+            while (!emplace_aux(m_true_type(), mystl::forward<Args>(args)...))
+                std::this_thread::yield();
+        }
+
+    // 临时对象只在自旋前构造一次，每次重试都从它移动
+    template <class T>
+        template <class... Args>
+        void mpmc_queue<T>::emplace_wait(m_false_type, Args&& ...args)
+        {
+            static_assert(std::is_nothrow_move_constructible<T>::value,
+                          "mpmc_queue<T> requires a noexcept move constructor when construction may throw");
+            value_type tmp(mystl::forward<Args>(args)...);
+            while (!emplace_aux(m_true_type(), mystl::move(tmp)))
+                std::this_thread::yield();
+        }
+
+    // 抢占一个可读的槽位并取出元素，队列为空时返回 false
+    template <class T>
+        bool mpmc_queue<T>::try_pop(value_type& value)
+        {
+            cell* c;
+            size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                c = &cells_[pos & mask_];
+                const size_type seq = c->seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+                if (diff == 0)
+                { // 槽位可读，尝试抢占该位置
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                { // 槽位中还没有元素，队列为空
+                    return false;
+                }
+                else
+                { // 其它消费者已抢占该位置
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            value = mystl::move(*c->value());
+            mystl::destroy(c->value());
+            c->seq.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENT_QUEUE_H_
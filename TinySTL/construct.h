@@ -9,6 +9,7 @@
 
 #include "type_traits.h"
 #include "iterator.h"
+#include "util.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -52,6 +53,12 @@ void destroy_one(Ty* pointer, std::false_type)
   }
 }
 
+template <class Ty>
+void destroy(Ty* pointer)
+{
+  destroy_one(pointer, std::is_trivially_destructible<Ty>{});
+}
+
 template <class ForwardIter>
 void destroy_cat(ForwardIter , ForwardIter , std::true_type) {}
 
@@ -59,13 +66,7 @@ template <class ForwardIter>
 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
 {
   for (; first != last; ++first)
-    destroy(&*first);
-}
-
-template <class Ty>
-void destroy(Ty* pointer)
-{
-  destroy_one(pointer, std::is_trivially_destructible<Ty>{});
+    mystl::destroy(&*first);
 }
 
 template <class ForwardIter>
@@ -0,0 +1,1160 @@
+#ifndef MYTINYSTL_DEQUE_H_
+#define MYTINYSTL_DEQUE_H_
+
+// 这个头文件包含了一个模板类 deque
+// deque: 双端队列
+
+// notes:
+//
+// deque 由一个中控器 map 和若干固定大小的缓冲区(block)组成，map 中的每个节点指向一块缓冲区
+// 在首尾插入、删除元素的时间复杂度为 O(1)，且不会移动已有元素
+// 缓冲区大小按页大小(4096 字节)计算，至少容纳 16 个元素
+// 被释放的缓冲区会先放入空闲链表中缓存，再次需要缓冲区时优先复用，避免频繁的 malloc/free
+//
+// 异常保证：
+// mystl::deque<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_back
+//   * push_front
+//   * push_back
+
+#include <initializer_list>
+
+#include "iterator.h"   // 迭代器相关操作
+#include "memory.h"     // 内存相关操作
+#include "util.h"       // 工具函数
+#include "exceptdef.h"  // 异常定义
+
+namespace mystl
+{
+
+#ifndef DEQUE_MAP_INIT_SIZE
+#define DEQUE_MAP_INIT_SIZE 8
+#endif
+
+#ifndef DEQUE_MAX_FREE_BLOCKS
+#define DEQUE_MAX_FREE_BLOCKS 8
+#endif
+
+    // 每块缓冲区的字节数，取一个内存页的大小
+    constexpr static size_t kDequeBlockBytes = 4096;
+
+    // 每块缓冲区能容纳的元素个数，至少为 16 个
+    template <class T>
+        struct deque_buf_size
+        {
+            static constexpr size_t value = sizeof(T) < kDequeBlockBytes / 16
+                ? kDequeBlockBytes / sizeof(T) : 16;
+        };
+
+    // deque 的迭代器设计
+    template <class T, class Ref, class Ptr>
+        struct deque_iterator : public iterator<random_access_iterator_tag, T>
+    {
+        typedef deque_iterator<T, T&, T*>             iterator;        // 迭代器类型
+        typedef deque_iterator<T, const T&, const T*> const_iterator;  // 常量迭代器类型
+        typedef deque_iterator                        self;            // 迭代器自身类型
+
+        typedef T            value_type;       // 值类型
+        typedef Ptr          pointer;          // 指针类型
+        typedef Ref          reference;        // 引用类型
+        typedef size_t       size_type;        // 大小类型
+        typedef ptrdiff_t    difference_type;  // 差值类型
+        typedef T*           value_pointer;    // 指向元素的指针
+        typedef T**          map_pointer;      // 指向中控器节点的指针
+
+        static const size_type buffer_size = deque_buf_size<T>::value;
+
+        value_pointer cur;    // 指向所在缓冲区的当前元素
+        value_pointer first;  // 指向所在缓冲区的头部
+        value_pointer last;   // 指向所在缓冲区的尾部
+        map_pointer   node;   // 缓冲区所在节点
+
+        // 构造、复制、移动函数
+        deque_iterator() noexcept
+            :cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
+
+        deque_iterator(value_pointer v, map_pointer n)
+            :cur(v), first(*n), last(*n + buffer_size), node(n) {}
+
+        deque_iterator(const iterator& rhs)
+            :cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node)
+        {
+        }
+
+        self& operator=(const iterator& rhs)
+        {
+            cur = rhs.cur;
+            first = rhs.first;
+            last = rhs.last;
+            node = rhs.node;
+            return *this;
+        }
+
+        // 转到另一个缓冲区，cur 需要由调用者重新设置
+        void set_node(map_pointer new_node)
+        {
+            node = new_node;
+            first = *new_node;
+            last = first + buffer_size;
+        }
+
+        // 重载运算符
+        reference operator*()  const { return *cur; }
+        pointer   operator->() const { return cur; }
+
+        difference_type operator-(const self& x) const
+        {
+            if (node == x.node)
+                return cur - x.cur;
+            return static_cast<difference_type>(buffer_size) * (node - x.node - 1)
+                + (cur - first) + (x.last - x.cur);
+        }
+
+        self& operator++()
+        {
+            ++cur;
+            if (cur == last)
+            { // 如果到达缓冲区的尾，就跳到下一个缓冲区
+                set_node(node + 1);
+                cur = first;
+            }
+            return *this;
+        }
+        self operator++(int)
+        {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self& operator--()
+        {
+            if (cur == first)
+            { // 如果到达缓冲区的头，就跳到前一个缓冲区的尾
+                set_node(node - 1);
+                cur = last;
+            }
+            --cur;
+            return *this;
+        }
+        self operator--(int)
+        {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        self& operator+=(difference_type n)
+        {
+            const auto offset = n + (cur - first);
+            if (offset >= 0 && offset < static_cast<difference_type>(buffer_size))
+            { // 仍在当前缓冲区
+                cur += n;
+            }
+            else
+            { // 要跳到其他的缓冲区
+                const auto node_offset = offset > 0
+                    ? offset / static_cast<difference_type>(buffer_size)
+                    : -static_cast<difference_type>((-offset - 1) / buffer_size) - 1;
+                set_node(node + node_offset);
+                cur = first + (offset - node_offset * static_cast<difference_type>(buffer_size));
+            }
+            return *this;
+        }
+        self operator+(difference_type n) const
+        {
+            self tmp = *this;
+            return tmp += n;
+        }
+        self& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+        self operator-(difference_type n) const
+        {
+            self tmp = *this;
+            return tmp -= n;
+        }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        // 重载比较操作符
+        bool operator==(const self& rhs) const { return cur == rhs.cur; }
+        bool operator< (const self& rhs) const
+        { return node == rhs.node ? (cur < rhs.cur) : (node < rhs.node); }
+        bool operator!=(const self& rhs) const { return !(*this == rhs); }
+        bool operator> (const self& rhs) const { return rhs < *this; }
+        bool operator<=(const self& rhs) const { return !(rhs < *this); }
+        bool operator>=(const self& rhs) const { return !(*this < rhs); }
+    };
+
+    template <class T, class Ref, class Ptr>
+        const typename deque_iterator<T, Ref, Ptr>::size_type
+        deque_iterator<T, Ref, Ptr>::buffer_size;
+
+    // 模板类 deque
+    // 模板参数 T 代表数据类型
+    template <class T>
+        class deque
+        {
+            public:
+                // deque 的嵌套型别定义
+                typedef mystl::allocator<T>                      allocator_type;  // 分配器类型
+                typedef mystl::allocator<T>                      data_allocator;  // 数据分配器类型
+                typedef mystl::allocator<T*>                     map_allocator;   // 中控器分配器类型
+
+                typedef typename allocator_type::value_type      value_type;       // 数据类型
+                typedef typename allocator_type::pointer         pointer;          // 指针类型
+                typedef typename allocator_type::const_pointer   const_pointer;    // 常量指针类型
+                typedef typename allocator_type::reference       reference;        // 引用类型
+                typedef typename allocator_type::const_reference const_reference;  // 常量引用类型
+                typedef typename allocator_type::size_type       size_type;        // 大小类型
+                typedef typename allocator_type::difference_type difference_type;  // 差值类型
+                typedef pointer*                                 map_pointer;      // 中控器节点指针类型
+
+                typedef deque_iterator<T, T&, T*>                iterator;                // 迭代器类型
+                typedef deque_iterator<T, const T&, const T*>    const_iterator;          // 常量迭代器类型
+                typedef mystl::reverse_iterator<iterator>        reverse_iterator;        // 反向迭代器类型
+                typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;  // 常量反向迭代器类型
+
+                allocator_type get_allocator() { return allocator_type(); }  // 获取分配器实例
+
+                static const size_type buffer_size = deque_buf_size<T>::value;  // 每块缓冲区容纳的元素个数
+
+            private:
+                iterator    begin_;       // 指向第一个元素
+                iterator    end_;         // 指向最后一个元素的下一位置
+                map_pointer map_;         // 指向中控器
+                size_type   map_size_;    // 中控器中节点的个数
+                pointer     free_list_;   // 空闲缓冲区链表，缓冲区头部存放下一块空闲缓冲区的地址
+                size_type   free_count_;  // 空闲缓冲区的个数
+
+            public:
+                // 构造、复制、移动、析构函数
+                deque()
+                { map_init(0); }  // 默认构造函数，创建一个空的 deque
+
+                explicit deque(size_type n)
+                { fill_init(n, value_type()); }  // 创建一个包含 n 个默认值的 deque
+
+                deque(size_type n, const value_type& value)
+                { fill_init(n, value); }  // 创建一个包含 n 个指定值的 deque
+
+                template <class IIter, typename std::enable_if<
+                    mystl::is_input_iterator<IIter>::value, int>::type = 0>
+                    deque(IIter first, IIter last)
+                    { copy_init(first, last, iterator_category(first)); }  // 根据迭代器范围 [first, last) 构造
+
+                deque(std::initializer_list<value_type> ilist)
+                { copy_init(ilist.begin(), ilist.end(), mystl::forward_iterator_tag()); }  // 根据初始化列表构造
+
+                deque(const deque& rhs)
+                { copy_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag()); }  // 拷贝构造函数
+
+                deque(deque&& rhs)
+                    :deque()
+                { swap(rhs); }  // 移动构造函数，rhs 换得一个新的空中控器，之后仍可正常使用
+
+                deque& operator=(const deque& rhs);
+
+                deque& operator=(deque&& rhs)
+                {
+                    clear();
+                    swap(rhs);
+                    return *this;
+                }  // 移动赋值运算符
+
+                deque& operator=(std::initializer_list<value_type> ilist)
+                {
+                    deque tmp(ilist);
+                    swap(tmp);
+                    return *this;
+                }  // 赋值初始化列表
+
+                ~deque()
+                {
+                    if (map_ != nullptr)
+                    {
+                        clear();
+                        map_release();
+                    }
+                }  // 析构函数
+
+            public:
+                // 迭代器相关操作
+                iterator               begin()         noexcept
+                { return begin_; }  // 返回起始迭代器
+
+                const_iterator         begin()   const noexcept
+                { return begin_; }  // 返回常量起始迭代器
+
+                iterator               end()           noexcept
+                { return end_; }  // 返回结束迭代器
+
+                const_iterator         end()     const noexcept
+                { return end_; }  // 返回常量结束迭代器
+
+                reverse_iterator       rbegin()        noexcept
+                { return reverse_iterator(end()); }  // 返回反向起始迭代器
+
+                const_reverse_iterator rbegin()  const noexcept
+                { return const_reverse_iterator(end()); }  // 返回常量反向起始迭代器
+
+                reverse_iterator       rend()          noexcept
+                { return reverse_iterator(begin()); }  // 返回反向结束迭代器
+
+                const_reverse_iterator rend()    const noexcept
+                { return const_reverse_iterator(begin()); }  // 返回常量反向结束迭代器
+
+                const_iterator         cbegin()  const noexcept
+                { return begin(); }  // 返回常量起始迭代器
+
+                const_iterator         cend()    const noexcept
+                { return end(); }  // 返回常量结束迭代器
+
+                const_reverse_iterator crbegin() const noexcept
+                { return rbegin(); }  // 返回常量反向起始迭代器
+
+                const_reverse_iterator crend()   const noexcept
+                { return rend(); }  // 返回常量反向结束迭代器
+
+                // 容量相关操作
+                bool      empty()    const noexcept
+                { return begin_ == end_; }  // 判断 deque 是否为空
+
+                size_type size()     const noexcept
+                { return static_cast<size_type>(end_ - begin_); }  // 返回元素个数
+
+                size_type max_size() const noexcept
+                { return static_cast<size_type>(-1) / sizeof(T); }  // 返回最大容量
+
+                void      resize(size_type new_size) { resize(new_size, value_type()); }
+                void      resize(size_type new_size, const value_type& value);
+
+                // 释放空闲链表中缓存的缓冲区
+                void      shrink_to_fit() noexcept;
+
+                // 访问元素相关操作
+                reference       operator[](size_type n)
+                {
+                    MYSTL_DEBUG(n < size());
+                    return begin_[static_cast<difference_type>(n)];
+                }
+                const_reference operator[](size_type n) const
+                {
+                    MYSTL_DEBUG(n < size());
+                    return begin_[static_cast<difference_type>(n)];
+                }
+
+                reference       at(size_type n)
+                {
+                    THROW_OUT_OF_RANGE_IF(!(n < size()), "deque<T>::at() subscript out of range");
+                    return (*this)[n];
+                }
+                const_reference at(size_type n) const
+                {
+                    THROW_OUT_OF_RANGE_IF(!(n < size()), "deque<T>::at() subscript out of range");
+                    return (*this)[n];
+                }
+
+                reference       front()
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *begin();
+                }  // 返回首元素的引用
+                const_reference front() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *begin();
+                }  // 返回首元素的常量引用
+                reference       back()
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *(end() - 1);
+                }  // 返回尾元素的引用
+                const_reference back() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return *(end() - 1);
+                }  // 返回尾元素的常量引用
+
+                // 调整容器相关操作
+
+                // assign
+
+                void     assign(size_type n, const value_type& value)
+                { fill_assign(n, value); }  // 分配指定大小，全部赋值为 value
+
+                template <class IIter, typename std::enable_if<
+                    mystl::is_input_iterator<IIter>::value, int>::type = 0>
+                    void     assign(IIter first, IIter last)
+                    { copy_assign(first, last, iterator_category(first)); }  // 根据迭代器范围赋值
+
+                void     assign(std::initializer_list<value_type> ilist)
+                { copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{}); }  // 根据初始化列表赋值
+
+                // emplace_front / emplace_back / emplace
+
+                template <class ...Args>
+                    void     emplace_front(Args&& ...args);
+                template <class ...Args>
+                    void     emplace_back(Args&& ...args);
+                template <class ...Args>
+                    iterator emplace(iterator pos, Args&& ...args);
+
+                // push_front / push_back
+
+                void     push_front(const value_type& value) { emplace_front(value); }
+                void     push_back(const value_type& value)  { emplace_back(value); }
+                void     push_front(value_type&& value)      { emplace_front(mystl::move(value)); }
+                void     push_back(value_type&& value)       { emplace_back(mystl::move(value)); }
+
+                // pop_back / pop_front
+
+                void     pop_front();
+                void     pop_back();
+
+                // insert
+
+                iterator insert(iterator position, const value_type& value)
+                { return emplace(position, value); }
+                iterator insert(iterator position, value_type&& value)
+                { return emplace(position, mystl::move(value)); }
+                void     insert(iterator position, size_type n, const value_type& value);
+                template <class IIter, typename std::enable_if<
+                    mystl::is_input_iterator<IIter>::value, int>::type = 0>
+                    void     insert(iterator position, IIter first, IIter last)
+                    { insert_dispatch(position, first, last, iterator_category(first)); }
+
+                // erase /clear
+
+                iterator erase(iterator position);
+                iterator erase(iterator first, iterator last);
+                void     clear();
+
+                // swap
+
+                void     swap(deque& rhs) noexcept;
+
+            private:
+                // helper functions
+
+                // 缓冲区的分配与回收
+                pointer  allocate_block();
+                void     release_block(pointer block) noexcept;
+                void     create_blocks(map_pointer nstart, map_pointer nfinish);
+                void     destroy_blocks(map_pointer nstart, map_pointer nfinish) noexcept;
+
+                // 初始化与释放
+                void     map_init(size_type n_elem);
+                void     map_release() noexcept;
+                void     fill_init(size_type n, const value_type& value);
+                template <class IIter>
+                    void     copy_init(IIter first, IIter last, input_iterator_tag);
+                template <class FIter>
+                    void     copy_init(FIter first, FIter last, forward_iterator_tag);
+
+                // 赋值
+                void     fill_assign(size_type n, const value_type& value);
+                template <class IIter>
+                    void     copy_assign(IIter first, IIter last, input_iterator_tag);
+                template <class FIter>
+                    void     copy_assign(FIter first, FIter last, forward_iterator_tag);
+
+                // 插入
+                template <class IIter>
+                    void     insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag);
+                template <class FIter>
+                    void     insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag);
+                void     rotate_range(iterator first, iterator middle, iterator last);
+                void     reverse_range(iterator first, iterator last);
+
+                // 中控器的扩充
+                void     reserve_map_at_back(size_type nodes_to_add = 1);
+                void     reserve_map_at_front(size_type nodes_to_add = 1);
+                void     reallocate_map(size_type nodes_to_add, bool add_at_front);
+        };
+
+    /*****************************************************************************************/
+
+    template <class T>
+        const typename deque<T>::size_type deque<T>::buffer_size;
+
+    // 复制赋值运算符
+    template <class T>
+        deque<T>& deque<T>::operator=(const deque& rhs)
+        {
+            if (this != &rhs)
+            {
+                const auto len = size();
+                if (len >= rhs.size())
+                {
+                    erase(mystl::copy(rhs.begin(), rhs.end(), begin_), end_);
+                }
+                else
+                {
+                    const_iterator mid = rhs.begin() + static_cast<difference_type>(len);
+                    mystl::copy(rhs.begin(), mid, begin_);
+                    insert(end_, mid, rhs.end());
+                }
+            }
+            return *this;
+        }
+
+    // 重置容器大小
+    template <class T>
+        void deque<T>::resize(size_type new_size, const value_type& value)
+        {
+            const auto len = size();
+            if (new_size < len)
+            {
+                erase(begin_ + new_size, end_);
+            }
+            else
+            {
+                insert(end_, new_size - len, value);
+            }
+        }
+
+    // 释放空闲链表中缓存的缓冲区
+    template <class T>
+        void deque<T>::shrink_to_fit() noexcept
+        {
+            while (free_list_ != nullptr)
+            {
+                pointer next = *reinterpret_cast<pointer*>(free_list_);
+                data_allocator::deallocate(free_list_, buffer_size);
+                free_list_ = next;
+            }
+            free_count_ = 0;
+        }
+
+    // 在头部就地构建元素
+    template <class T>
+        template <class ...Args>
+        void deque<T>::emplace_front(Args&& ...args)
+        {
+            if (begin_.cur != begin_.first)
+            {
+                data_allocator::construct(begin_.cur - 1, mystl::forward<Args>(args)...);
+                --begin_.cur;
+            }
+            else
+            { // 当前缓冲区已满，需要一块新的缓冲区
+                reserve_map_at_front();
+                *(begin_.node - 1) = allocate_block();
+                try
+                {
+                    data_allocator::construct(*(begin_.node - 1) + (buffer_size - 1),
+                            mystl::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    release_block(*(begin_.node - 1));
+                    throw;
+                }
+                begin_.set_node(begin_.node - 1);
+                begin_.cur = begin_.last - 1;
+            }
+        }
+
+    // 在尾部就地构建元素
+    template <class T>
+        template <class ...Args>
+        void deque<T>::emplace_back(Args&& ...args)
+        {
+            if (end_.cur != end_.last - 1)
+            {
+                data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+                ++end_.cur;
+            }
+            else
+            { // 当前缓冲区只剩一个位置，构造后 end_ 需要指向一块新的缓冲区
+                reserve_map_at_back();
+                *(end_.node + 1) = allocate_block();
+                try
+                {
+                    data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    release_block(*(end_.node + 1));
+                    throw;
+                }
+                end_.set_node(end_.node + 1);
+                end_.cur = end_.first;
+            }
+        }
+
+    // 在 pos 位置就地构建元素
+    template <class T>
+        template <class ...Args>
+        typename deque<T>::iterator
+        deque<T>::emplace(iterator pos, Args&& ...args)
+        {
+            if (pos.cur == begin_.cur)
+            {
+                emplace_front(mystl::forward<Args>(args)...);
+                return begin_;
+            }
+            else if (pos.cur == end_.cur)
+            {
+                emplace_back(mystl::forward<Args>(args)...);
+                return end_ - 1;
+            }
+            value_type value_copy(mystl::forward<Args>(args)...);
+            const difference_type elems_before = pos - begin_;
+            if (static_cast<size_type>(elems_before) < size() / 2)
+            { // 插入点之前的元素较少，将它们向前移动一位
+                emplace_front(mystl::move(front()));
+                pos = begin_ + elems_before;
+                mystl::move(begin_ + 2, pos + 1, begin_ + 1);
+            }
+            else
+            { // 插入点之后的元素较少，将它们向后移动一位
+                emplace_back(mystl::move(back()));
+                pos = begin_ + elems_before;
+                mystl::move_backward(pos, end_ - 2, end_ - 1);
+            }
+            *pos = mystl::move(value_copy);
+            return pos;
+        }
+
+    // 弹出头部元素
+    template <class T>
+        void deque<T>::pop_front()
+        {
+            MYSTL_DEBUG(!empty());
+            if (begin_.cur != begin_.last - 1)
+            {
+                data_allocator::destroy(begin_.cur);
+                ++begin_.cur;
+            }
+            else
+            { // 弹出的是缓冲区中最后一个元素，回收该缓冲区
+                data_allocator::destroy(begin_.cur);
+                release_block(begin_.first);
+                begin_.set_node(begin_.node + 1);
+                begin_.cur = begin_.first;
+            }
+        }
+
+    // 弹出尾部元素
+    template <class T>
+        void deque<T>::pop_back()
+        {
+            MYSTL_DEBUG(!empty());
+            if (end_.cur != end_.first)
+            {
+                --end_.cur;
+                data_allocator::destroy(end_.cur);
+            }
+            else
+            { // end_ 所在的缓冲区为空，回收该缓冲区
+                release_block(end_.first);
+                end_.set_node(end_.node - 1);
+                end_.cur = end_.last - 1;
+                data_allocator::destroy(end_.cur);
+            }
+        }
+
+    // 在 position 处插入 n 个元素
+    template <class T>
+        void deque<T>::insert(iterator position, size_type n, const value_type& value)
+        {
+            if (n == 0)
+                return;
+            const value_type value_copy = value;
+            const difference_type elems_before = position - begin_;
+            if (static_cast<size_type>(elems_before) < size() / 2)
+            { // 在头部放入新元素，再轮转到插入点
+                for (size_type i = 0; i < n; ++i)
+                    emplace_front(value_copy);
+                rotate_range(begin_, begin_ + n, begin_ + (n + elems_before));
+            }
+            else
+            { // 在尾部放入新元素，再轮转到插入点
+                const difference_type old_size = static_cast<difference_type>(size());
+                for (size_type i = 0; i < n; ++i)
+                    emplace_back(value_copy);
+                rotate_range(begin_ + elems_before, begin_ + old_size, end_);
+            }
+        }
+
+    // 删除 position 处的元素
+    template <class T>
+        typename deque<T>::iterator
+        deque<T>::erase(iterator position)
+        {
+            MYSTL_DEBUG(position != end_);
+            auto next = position;
+            ++next;
+            const difference_type elems_before = position - begin_;
+            if (static_cast<size_type>(elems_before) < (size() / 2))
+            { // 前面的元素较少，将前面的元素后移
+                mystl::move_backward(begin_, position, next);
+                pop_front();
+            }
+            else
+            { // 后面的元素较少，将后面的元素前移
+                mystl::move(next, end_, position);
+                pop_back();
+            }
+            return begin_ + elems_before;
+        }
+
+    // 删除 [first, last) 上的元素
+    template <class T>
+        typename deque<T>::iterator
+        deque<T>::erase(iterator first, iterator last)
+        {
+            if (first == last)
+            {
+                return first;
+            }
+            if (first == begin_ && last == end_)
+            {
+                clear();
+                return end_;
+            }
+            const difference_type len = last - first;
+            const difference_type elems_before = first - begin_;
+            if (static_cast<size_type>(elems_before) < ((size() - len) / 2))
+            { // 前面的元素较少，将前面的元素后移
+                mystl::move_backward(begin_, first, last);
+                auto new_begin = begin_ + len;
+                mystl::destroy(begin_, new_begin);
+                destroy_blocks(begin_.node, new_begin.node);
+                begin_ = new_begin;
+            }
+            else
+            { // 后面的元素较少，将后面的元素前移
+                mystl::move(last, end_, first);
+                auto new_end = end_ - len;
+                mystl::destroy(new_end, end_);
+                destroy_blocks(new_end.node + 1, end_.node + 1);
+                end_ = new_end;
+            }
+            return begin_ + elems_before;
+        }
+
+    // 清空 deque，保留头部的一块缓冲区
+    template <class T>
+        void deque<T>::clear()
+        {
+            if (map_ == nullptr)
+                return;
+            for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur)
+            {
+                data_allocator::destroy(*cur, *cur + buffer_size);
+            }
+            if (begin_.node != end_.node)
+            { // 有两个以上的缓冲区
+                data_allocator::destroy(begin_.cur, begin_.last);
+                data_allocator::destroy(end_.first, end_.cur);
+            }
+            else
+            {
+                data_allocator::destroy(begin_.cur, end_.cur);
+            }
+            destroy_blocks(begin_.node + 1, end_.node + 1);
+            end_ = begin_;
+        }
+
+    // 交换两个 deque
+    template <class T>
+        void deque<T>::swap(deque& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                mystl::swap(begin_, rhs.begin_);
+                mystl::swap(end_, rhs.end_);
+                mystl::swap(map_, rhs.map_);
+                mystl::swap(map_size_, rhs.map_size_);
+                mystl::swap(free_list_, rhs.free_list_);
+                mystl::swap(free_count_, rhs.free_count_);
+            }
+        }
+
+    /*****************************************************************************************/
+    // helper function
+
+    // 取得一块缓冲区，优先从空闲链表中复用
+    template <class T>
+        typename deque<T>::pointer
+        deque<T>::allocate_block()
+        {
+            if (free_list_ != nullptr)
+            {
+                pointer block = free_list_;
+                free_list_ = *reinterpret_cast<pointer*>(block);
+                --free_count_;
+                return block;
+            }
+            return data_allocator::allocate(buffer_size);
+        }
+
+    // 回收一块缓冲区，空闲链表未满时缓存起来，否则归还给分配器
+    template <class T>
+        void deque<T>::release_block(pointer block) noexcept
+        {
+            if (free_count_ < DEQUE_MAX_FREE_BLOCKS)
+            {
+                *reinterpret_cast<pointer*>(block) = free_list_;
+                free_list_ = block;
+                ++free_count_;
+            }
+            else
+            {
+                data_allocator::deallocate(block, buffer_size);
+            }
+        }
+
+    // 为 [nstart, nfinish] 上的节点配置缓冲区
+    template <class T>
+        void deque<T>::create_blocks(map_pointer nstart, map_pointer nfinish)
+        {
+            map_pointer cur;
+            try
+            {
+                for (cur = nstart; cur <= nfinish; ++cur)
+                {
+                    *cur = allocate_block();
+                }
+            }
+            catch (...)
+            {
+                while (cur != nstart)
+                {
+                    --cur;
+                    release_block(*cur);
+                    *cur = nullptr;
+                }
+                throw;
+            }
+        }
+
+    // 回收 [nstart, nfinish) 上节点的缓冲区
+    template <class T>
+        void deque<T>::destroy_blocks(map_pointer nstart, map_pointer nfinish) noexcept
+        {
+            for (map_pointer n = nstart; n < nfinish; ++n)
+            {
+                release_block(*n);
+                *n = nullptr;
+            }
+        }
+
+    // 初始化中控器及缓冲区，使之能容纳 n_elem 个元素
+    template <class T>
+        void deque<T>::map_init(size_type n_elem)
+        {
+            const size_type n_node = n_elem / buffer_size + 1;  // 需要的缓冲区个数
+            map_size_ = mystl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE), n_node + 2);
+            map_ = map_allocator::allocate(map_size_);
+            free_list_ = nullptr;
+            free_count_ = 0;
+
+            // 让 nstart 与 nfinish 都指向 map_ 最中央的区域，方便向头尾扩充
+            map_pointer nstart = map_ + (map_size_ - n_node) / 2;
+            map_pointer nfinish = nstart + n_node - 1;
+            try
+            {
+                create_blocks(nstart, nfinish);
+            }
+            catch (...)
+            {
+                map_allocator::deallocate(map_, map_size_);
+                map_ = nullptr;
+                map_size_ = 0;
+                throw;
+            }
+            begin_.set_node(nstart);
+            end_.set_node(nfinish);
+            begin_.cur = begin_.first;
+            end_.cur = end_.first + (n_elem % buffer_size);
+        }
+
+    // 回收 [begin_.node, end_.node] 上的缓冲区及中控器，不析构元素
+    template <class T>
+        void deque<T>::map_release() noexcept
+        {
+            destroy_blocks(begin_.node, end_.node + 1);
+            shrink_to_fit();
+            map_allocator::deallocate(map_, map_size_);
+            begin_ = end_ = iterator();
+            map_ = nullptr;
+            map_size_ = 0;
+        }
+
+    template <class T>
+        void deque<T>::fill_init(size_type n, const value_type& value)
+        {
+            map_init(n);
+            if (n != 0)
+            {
+                map_pointer cur = begin_.node;
+                try
+                {
+                    for (; cur < end_.node; ++cur)
+                    {
+                        mystl::uninitialized_fill(*cur, *cur + buffer_size, value);
+                    }
+                    mystl::uninitialized_fill(end_.first, end_.cur, value);
+                }
+                catch (...)
+                {
+                    for (auto n = begin_.node; n < cur; ++n)
+                        data_allocator::destroy(*n, *n + buffer_size);
+                    map_release();
+                    throw;
+                }
+            }
+        }
+
+    template <class T>
+        template <class IIter>
+        void deque<T>::copy_init(IIter first, IIter last, input_iterator_tag)
+        {
+            map_init(0);
+            try
+            {
+                for (; first != last; ++first)
+                    emplace_back(*first);
+            }
+            catch (...)
+            {
+                this->~deque();
+                throw;
+            }
+        }
+
+    template <class T>
+        template <class FIter>
+        void deque<T>::copy_init(FIter first, FIter last, forward_iterator_tag)
+        {
+            const size_type n = mystl::distance(first, last);
+            map_init(n);
+            map_pointer cur = begin_.node;
+            try
+            {
+                for (; cur < end_.node; ++cur)
+                {
+                    auto next = first;
+                    mystl::advance(next, buffer_size);
+                    mystl::uninitialized_copy(first, next, *cur);
+                    first = next;
+                }
+                mystl::uninitialized_copy(first, last, end_.first);
+            }
+            catch (...)
+            {
+                for (auto node = begin_.node; node < cur; ++node)
+                    data_allocator::destroy(*node, *node + buffer_size);
+                map_release();
+                throw;
+            }
+        }
+
+    template <class T>
+        void deque<T>::fill_assign(size_type n, const value_type& value)
+        {
+            if (n > size())
+            {
+                mystl::fill(begin(), end(), value);
+                insert(end(), n - size(), value);
+            }
+            else
+            {
+                erase(begin() + n, end());
+                mystl::fill(begin(), end(), value);
+            }
+        }
+
+    template <class T>
+        template <class IIter>
+        void deque<T>::copy_assign(IIter first, IIter last, input_iterator_tag)
+        {
+            auto first1 = begin();
+            auto last1 = end();
+            for (; first != last && first1 != last1; ++first, ++first1)
+            {
+                *first1 = *first;
+            }
+            if (first1 != last1)
+            {
+                erase(first1, last1);
+            }
+            else
+            {
+                insert_dispatch(end_, first, last, input_iterator_tag{});
+            }
+        }
+
+    template <class T>
+        template <class FIter>
+        void deque<T>::copy_assign(FIter first, FIter last, forward_iterator_tag)
+        {
+            const size_type len1 = size();
+            const size_type len2 = mystl::distance(first, last);
+            if (len1 < len2)
+            {
+                auto next = first;
+                mystl::advance(next, len1);
+                mystl::copy(first, next, begin_);
+                insert_dispatch(end_, next, last, forward_iterator_tag{});
+            }
+            else
+            {
+                erase(mystl::copy(first, last, begin_), end_);
+            }
+        }
+
+    template <class T>
+        template <class IIter>
+        void deque<T>::insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag)
+        {
+            // 输入迭代器只能遍历一次，先全部放到尾部，再轮转到插入点
+            const difference_type elems_before = position - begin_;
+            const difference_type old_size = static_cast<difference_type>(size());
+            for (; first != last; ++first)
+                emplace_back(*first);
+            rotate_range(begin_ + elems_before, begin_ + old_size, end_);
+        }
+
+    template <class T>
+        template <class FIter>
+        void deque<T>::insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag)
+        {
+            if (first == last)
+                return;
+            const difference_type elems_before = position - begin_;
+            if (static_cast<size_type>(elems_before) < size() / 2)
+            { // 逆序放入头部，翻转后再轮转到插入点
+                size_type n = 0;
+                for (; first != last; ++first, ++n)
+                    emplace_front(*first);
+                reverse_range(begin_, begin_ + n);
+                rotate_range(begin_, begin_ + n, begin_ + (n + elems_before));
+            }
+            else
+            {
+                insert_dispatch(position, first, last, input_iterator_tag{});
+            }
+        }
+
+    // 轮转 [first, last) 使 middle 成为新的首元素
+    template <class T>
+        void deque<T>::rotate_range(iterator first, iterator middle, iterator last)
+        {
+            if (first == middle || middle == last)
+                return;
+            reverse_range(first, middle);
+            reverse_range(middle, last);
+            reverse_range(first, last);
+        }
+
+    template <class T>
+        void deque<T>::reverse_range(iterator first, iterator last)
+        {
+            while (first != last && first != --last)
+            {
+                mystl::iter_swap(first, last);
+                ++first;
+            }
+        }
+
+    template <class T>
+        void deque<T>::reserve_map_at_back(size_type nodes_to_add)
+        {
+            if (nodes_to_add + 1 > map_size_ - static_cast<size_type>(end_.node - map_))
+                reallocate_map(nodes_to_add, false);
+        }
+
+    template <class T>
+        void deque<T>::reserve_map_at_front(size_type nodes_to_add)
+        {
+            if (nodes_to_add > static_cast<size_type>(begin_.node - map_))
+                reallocate_map(nodes_to_add, true);
+        }
+
+    // 中控器空间不足时，若 map_ 中还有足够的剩余空间则将已用节点居中，否则配置一块更大的 map
+    template <class T>
+        void deque<T>::reallocate_map(size_type nodes_to_add, bool add_at_front)
+        {
+            const size_type old_num_nodes = end_.node - begin_.node + 1;
+            const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+
+            map_pointer new_nstart;
+            if (map_size_ > 2 * new_num_nodes)
+            { // 例如 FIFO 队列只在尾部增长、头部回收，此时只需要平移节点
+                new_nstart = map_ + (map_size_ - new_num_nodes) / 2
+                    + (add_at_front ? nodes_to_add : 0);
+                if (new_nstart < begin_.node)
+                    mystl::copy(begin_.node, end_.node + 1, new_nstart);
+                else
+                    mystl::copy_backward(begin_.node, end_.node + 1, new_nstart + old_num_nodes);
+            }
+            else
+            {
+                const size_type new_map_size = map_size_ + mystl::max(map_size_, nodes_to_add) + 2;
+                map_pointer new_map = map_allocator::allocate(new_map_size);
+                new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+                    + (add_at_front ? nodes_to_add : 0);
+                mystl::copy(begin_.node, end_.node + 1, new_nstart);
+                map_allocator::deallocate(map_, map_size_);
+                map_ = new_map;
+                map_size_ = new_map_size;
+            }
+            begin_.set_node(new_nstart);
+            end_.set_node(new_nstart + old_num_nodes - 1);
+        }
+
+    // 重载比较操作符
+    template <class T>
+        bool operator==(const deque<T>& lhs, const deque<T>& rhs)
+        {
+            return lhs.size() == rhs.size() &&
+                mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+    template <class T>
+        bool operator<(const deque<T>& lhs, const deque<T>& rhs)
+        {
+            return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    template <class T>
+        bool operator!=(const deque<T>& lhs, const deque<T>& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class T>
+        bool operator>(const deque<T>& lhs, const deque<T>& rhs)
+        {
+            return rhs < lhs;
+        }
+
+    template <class T>
+        bool operator<=(const deque<T>& lhs, const deque<T>& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class T>
+        bool operator>=(const deque<T>& lhs, const deque<T>& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    // 重载 mystl 的 swap
+    template <class T>
+        void swap(deque<T>& lhs, deque<T>& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_DEQUE_H_
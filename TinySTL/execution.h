@@ -0,0 +1,89 @@
+#ifndef MYTINYSTL_EXECUTION_H_
+#define MYTINYSTL_EXECUTION_H_
+
+// 这个头文件包含了并行算法使用的执行策略
+// seq:       串行执行
+// par:       在线程池中并行执行
+// par_unseq: 在线程池中并行执行，并允许向量化
+// unseq:     串行执行，并允许向量化
+
+// notes:
+//
+// par 与 par_unseq 默认使用 thread_pool::default_pool()，可以用 on(pool) 指定线程池，例如
+//   mystl::sort(mystl::execution::par.on(pool), v.begin(), v.end());
+// parallel_unsequenced_policy 派生自 parallel_policy，未单独提供实现的算法按 par 执行
+// unseq 与 par_unseq 允许算法改变运算的结合顺序，例如 reduce 使用多个累加器并行累加，
+// 浮点数的结果可能与从左到右依次计算的结果略有不同
+
+#include <type_traits>
+
+#include "thread_pool.h"
+
+namespace mystl
+{
+    namespace execution
+    {
+
+        // 串行执行策略
+        class sequenced_policy
+        {
+        };
+
+        // 串行执行且允许向量化的执行策略
+        class unsequenced_policy
+        {
+        };
+
+        // 并行执行策略
+        class parallel_policy
+        {
+            private:
+                thread_pool* pool_;  // 使用的线程池，为空时使用默认线程池
+
+            public:
+                constexpr parallel_policy() noexcept : pool_(nullptr) {}
+                explicit constexpr parallel_policy(thread_pool& pool) noexcept : pool_(&pool) {}
+
+                parallel_policy on(thread_pool& pool) const noexcept { return parallel_policy(pool); }
+
+                thread_pool& pool() const
+                { return pool_ != nullptr ? *pool_ : thread_pool::default_pool(); }
+        };
+
+        // 并行且允许向量化的执行策略
+        class parallel_unsequenced_policy : public parallel_policy
+        {
+            public:
+                constexpr parallel_unsequenced_policy() noexcept : parallel_policy() {}
+                explicit constexpr parallel_unsequenced_policy(thread_pool& pool) noexcept
+                    : parallel_policy(pool) {}
+
+                parallel_unsequenced_policy on(thread_pool& pool) const noexcept
+                { return parallel_unsequenced_policy(pool); }
+        };
+
+        constexpr sequenced_policy            seq{};
+        constexpr unsequenced_policy          unseq{};
+        constexpr parallel_policy             par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+
+    } // namespace execution
+
+    // 判断 T 是否为执行策略
+    template <class T>
+        struct is_execution_policy : public m_false_type {};
+
+    template <>
+        struct is_execution_policy<execution::sequenced_policy> : public m_true_type {};
+
+    template <>
+        struct is_execution_policy<execution::unsequenced_policy> : public m_true_type {};
+
+    template <>
+        struct is_execution_policy<execution::parallel_policy> : public m_true_type {};
+
+    template <>
+        struct is_execution_policy<execution::parallel_unsequenced_policy> : public m_true_type {};
+
+} // namespace mystl
+#endif // !MYTINYSTL_EXECUTION_H_
@@ -0,0 +1,190 @@
+#ifndef MYTINYSTL_EYTZINGER_H_
+#define MYTINYSTL_EYTZINGER_H_
+
+// 这个头文件包含一个类模板 eytzinger_index
+// 把有序序列按完全二叉树的层序(Eytzinger 布局)重新排列，用于静态有序表上的大量点查询
+
+// notes:
+//
+// 层序布局中下标 k 的左右孩子为 2k 与 2k + 1，查找路径上前几层的元素集中在数组开头，
+// 总是留在缓存中；每次比较后以 k = 2k + (data[k] < value) 下降，没有难以预测的分支，
+// 并提前预取若干层之后的孩子所在的缓存行，大数组上通常比 lower_bound 快 2 到 4 倍
+// 查找返回指向层序数组中元素的迭代器，没有找到时返回 end()，需要名次时调用 rank(pos)
+// 构造后内容不可修改，修改有序表后需要重新构造
+
+#include <cstddef>
+#include <cstdint>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+
+namespace mystl
+{
+
+    // 模板类 eytzinger_index
+    // 参数一代表元素类型，参数二代表比较方式，缺省使用 mystl::less
+    template <class T, class Compared = mystl::less<T>>
+        class eytzinger_index
+        {
+            public:
+                typedef T           value_type;
+                typedef const T*    const_iterator;
+                typedef const T&    const_reference;
+                typedef size_t      size_type;
+                typedef Compared    value_compare;
+
+            private:
+                mystl::vector<T>         data_;  // 层序排列的元素，下标从 1 开始，data_[0] 不使用
+                mystl::vector<size_type> rank_;  // 每个位置上的元素在原有序序列中的名次
+                Compared                 comp_;
+
+            public:
+                // 构造函数，[first, last) 必须已按 comp 排好序
+                eytzinger_index() = default;
+
+                template <class RandomIter>
+                    eytzinger_index(RandomIter first, RandomIter last, Compared comp = Compared())
+                    :comp_(comp)
+                    {
+                        build(first, last);
+                    }
+
+                explicit eytzinger_index(const mystl::vector<T>& sorted, Compared comp = Compared())
+                    :comp_(comp)
+                {
+                    build(sorted.begin(), sorted.end());
+                }
+
+            public:
+                // 按层序遍历所有元素
+                const_iterator begin() const noexcept { return data_.empty() ? nullptr : data_.begin() + 1; }
+                const_iterator end()   const noexcept { return data_.empty() ? nullptr : data_.end(); }
+
+                size_type size()  const noexcept { return rank_.empty() ? 0 : rank_.size() - 1; }
+                bool      empty() const noexcept { return size() == 0; }
+
+                // 返回名次为 r 的元素
+                const_reference operator[](size_type r) const { return data_[position_of(r)]; }
+
+                // 返回 pos 指向的元素在原有序序列中的名次，pos 为 end() 时返回 size()
+                // 名次保存在单独的数组中，需要额外的一次访存，只在需要时调用
+                size_type rank(const_iterator pos) const
+                { return pos == end() ? size() : rank_[pos - data_.begin()]; }
+
+                // 返回指向第一个不小于 value 的元素的迭代器，没有时返回 end()
+                const_iterator lower_bound(const T& value) const
+                {
+                    return at(descend(value, [this](const T& x, const T& v)
+                                             { return comp_(x, v); }));
+                }
+
+                // 返回指向第一个大于 value 的元素的迭代器，没有时返回 end()
+                const_iterator upper_bound(const T& value) const
+                {
+                    return at(descend(value, [this](const T& x, const T& v)
+                                             { return !comp_(v, x); }));
+                }
+
+                // 返回指向等于 value 的元素的迭代器，没有时返回 end()
+                const_iterator find(const T& value) const
+                {
+                    const size_type k = descend(value, [this](const T& x, const T& v)
+                                                       { return comp_(x, v); });
+                    return k != 0 && !comp_(value, data_[k]) ? data_.begin() + k : end();
+                }
+
+                bool contains(const T& value) const { return find(value) != end(); }
+
+            private:
+                template <class RandomIter>
+                    void build(RandomIter first, RandomIter last);
+
+                template <class RandomIter>
+                    size_type build_aux(RandomIter first, size_type i, size_type k);
+
+                // 沿着 go_right(data_[k], value) 为真时向右的路径下降到叶子之下，
+                // 返回最后一次向左时所在的位置，即第一个使 go_right 为假的元素，不存在时返回 0
+                template <class GoRight>
+                    size_type descend(const T& value, GoRight go_right) const
+                    {
+                        const size_type n = size();
+                        // 一个缓存行能容纳的元素个数，预取 k 的这么多层之后的后代
+                        const size_type block = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+                        // 预取的地址可能越过数组末尾，以整数计算地址，prefetch 不会因此出错
+                        const T* data = data_.begin();
+                        const uintptr_t base = reinterpret_cast<uintptr_t>(data);
+                        size_type k = 1;
+                        while (k <= n)
+                        {
+                            mystl::prefetch_read(reinterpret_cast<const void*>(
+                                base + k * block * sizeof(T)));
+                            k = 2 * k + static_cast<size_type>(go_right(data[k], value));
+                        }
+                        // 去掉末尾连续的 1(向右的步骤)以及之前的一个 0(最后一次向左)
+                        return k >> (count_trailing_ones(k) + 1);
+                    }
+
+                const_iterator at(size_type k) const { return k == 0 ? end() : data_.begin() + k; }
+
+                // 名次为 r 的元素在层序中的位置
+                size_type position_of(size_type r) const;
+
+                static unsigned count_trailing_ones(size_type k) noexcept
+                {
+#if defined(__GNUC__)
+                    return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+                    unsigned n = 0;
+                    for (; k & 1; k >>= 1)
+                        ++n;
+                    return n;
+#endif
+                }
+        };
+
+    template <class T, class Compared>
+        template <class RandomIter>
+        void eytzinger_index<T, Compared>::build(RandomIter first, RandomIter last)
+        {
+            data_.clear();
+            rank_.clear();
+            const size_type n = static_cast<size_type>(last - first);
+            if (n == 0)
+                return;
+            data_.reserve(n + 1);
+            for (size_type i = 0; i <= n; ++i)
+                data_.push_back(*first);
+            rank_.assign(n + 1, 0);
+            build_aux(first, 0, 1);
+        }
+
+    // 中序遍历完全二叉树，依次放入有序序列中的元素
+    template <class T, class Compared>
+        template <class RandomIter>
+        typename eytzinger_index<T, Compared>::size_type
+        eytzinger_index<T, Compared>::build_aux(RandomIter first, size_type i, size_type k)
+        {
+            if (k < data_.size())
+            {
+                i = build_aux(first, i, 2 * k);
+                data_[k] = first[i];
+                rank_[k] = i;
+                i = build_aux(first, i + 1, 2 * k + 1);
+            }
+            return i;
+        }
+
+    template <class T, class Compared>
+        typename eytzinger_index<T, Compared>::size_type
+        eytzinger_index<T, Compared>::position_of(size_type r) const
+        {
+            // 在 rank_ 上按名次下降，rank_ 本身就是一棵按名次排好的搜索树
+            size_type k = 1;
+            while (rank_[k] != r)
+                k = 2 * k + static_cast<size_type>(rank_[k] < r);
+            return k;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_EYTZINGER_H_
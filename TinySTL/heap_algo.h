@@ -2,8 +2,14 @@
 #define MYTINYSTL_HEAP_ALGO_H_
 
 // 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及每个节点有 D 个孩子的 d 叉堆版本 : d_ary_push_heap, d_ary_pop_heap, d_ary_sort_heap,
+// d_ary_make_heap, d_ary_is_heap
+
+#include <cstddef>
 
 #include "iterator.h"
+#include "functional.h"
+#include "util.h"
 
 namespace mystl
 {
@@ -222,5 +228,205 @@ void make_heap(RandomIter first, RandomIter last, Compared comp)
   mystl::make_heap_aux(first, last, distance_type(first), comp);
 }
 
+/*****************************************************************************************/
+// d_ary heap
+// 以模板参数 D 指定每个节点的孩子个数，例如 mystl::d_ary_push_heap<4>(first, last)
+// 节点 i 的孩子为 D * i + 1 ~ D * i + D，父节点为 (i - 1) / D，D 为 2 时与二叉堆的布局相同
+// 树高为 log_D(n)，同一节点的孩子在内存中相邻，元素不大时位于同一个或相邻的缓存行中，
+// 下溯时每层多做几次比较，但访问的缓存行少得多，堆很大时 D 取 4 或 8 通常比二叉堆快；
+// 比较的代价很高时(例如比较字符串)，总的比较次数更多，二叉堆可能更合适
+// 下溯采用自底向上的方式：空穴沿较大的孩子一直下降到叶子，再把待放入的元素从叶子上溯，
+// 待放入的元素通常来自堆的尾部、比较小，上溯一两层即停止，省去了每层与它的比较
+/*****************************************************************************************/
+// 从 child 开始的 D 个孩子中最大的一个，D 为常量，循环可以完全展开
+// 这里保留分支：堆很大时，预测的路径可以提前发出下一层的访存，比条件传送更快
+template <size_t D, class RandomIter, class Distance, class Compared>
+Distance d_ary_max_child(RandomIter first, Distance child, Compared comp)
+{
+  Distance best = child;
+  for (size_t i = 1; i < D; ++i)
+  {
+    const Distance c = child + static_cast<Distance>(i);
+    if (comp(*(first + best), *(first + c)))
+      best = c;
+  }
+  return best;
+}
+
+// 最后一个节点的孩子可能不足 D 个
+template <class RandomIter, class Distance, class Compared>
+Distance d_ary_max_child(RandomIter first, Distance child, Distance n, Compared comp)
+{
+  Distance best = child;
+  for (Distance c = child + 1; c < child + n; ++c)
+  {
+    if (comp(*(first + best), *(first + c)))
+      best = c;
+  }
+  return best;
+}
+
+// 把 value 从空穴 holeIndex 上溯，不越过 topIndex
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void d_ary_push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T value,
+                         Compared comp)
+{
+  while (holeIndex > topIndex)
+  {
+    const Distance parent = (holeIndex - 1) / static_cast<Distance>(D);
+    if (!comp(*(first + parent), value))
+      break;
+    *(first + holeIndex) = mystl::move(*(first + parent));
+    holeIndex = parent;
+  }
+  *(first + holeIndex) = mystl::move(value);
+}
+
+// 以 holeIndex 为根的子树中放入 value，[first, first + len) 为整个堆
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void d_ary_adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value,
+                       Compared comp)
+{
+  const Distance topIndex = holeIndex;
+  const Distance d = static_cast<Distance>(D);
+  Distance child = d * holeIndex + 1;
+  while (child < len - d + 1)
+  {  // 孩子齐全的节点
+    child = mystl::d_ary_max_child<D>(first, child, comp);
+    *(first + holeIndex) = mystl::move(*(first + child));
+    holeIndex = child;
+    child = d * holeIndex + 1;
+  }
+  if (child < len)
+  {
+    child = mystl::d_ary_max_child(first, child, len - child, comp);
+    *(first + holeIndex) = mystl::move(*(first + child));
+    holeIndex = child;
+  }
+  mystl::d_ary_push_heap_aux<D>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void d_ary_push_heap_d(RandomIter first, RandomIter last, Compared comp)
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+  if (last - first < 2)
+    return;
+  auto value = mystl::move(*(last - 1));
+  mystl::d_ary_push_heap_aux<D>(first, (last - first) - 1, static_cast<decltype(last - first)>(0),
+                                mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void d_ary_pop_heap_d(RandomIter first, RandomIter last, Compared comp)
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+  if (last - first < 2)
+    return;
+  auto value = mystl::move(*(last - 1));
+  *(last - 1) = mystl::move(*first);
+  mystl::d_ary_adjust_heap<D>(first, static_cast<decltype(last - first)>(0),
+                              (last - first) - 1, mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void d_ary_make_heap_d(RandomIter first, RandomIter last, Compared comp)
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+  const auto len = last - first;
+  if (len < 2)
+    return;
+  // 从最后一个有孩子的节点开始，逐个调整子树
+  for (auto holeIndex = (len - 2) / static_cast<decltype(len)>(D); ; --holeIndex)
+  {
+    auto value = mystl::move(*(first + holeIndex));
+    mystl::d_ary_adjust_heap<D>(first, holeIndex, len, mystl::move(value), comp);
+    if (holeIndex == 0)
+      return;
+  }
+}
+
+template <size_t D, class RandomIter, class Compared>
+bool d_ary_is_heap_d(RandomIter first, RandomIter last, Compared comp)
+{
+  const auto len = last - first;
+  for (decltype(last - first) child = 1; child < len; ++child)
+  {
+    if (comp(*(first + (child - 1) / static_cast<decltype(len)>(D)), *(first + child)))
+      return false;
+  }
+  return true;
+}
+
+// 新元素应该已置于底部容器的最尾端
+template <size_t D, class RandomIter>
+void d_ary_push_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::d_ary_push_heap_d<D>(first, last, mystl::less<value_type>());
+}
+
+// 把根节点放到容器的尾部，[first, last - 1) 重新成为 heap
+template <size_t D, class RandomIter>
+void d_ary_pop_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::d_ary_pop_heap_d<D>(first, last, mystl::less<value_type>());
+}
+
+template <size_t D, class RandomIter>
+void d_ary_sort_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  for (; last - first > 1; --last)
+    mystl::d_ary_pop_heap_d<D>(first, last, mystl::less<value_type>());
+}
+
+template <size_t D, class RandomIter>
+void d_ary_make_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::d_ary_make_heap_d<D>(first, last, mystl::less<value_type>());
+}
+
+template <size_t D, class RandomIter>
+bool d_ary_is_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  return mystl::d_ary_is_heap_d<D>(first, last, mystl::less<value_type>());
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <size_t D, class RandomIter, class Compared>
+void d_ary_push_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::d_ary_push_heap_d<D>(first, last, comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void d_ary_pop_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::d_ary_pop_heap_d<D>(first, last, comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void d_ary_sort_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  for (; last - first > 1; --last)
+    mystl::d_ary_pop_heap_d<D>(first, last, comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void d_ary_make_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::d_ary_make_heap_d<D>(first, last, comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+bool d_ary_is_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  return mystl::d_ary_is_heap_d<D>(first, last, comp);
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_HEAP_ALGO_H_
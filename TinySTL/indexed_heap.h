@@ -0,0 +1,267 @@
+#ifndef MYTINYSTL_INDEXED_HEAP_H_
+#define MYTINYSTL_INDEXED_HEAP_H_
+
+// 这个头文件包含一个类模板 indexed_heap
+// 可寻址的 d 叉堆：push 返回一个句柄，之后可以通过句柄读取、修改或删除对应的元素
+
+// notes:
+//
+// 与 priority_queue 一样，top() 返回按 Compare 最大的元素，最短路径等需要最小堆时使用 mystl::greater
+// 堆数组中保存元素及其句柄，另有一个以句柄为下标的位置表，上溯、下溯移动元素时同步更新位置表，
+// 因此 update / erase 为 O(log n)，不必像 priority_queue 那样重复插入再跳过过期的元素
+// 句柄是小的整数，push(value) 分配的句柄在元素被删除后会被新插入的元素重复使用；
+// 需要以顶点编号等外部编号作为句柄时，使用 push(handle, value)，句柄小于 reserve_handles 的参数即可，
+// 这样的句柄由调用者管理，删除后不会被放入可重复使用的句柄中
+
+#include <cstddef>
+
+#include "functional.h"
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+    // 模板类 indexed_heap
+    // 参数一代表元素类型，参数二代表比较方式，缺省使用 mystl::less，参数三代表每个节点的孩子个数
+    template <class T, class Compared = mystl::less<T>, size_t D = 4>
+        class indexed_heap
+        {
+            public:
+                typedef T           value_type;
+                typedef const T&    const_reference;
+                typedef size_t      size_type;
+                typedef size_t      handle_type;
+                typedef Compared    value_compare;
+
+                static constexpr handle_type npos = static_cast<handle_type>(-1);
+
+            private:
+                struct entry
+                {
+                    T           value;
+                    handle_type handle;
+                };
+
+                mystl::vector<entry>       heap_;  // 按 d 叉堆排列的元素
+                mystl::vector<size_type>   pos_;   // 每个句柄对应的元素在 heap_ 中的位置，未使用时为 npos
+                mystl::vector<char>        issued_;  // 每个句柄是否由 allocate_handle 分配
+                mystl::vector<handle_type> free_;  // 可以重复使用的句柄，每个句柄至多出现一次
+                Compared                   comp_;
+
+            public:
+                // 构造函数
+                indexed_heap() = default;
+
+                explicit indexed_heap(Compared comp)
+                    :comp_(comp)
+                {
+                }
+
+            public:
+                bool      empty() const noexcept { return heap_.empty(); }
+                size_type size()  const noexcept { return heap_.size(); }
+
+                // 最大的元素及其句柄
+                const_reference top()        const { return heap_.front().value; }
+                handle_type     top_handle() const { return heap_.front().handle; }
+
+                // 句柄 h 是否对应堆中的元素
+                bool contains(handle_type h) const noexcept
+                { return h < pos_.size() && pos_[h] != npos; }
+
+                // 句柄 h 对应的元素
+                const_reference operator[](handle_type h) const
+                {
+                    MYSTL_DEBUG(contains(h));
+                    return heap_[pos_[h]].value;
+                }
+
+                // 预先为 [0, n) 中的句柄分配位置表
+                void reserve_handles(size_type n)
+                {
+                    if (pos_.size() < n)
+                    {
+                        pos_.resize(n, npos);
+                        issued_.resize(n, 0);
+                    }
+                }
+
+                void reserve(size_type n) { heap_.reserve(n); }
+
+                // 插入元素，返回它的句柄
+                handle_type push(const value_type& value) { return push_aux(allocate_handle(), value); }
+                handle_type push(value_type&& value)      { return push_aux(allocate_handle(), mystl::move(value)); }
+
+                // 以指定的句柄插入元素，该句柄此时不能对应堆中的元素
+                handle_type push(handle_type h, const value_type& value)
+                {
+                    push_aux(h, value);
+                    issued_[h] = 0;
+                    return h;
+                }
+
+                handle_type push(handle_type h, value_type&& value)
+                {
+                    push_aux(h, mystl::move(value));
+                    issued_[h] = 0;
+                    return h;
+                }
+
+                // 删除最大的元素
+                void pop() { erase(top_handle()); }
+
+                // 把句柄 h 对应的元素改为 value，可以变大或变小
+                void update(handle_type h, const value_type& value)
+                {
+                    MYSTL_DEBUG(contains(h));
+                    const size_type i = pos_[h];
+                    const bool up = comp_(heap_[i].value, value);
+                    heap_[i].value = value;
+                    if (up)
+                        sift_up(i);
+                    else
+                        sift_down(i);
+                }
+
+                // 删除句柄 h 对应的元素，句柄随后可以被重复使用
+                void erase(handle_type h)
+                {
+                    MYSTL_DEBUG(contains(h));
+                    const size_type i = pos_[h];
+                    const size_type last = heap_.size() - 1;
+                    release_handle(h);
+                    if (i != last)
+                    {
+                        heap_[i] = mystl::move(heap_[last]);
+                        pos_[heap_[i].handle] = i;
+                        heap_.pop_back();
+                        if (i > 0 && comp_(heap_[parent(i)].value, heap_[i].value))
+                            sift_up(i);
+                        else
+                            sift_down(i);
+                    }
+                    else
+                    {
+                        heap_.pop_back();
+                    }
+                }
+
+                void clear()
+                {
+                    for (size_type i = 0; i < heap_.size(); ++i)
+                        release_handle(heap_[i].handle);
+                    heap_.clear();
+                }
+
+                void swap(indexed_heap& rhs) noexcept
+                {
+                    heap_.swap(rhs.heap_);
+                    pos_.swap(rhs.pos_);
+                    issued_.swap(rhs.issued_);
+                    free_.swap(rhs.free_);
+                    mystl::swap(comp_, rhs.comp_);
+                }
+
+            private:
+                static size_type parent(size_type i) noexcept { return (i - 1) / D; }
+
+                // 可重复使用的句柄可能已被 push(handle, value) 占用，跳过这样的句柄
+                handle_type allocate_handle()
+                {
+                    while (!free_.empty())
+                    {
+                        const handle_type h = free_.back();
+                        free_.pop_back();
+                        if (pos_[h] == npos)
+                        {
+                            issued_[h] = 1;
+                            return h;
+                        }
+                    }
+                    pos_.push_back(npos);
+                    issued_.push_back(1);
+                    return pos_.size() - 1;
+                }
+
+                // 句柄不再对应堆中的元素，只有 allocate_handle 分配的句柄才放回 free_：
+                // 它在被分配时已从 free_ 中取出，因此不会重复出现
+                void release_handle(handle_type h)
+                {
+                    pos_[h] = npos;
+                    if (issued_[h])
+                        free_.push_back(h);
+                }
+
+                template <class V>
+                    handle_type push_aux(handle_type h, V&& value);
+
+                void sift_up(size_type i);
+                void sift_down(size_type i);
+        };
+
+    template <class T, class Compared, size_t D>
+        constexpr typename indexed_heap<T, Compared, D>::handle_type indexed_heap<T, Compared, D>::npos;
+
+    template <class T, class Compared, size_t D>
+        template <class V>
+        typename indexed_heap<T, Compared, D>::handle_type
+        indexed_heap<T, Compared, D>::push_aux(handle_type h, V&& value)
+        {
+            if (h >= pos_.size())
+                reserve_handles(h + 1);
+            MYSTL_DEBUG(pos_[h] == npos);
+            heap_.push_back(entry{ mystl::forward<V>(value), h });
+            pos_[h] = heap_.size() - 1;
+            sift_up(heap_.size() - 1);
+            return h;
+        }
+
+    // 以空穴的方式移动元素，每次移动都更新位置表
+    template <class T, class Compared, size_t D>
+        void indexed_heap<T, Compared, D>::sift_up(size_type i)
+        {
+            entry e = mystl::move(heap_[i]);
+            while (i > 0)
+            {
+                const size_type p = parent(i);
+                if (!comp_(heap_[p].value, e.value))
+                    break;
+                heap_[i] = mystl::move(heap_[p]);
+                pos_[heap_[i].handle] = i;
+                i = p;
+            }
+            pos_[e.handle] = i;
+            heap_[i] = mystl::move(e);
+        }
+
+    template <class T, class Compared, size_t D>
+        void indexed_heap<T, Compared, D>::sift_down(size_type i)
+        {
+            const size_type n = heap_.size();
+            entry e = mystl::move(heap_[i]);
+            while (true)
+            {
+                const size_type first_child = D * i + 1;
+                if (first_child >= n)
+                    break;
+                const size_type last_child = first_child + D < n ? first_child + D : n;
+                size_type best = first_child;
+                for (size_type c = first_child + 1; c < last_child; ++c)
+                {
+                    if (comp_(heap_[best].value, heap_[c].value))
+                        best = c;
+                }
+                if (!comp_(e.value, heap_[best].value))
+                    break;
+                heap_[i] = mystl::move(heap_[best]);
+                pos_[heap_[i].handle] = i;
+                i = best;
+            }
+            pos_[e.handle] = i;
+            heap_[i] = mystl::move(e);
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_INDEXED_HEAP_H_
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <climits>
+#include <new>
 
 #include "algobase.h"  // 包含算法相关的函数
 #include "allocator.h"  // 包含空间配置器相关的函数
@@ -128,6 +129,7 @@ namespace mystl
         void temporary_buffer<ForwardIterator, T>::allocate_buffer()
         {
             original_len = len;
+            buffer = nullptr;
             if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
                 len = INT_MAX / sizeof(T);
             while (len > 0)
@@ -139,6 +141,186 @@ namespace mystl
             }
         }
 
+    // --------------------------------------------------------------------------------------
+    // 类模板 : scratch_buffer
+    // 通过 mystl::allocator 申请恰好 n 个元素的缓冲区，元素个数为 size_t，不受 INT_MAX 字节的限制；
+    // 申请失败时抛出 std::bad_alloc，而不像 temporary_buffer 那样返回较小的缓冲区；
+    // 以 std::nothrow 构造时申请失败不抛出异常，缓冲区的大小为 0
+    // 缓冲区中的元素从 *first 开始依次移动构造，最后再移回 *first，不会复制元素
+    template <class T>
+        class scratch_buffer
+        {
+            private:
+                T*     buffer_;  // 指向缓冲区的指针
+                size_t len_;     // 缓冲区的大小
+
+            public:
+                // 构造、析构函数
+                template <class ForwardIterator>
+                    scratch_buffer(ForwardIterator first, size_t n)
+                    :buffer_(mystl::allocator<T>::allocate(n)), len_(n)
+                    {
+                        if (n > 0)
+                            initialize_buffer(first, std::is_trivially_default_constructible<T>());
+                    }
+
+                template <class ForwardIterator>
+                    scratch_buffer(ForwardIterator first, size_t n, const std::nothrow_t&)
+                    :buffer_(nullptr), len_(0)
+                    {
+                        try
+                        {
+                            buffer_ = mystl::allocator<T>::allocate(n);
+                        }
+                        catch (const std::bad_alloc&)
+                        {
+                            return;
+                        }
+                        len_ = n;
+                        if (n > 0)
+                            initialize_buffer(first, std::is_trivially_default_constructible<T>());
+                    }
+
+                ~scratch_buffer()
+                {
+                    mystl::destroy(buffer_, buffer_ + len_);
+                    mystl::allocator<T>::deallocate(buffer_, len_);
+                }
+
+            public:
+                size_t size()  const noexcept { return len_; }
+                T*     begin()       noexcept { return buffer_; }
+                T*     end()         noexcept { return buffer_ + len_; }
+
+            private:
+                template <class ForwardIterator>
+                    void initialize_buffer(ForwardIterator, std::true_type) {}
+                template <class ForwardIterator>
+                    void initialize_buffer(ForwardIterator first, std::false_type);
+
+            private:
+                scratch_buffer(const scratch_buffer&);
+                void operator=(const scratch_buffer&);
+        };
+
+    // *first 的值沿着缓冲区移动一遍再回到 *first，构造失败时同样把值移回 *first
+    template <class T>
+        template <class ForwardIterator>
+        void scratch_buffer<T>::initialize_buffer(ForwardIterator first, std::false_type)
+        {
+            T* cur = buffer_;
+            try
+            {
+                mystl::construct(cur, mystl::move(*first));
+                for (++cur; cur != buffer_ + len_; ++cur)
+                    mystl::construct(cur, mystl::move(*(cur - 1)));
+                *first = mystl::move(*(cur - 1));
+            }
+            catch (...)
+            {
+                if (cur != buffer_)
+                    *first = mystl::move(*(cur - 1));
+                mystl::destroy(buffer_, cur);
+                mystl::allocator<T>::deallocate(buffer_, len_);
+                throw;
+            }
+        }
+
+    // --------------------------------------------------------------------------------------
+    // 类模板 : merge_buffer
+    // 可以重复使用的合并缓冲区，传给 stable_sort / inplace_merge 后在多次调用之间保留，
+    // 只有需要更大的空间时才重新申请。缓冲区中的元素始终处于已构造的状态
+    template <class T>
+        class merge_buffer
+        {
+            private:
+                T*        buffer_;  // 指向缓冲区的指针
+                ptrdiff_t len_;     // 缓冲区的大小
+
+            public:
+                // 构造、析构函数
+                merge_buffer() noexcept :buffer_(nullptr), len_(0) {}
+
+                explicit merge_buffer(ptrdiff_t n, const T& value = T())
+                    :buffer_(nullptr), len_(0)
+                {
+                    reserve(n, value);
+                }
+
+                merge_buffer(merge_buffer&& rhs) noexcept
+                    :buffer_(rhs.buffer_), len_(rhs.len_)
+                {
+                    rhs.buffer_ = nullptr;
+                    rhs.len_ = 0;
+                }
+
+                merge_buffer& operator=(merge_buffer&& rhs) noexcept
+                {
+                    if (this != &rhs)
+                    {
+                        release();
+                        buffer_ = rhs.buffer_;
+                        len_ = rhs.len_;
+                        rhs.buffer_ = nullptr;
+                        rhs.len_ = 0;
+                    }
+                    return *this;
+                }
+
+                ~merge_buffer() { release(); }
+
+            public:
+                ptrdiff_t size()  const noexcept { return len_; }
+                T*        begin()       noexcept { return buffer_; }
+                T*        end()         noexcept { return buffer_ + len_; }
+
+                // 保证缓冲区至少能容纳 n 个元素，新的元素以 value 构造
+                // 申请失败时保留原来的缓冲区，返回缓冲区实际的大小
+                ptrdiff_t reserve(ptrdiff_t n, const T& value);
+
+                // 释放缓冲区
+                void release() noexcept
+                {
+                    mystl::destroy(buffer_, buffer_ + len_);
+                    free(buffer_);
+                    buffer_ = nullptr;
+                    len_ = 0;
+                }
+
+            private:
+                merge_buffer(const merge_buffer&);
+                void operator=(const merge_buffer&);
+        };
+
+    template <class T>
+        ptrdiff_t merge_buffer<T>::reserve(ptrdiff_t n, const T& value)
+        {
+            if (n <= len_)
+                return len_;
+            auto result = mystl::get_temporary_buffer<T>(n);
+            if (result.second <= len_)
+            {  // 申请到的空间不比原来的大
+                mystl::release_temporary_buffer(result.first);
+                return len_;
+            }
+            if (!std::is_trivially_default_constructible<T>::value)
+            {
+                try
+                {
+                    mystl::uninitialized_fill_n(result.first, result.second, value);
+                }
+                catch (...)
+                {
+                    mystl::release_temporary_buffer(result.first);
+                    return len_;
+                }
+            }
+            release();
+            buffer_ = result.first;
+            len_ = result.second;
+            return len_;
+        }
+
     // --------------------------------------------------------------------------------------
     // 类模板: auto_ptr
     // 一个具有严格对象所有权的小型智能指针
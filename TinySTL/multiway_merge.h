@@ -0,0 +1,221 @@
+#ifndef MYTINYSTL_MULTIWAY_MERGE_H_
+#define MYTINYSTL_MULTIWAY_MERGE_H_
+
+// 这个头文件包含一个类模板 loser_tree，以及使用它的多路归并算法 multiway_merge
+
+// notes:
+//
+// multiway_merge 一次性合并 k 个有序区间，每输出一个元素进行约 log2(k) 次比较，
+// 总的复杂度为 O(N log k)，避免了两两 merge 时的多轮复制
+// 输入的区间以一对迭代器(mystl::pair 或其它有 first / second 成员的类型)表示，
+// 相等的元素中，来自靠前区间的元素排在前面，因此结果是稳定的
+// 并行版本 parallel_multiway_merge 以及执行策略版本在 parallel_algo.h 中
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+
+namespace mystl
+{
+
+    // 以掩码在 a 与 b 之间选择(cond 为真时返回 a)，使编译器生成不含分支的代码
+    // 只用于大小为 1、2、4、8 字节且可以平凡复制的类型，其它类型使用条件运算符
+    template <class T, size_t Size = sizeof(T),
+              bool Bits = std::is_trivially_copyable<T>::value &&
+                          (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>
+        struct loser_tree_select
+        {
+            static T select(bool cond, const T& a, const T& b) { return cond ? a : b; }
+        };
+
+    template <class T, size_t Size>
+        struct loser_tree_select<T, Size, true>
+        {
+            typedef typename std::conditional<Size == 1, uint8_t,
+                    typename std::conditional<Size == 2, uint16_t,
+                    typename std::conditional<Size == 4, uint32_t, uint64_t>::type>::type>::type bits;
+
+            static T select(bool cond, const T& a, const T& b)
+            {
+                bits x, y;
+                std::memcpy(&x, &a, Size);
+                std::memcpy(&y, &b, Size);
+                const bits mask = static_cast<bits>(-static_cast<int>(cond));
+                y = static_cast<bits>(y ^ ((x ^ y) & mask));
+                T result;
+                std::memcpy(&result, &y, Size);
+                return result;
+            }
+        };
+
+    // --------------------------------------------------------------------------------------
+    // 类模板 : loser_tree
+    // 在 k 个有序序列之间进行比赛的败者树，k 个叶子对应 k 个序列的当前元素
+    // 内部节点 1 .. k - 1 记录在该处比赛中落败的序列及其当前元素，另外单独记录最终的胜者
+    // 取出胜者的当前元素后，只需沿着它的叶子到根的路径与各节点记录的败者重新比赛
+    //
+    // 元素可以平凡复制且不大于两个指针时，节点中直接保存元素的副本，比赛时不必经过迭代器间接访问；
+    // 否则保存指向元素的迭代器
+    // 某个序列取完时把它从树中删去并重新建树(O(k))，比赛过程中因此不需要检查序列是否取完
+    // 相等的元素中序号小的序列获胜，每一层的胜者以条件传送选出，避免难以预测的分支
+    template <class Iter, class Compared>
+        class loser_tree
+        {
+            public:
+                typedef typename iterator_traits<Iter>::value_type value_type;
+
+            private:
+                typedef m_bool_constant<std::is_trivially_copyable<value_type>::value &&
+                                        sizeof(value_type) <= 2 * sizeof(void*)>   cache_key;
+                typedef typename std::conditional<cache_key::value, value_type, Iter>::type key_type;
+
+                mystl::vector<Iter>     cur_;     // 每个序列的当前位置
+                mystl::vector<Iter>     last_;    // 每个序列的末尾
+                mystl::vector<key_type> key_;     // 每个内部节点记录的败者的当前元素
+                mystl::vector<size_t>   index_;   // 每个内部节点记录的败者的序号
+                key_type                winner_key_;
+                size_t                  winner_;
+                size_t                  k_;       // 尚未取完的序列的个数
+                Compared                comp_;
+
+            public:
+                explicit loser_tree(Compared comp = Compared())
+                    :winner_key_(), winner_(0), k_(0), comp_(comp)
+                {
+                }
+
+                // 加入一个非空的序列，必须在 build 之前调用
+                void push_sequence(Iter first, Iter last)
+                {
+                    cur_.push_back(first);
+                    last_.push_back(last);
+                    ++k_;
+                }
+
+                // 所有序列加入后建树
+                void build()
+                {
+                    if (k_ == 0)
+                        return;
+                    key_.assign(k_, make_key(cur_[0], cache_key()));
+                    index_.assign(k_, 0);
+                    winner_ = build_aux(1);
+                    winner_key_ = make_key(cur_[winner_], cache_key());
+                }
+
+                // 所有序列是否都已取完
+                bool empty() const noexcept { return k_ == 0; }
+
+                // 所有序列的当前元素中最小的一个
+                const value_type& top() const { return deref(winner_key_); }
+
+                // 取出胜者的当前元素，并重新比赛
+                void pop()
+                {
+                    Iter* cur = cur_.begin();
+                    if (++cur[winner_] == *(last_.begin() + winner_))
+                    {
+                        erase_sequence(winner_);
+                        return;
+                    }
+                    key_type* keys = key_.begin();
+                    size_t*   index = index_.begin();
+                    size_t    winner = winner_;
+                    key_type  wk = make_key(cur[winner], cache_key());
+                    for (size_t node = (winner + k_) >> 1; node > 0; node >>= 1)
+                    {
+                        const key_type ck = keys[node];
+                        const size_t   ci = index[node];
+                        const bool     less = key_less(ck, wk, cache_key());
+                        const bool     greater = key_less(wk, ck, cache_key());
+                        const bool     c_wins = less | (!greater & (ci < winner));
+                        keys[node] = loser_tree_select<key_type>::select(c_wins, wk, ck);
+                        index[node] = loser_tree_select<size_t>::select(c_wins, winner, ci);
+                        wk = loser_tree_select<key_type>::select(c_wins, ck, wk);
+                        winner = loser_tree_select<size_t>::select(c_wins, ci, winner);
+                    }
+                    winner_ = winner;
+                    winner_key_ = wk;
+                }
+
+            private:
+                static key_type make_key(Iter it, m_true_type)  { return *it; }
+                static key_type make_key(Iter it, m_false_type) { return it; }
+
+                static const value_type& deref(const value_type& key) { return key; }
+                template <class I>
+                    static const value_type& deref(const I& it) { return *it; }
+
+                // 按值比较保存的副本，便于编译器把副本留在寄存器中
+                bool key_less(key_type a, key_type b, m_true_type) const  { return comp_(a, b); }
+                bool key_less(key_type a, key_type b, m_false_type) const { return comp_(*a, *b); }
+
+                // 删去已经取完的序列，其余序列保持原来的先后次序
+                void erase_sequence(size_t i)
+                {
+                    cur_.erase(cur_.begin() + i);
+                    last_.erase(last_.begin() + i);
+                    --k_;
+                    build();
+                }
+
+                // 叶子 i 位于 k + i，返回以 node 为根的子树的胜者，并在内部节点上记录败者
+                size_t build_aux(size_t node)
+                {
+                    if (node >= k_)
+                        return node - k_;
+                    const size_t left = build_aux(2 * node);
+                    const size_t right = build_aux(2 * node + 1);
+                    // 叶子的编号不一定随序号递增，按序号决定相等时的胜者
+                    const size_t a = mystl::min(left, right);
+                    const size_t b = mystl::max(left, right);
+                    const bool   a_wins = !comp_(*cur_[b], *cur_[a]);
+                    index_[node] = a_wins ? b : a;
+                    key_[node] = make_key(cur_[index_[node]], cache_key());
+                    return a_wins ? a : b;
+                }
+        };
+
+    /*****************************************************************************************/
+    // multiway_merge
+    // 合并[first, last)中的每一个有序区间(*first).first ~ (*first).second 到 result 起始处，
+    // 返回一个迭代器指向输出的最后一个元素的下一位置
+    /*****************************************************************************************/
+    template <class RangeIter, class OutputIter, class Compared>
+        OutputIter
+        multiway_merge(RangeIter first, RangeIter last, OutputIter result, Compared comp)
+        {
+            typedef typename iterator_traits<RangeIter>::value_type range_type;
+            typedef typename range_type::first_type                 Iter;
+            loser_tree<Iter, Compared> tree(comp);
+            for (; first != last; ++first)
+            {
+                if ((*first).first != (*first).second)
+                    tree.push_sequence((*first).first, (*first).second);
+            }
+            tree.build();
+            for (; !tree.empty(); tree.pop())
+            {
+                *result = tree.top();
+                ++result;
+            }
+            return result;
+        }
+
+    template <class RangeIter, class OutputIter>
+        OutputIter
+        multiway_merge(RangeIter first, RangeIter last, OutputIter result)
+        {
+            typedef typename iterator_traits<RangeIter>::value_type range_type;
+            typedef typename range_type::first_type                 Iter;
+            typedef typename iterator_traits<Iter>::value_type      value_type;
+            return mystl::multiway_merge(first, last, result, mystl::less<value_type>());
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_MULTIWAY_MERGE_H_
@@ -0,0 +1,351 @@
+#ifndef MYTINYSTL_NUMERIC_H_
+#define MYTINYSTL_NUMERIC_H_
+
+// 这个头文件包含了 mystl 的数值算法
+
+// notes:
+//
+// reduce 与 transform_reduce 的默认版本从左到右依次计算，结果与逐个累加相同
+// 第一个参数为 execution::unseq 的版本允许改变运算的结合顺序，要求运算满足结合律与交换律：
+//   随机访问迭代器使用四个累加器交替累加，打断相邻两次运算之间的依赖
+//   算术类型的指针区间(包括 vector 的迭代器)配合 plus / multiplies 时使用 SIMD 内核(simd.h)
+// 浮点数重新结合后的结果可能与依次计算的结果略有不同
+//
+// inclusive_scan / exclusive_scan 等前缀和算法的并行版本在 parallel_algo.h 中
+
+#include <type_traits>
+
+#include "iterator.h"
+#include "functional.h"
+#include "execution.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl
+{
+
+    // 判断 unseq 版本的 reduce 是否可以使用 SIMD 内核
+    // Iter 为指向 T 的指针，T 为算术类型且合并操作为 plus<T>
+    template <class Iter, class T, class BinaryOp>
+        struct is_simd_reduce : public m_false_type {};
+
+    template <class Tp, class T, class BinaryOp>
+        struct is_simd_reduce<Tp*, T, BinaryOp> : public m_bool_constant<
+            is_simd_type<T>::value &&
+            std::is_same<typename std::remove_cv<Tp>::type, T>::value &&
+            std::is_same<BinaryOp, mystl::plus<T>>::value> {};
+
+    // 判断 unseq 版本的 transform_reduce 是否可以使用 SIMD 内积内核
+    // 两个区间都是指向 T 的指针，T 为浮点类型，运算为 plus<T> 与 multiplies<T>
+    template <class Iter1, class Iter2, class T, class ReduceOp, class TransformOp>
+        struct is_simd_dot : public m_false_type {};
+
+    template <class Tp, class Up, class T, class ReduceOp, class TransformOp>
+        struct is_simd_dot<Tp*, Up*, T, ReduceOp, TransformOp> : public m_bool_constant<
+            std::is_floating_point<T>::value &&
+            std::is_same<typename std::remove_cv<Tp>::type, T>::value &&
+            std::is_same<typename std::remove_cv<Up>::type, T>::value &&
+            std::is_same<ReduceOp, mystl::plus<T>>::value &&
+            std::is_same<TransformOp, mystl::multiplies<T>>::value> {};
+
+    // 以四个累加器交替合并 access(0), access(1), ..., access(n - 1)，最后与 init 合并
+    template <class T, class Distance, class BinaryOp, class Access>
+        T reduce_unseq_aux(Distance n, T init, BinaryOp binary_op, Access access)
+        {
+            if (n < 8)
+            {
+                for (Distance i = 0; i < n; ++i)
+                    init = binary_op(init, access(i));
+                return init;
+            }
+            T acc0 = binary_op(access(0), access(4));
+            T acc1 = binary_op(access(1), access(5));
+            T acc2 = binary_op(access(2), access(6));
+            T acc3 = binary_op(access(3), access(7));
+            Distance i = 8;
+            for (; n - i >= 4; i += 4)
+            {
+                acc0 = binary_op(acc0, access(i));
+                acc1 = binary_op(acc1, access(i + 1));
+                acc2 = binary_op(acc2, access(i + 2));
+                acc3 = binary_op(acc3, access(i + 3));
+            }
+            for (; i < n; ++i)
+                acc0 = binary_op(acc0, access(i));
+            return binary_op(init, binary_op(binary_op(acc0, acc1), binary_op(acc2, acc3)));
+        }
+
+    /*****************************************************************************************/
+    // reduce
+    // 以 binary_op(缺省为 plus)合并 init 与[first, last)内的所有元素
+    /*****************************************************************************************/
+    template <class InputIter, class T, class BinaryOp>
+        T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op)
+        {
+            for (; first != last; ++first)
+                init = binary_op(init, *first);
+            return init;
+        }
+
+    template <class InputIter, class T>
+        T reduce(InputIter first, InputIter last, T init)
+        {
+            return mystl::reduce(first, last, init, mystl::plus<T>());
+        }
+
+    template <class InputIter>
+        typename iterator_traits<InputIter>::value_type
+        reduce(InputIter first, InputIter last)
+        {
+            typedef typename iterator_traits<InputIter>::value_type value_type;
+            return mystl::reduce(first, last, value_type(), mystl::plus<value_type>());
+        }
+
+    // 允许重新结合的版本
+    template <class RandomIter>
+        struct reduce_access
+        {
+            RandomIter first;
+
+            template <class Distance>
+                typename iterator_traits<RandomIter>::reference operator()(Distance i) const
+                { return first[i]; }
+        };
+
+    template <class RandomIter, class T, class BinaryOp>
+        T reduce_unseq_dispatch(RandomIter first, RandomIter last, T init,
+                BinaryOp binary_op, m_false_type)
+        {
+            return mystl::reduce_unseq_aux(last - first, init, binary_op,
+                                           reduce_access<RandomIter>{first});
+        }
+
+    template <class Tp, class T, class BinaryOp>
+        T reduce_unseq_dispatch(Tp* first, Tp* last, T init, BinaryOp, m_true_type)
+        {
+            return static_cast<T>(init + mystl::simd_sum<T>(first, last));
+        }
+
+    template <class RandomIter, class T, class BinaryOp>
+        T reduce(const execution::unsequenced_policy&, RandomIter first, RandomIter last,
+                T init, BinaryOp binary_op)
+        {
+            return mystl::reduce_unseq_dispatch(first, last, init, binary_op,
+                                                is_simd_reduce<RandomIter, T, BinaryOp>());
+        }
+
+    template <class RandomIter, class T>
+        T reduce(const execution::unsequenced_policy& policy, RandomIter first, RandomIter last,
+                T init)
+        {
+            return mystl::reduce(policy, first, last, init, mystl::plus<T>());
+        }
+
+    template <class RandomIter>
+        typename iterator_traits<RandomIter>::value_type
+        reduce(const execution::unsequenced_policy& policy, RandomIter first, RandomIter last)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            return mystl::reduce(policy, first, last, value_type(), mystl::plus<value_type>());
+        }
+
+    /*****************************************************************************************/
+    // transform_reduce
+    // 版本1：以 transform_op(缺省为 multiplies)合并两个序列中对应的元素，
+    //        再以 reduce_op(缺省为 plus)合并 init 与所有结果
+    // 版本2：对[first, last)内的每个元素调用 transform_op，再以 reduce_op 合并 init 与所有结果
+    /*****************************************************************************************/
+    template <class InputIter1, class InputIter2, class T, class ReduceOp, class TransformOp>
+        T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                ReduceOp reduce_op, TransformOp transform_op)
+        {
+            for (; first1 != last1; ++first1, ++first2)
+                init = reduce_op(init, transform_op(*first1, *first2));
+            return init;
+        }
+
+    template <class InputIter1, class InputIter2, class T>
+        T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+        {
+            return mystl::transform_reduce(first1, last1, first2, init,
+                                           mystl::plus<T>(), mystl::multiplies<T>());
+        }
+
+    template <class InputIter, class T, class ReduceOp, class TransformOp>
+        T transform_reduce(InputIter first, InputIter last, T init,
+                ReduceOp reduce_op, TransformOp transform_op)
+        {
+            for (; first != last; ++first)
+                init = reduce_op(init, transform_op(*first));
+            return init;
+        }
+
+    // 允许重新结合的版本
+    template <class RandomIter1, class RandomIter2, class TransformOp>
+        struct transform_reduce_access
+        {
+            RandomIter1 first1;
+            RandomIter2 first2;
+            TransformOp transform_op;
+
+            template <class Distance>
+                auto operator()(Distance i) -> decltype(transform_op(first1[i], first2[i]))
+                { return transform_op(first1[i], first2[i]); }
+        };
+
+    template <class RandomIter, class TransformOp>
+        struct transform_access
+        {
+            RandomIter  first;
+            TransformOp transform_op;
+
+            template <class Distance>
+                auto operator()(Distance i) -> decltype(transform_op(first[i]))
+                { return transform_op(first[i]); }
+        };
+
+    template <class RandomIter1, class RandomIter2, class T, class ReduceOp, class TransformOp>
+        T transform_reduce_unseq_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                T init, ReduceOp reduce_op, TransformOp transform_op, m_false_type)
+        {
+            return mystl::reduce_unseq_aux(last1 - first1, init, reduce_op,
+                transform_reduce_access<RandomIter1, RandomIter2, TransformOp>{first1, first2, transform_op});
+        }
+
+    template <class Tp, class Up, class T, class ReduceOp, class TransformOp>
+        T transform_reduce_unseq_dispatch(Tp* first1, Tp* last1, Up* first2,
+                T init, ReduceOp, TransformOp, m_true_type)
+        {
+            return init + mystl::simd_dot<T>(first1, last1, first2);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class ReduceOp, class TransformOp>
+        T transform_reduce(const execution::unsequenced_policy&, RandomIter1 first1, RandomIter1 last1,
+                RandomIter2 first2, T init, ReduceOp reduce_op, TransformOp transform_op)
+        {
+            return mystl::transform_reduce_unseq_dispatch(first1, last1, first2, init,
+                reduce_op, transform_op,
+                is_simd_dot<RandomIter1, RandomIter2, T, ReduceOp, TransformOp>());
+        }
+
+    template <class RandomIter1, class RandomIter2, class T>
+        T transform_reduce(const execution::unsequenced_policy& policy, RandomIter1 first1,
+                RandomIter1 last1, RandomIter2 first2, T init)
+        {
+            return mystl::transform_reduce(policy, first1, last1, first2, init,
+                                           mystl::plus<T>(), mystl::multiplies<T>());
+        }
+
+    template <class RandomIter, class T, class ReduceOp, class TransformOp>
+        T transform_reduce(const execution::unsequenced_policy&, RandomIter first, RandomIter last,
+                T init, ReduceOp reduce_op, TransformOp transform_op)
+        {
+            return mystl::reduce_unseq_aux(last - first, init, reduce_op,
+                transform_access<RandomIter, TransformOp>{first, transform_op});
+        }
+
+    /*****************************************************************************************/
+    // inclusive_scan
+    // 以 binary_op(缺省为 plus)计算前缀和，第 i 个输出为 [first, first + i] 内所有元素的和
+    // 给出 init 时，init 作为第一个元素之前的值参与计算，返回输出区间的尾部
+    /*****************************************************************************************/
+    template <class InputIter, class OutputIter, class BinaryOp, class T>
+        OutputIter
+        inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op, T init)
+        {
+            for (; first != last; ++first, ++result)
+            {
+                init = binary_op(init, *first);
+                *result = init;
+            }
+            return result;
+        }
+
+    template <class InputIter, class OutputIter, class BinaryOp>
+        OutputIter
+        inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op)
+        {
+            if (first == last)
+                return result;
+            typename iterator_traits<InputIter>::value_type sum = *first;
+            *result = sum;
+            return mystl::inclusive_scan(++first, last, ++result, binary_op, sum);
+        }
+
+    template <class InputIter, class OutputIter>
+        OutputIter
+        inclusive_scan(InputIter first, InputIter last, OutputIter result)
+        {
+            typedef typename iterator_traits<InputIter>::value_type value_type;
+            return mystl::inclusive_scan(first, last, result, mystl::plus<value_type>());
+        }
+
+    /*****************************************************************************************/
+    // exclusive_scan
+    // 以 binary_op(缺省为 plus)计算前缀和，第 i 个输出为 init 与 [first, first + i) 内所有元素的和
+    /*****************************************************************************************/
+    template <class InputIter, class OutputIter, class T, class BinaryOp>
+        OutputIter
+        exclusive_scan(InputIter first, InputIter last, OutputIter result, T init, BinaryOp binary_op)
+        {
+            for (; first != last; ++first, ++result)
+            {
+                T next = binary_op(init, *first);  // 先读出当前元素，允许 result 与 first 相同
+                *result = init;
+                init = mystl::move(next);
+            }
+            return result;
+        }
+
+    template <class InputIter, class OutputIter, class T>
+        OutputIter
+        exclusive_scan(InputIter first, InputIter last, OutputIter result, T init)
+        {
+            return mystl::exclusive_scan(first, last, result, init, mystl::plus<T>());
+        }
+
+    /*****************************************************************************************/
+    // transform_inclusive_scan / transform_exclusive_scan
+    // 先以 unary_op 作用于每个元素，再以 binary_op 计算前缀和
+    /*****************************************************************************************/
+    template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp, class T>
+        OutputIter
+        transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                BinaryOp binary_op, UnaryOp unary_op, T init)
+        {
+            for (; first != last; ++first, ++result)
+            {
+                init = binary_op(init, unary_op(*first));
+                *result = init;
+            }
+            return result;
+        }
+
+    template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp>
+        OutputIter
+        transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                BinaryOp binary_op, UnaryOp unary_op)
+        {
+            if (first == last)
+                return result;
+            auto sum = unary_op(*first);
+            *result = sum;
+            return mystl::transform_inclusive_scan(++first, last, ++result, binary_op, unary_op, sum);
+        }
+
+    template <class InputIter, class OutputIter, class T, class BinaryOp, class UnaryOp>
+        OutputIter
+        transform_exclusive_scan(InputIter first, InputIter last, OutputIter result, T init,
+                BinaryOp binary_op, UnaryOp unary_op)
+        {
+            for (; first != last; ++first, ++result)
+            {
+                T next = binary_op(init, unary_op(*first));
+                *result = init;
+                init = mystl::move(next);
+            }
+            return result;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_NUMERIC_H_
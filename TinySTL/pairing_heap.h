@@ -0,0 +1,351 @@
+#ifndef MYTINYSTL_PAIRING_HEAP_H_
+#define MYTINYSTL_PAIRING_HEAP_H_
+
+// 这个头文件包含一个类模板 pairing_heap
+// 配对堆：每个元素是一个节点，push 返回指向节点的句柄，之后可以通过句柄修改或删除元素
+
+// notes:
+//
+// 与 priority_queue 一样，top() 返回按 Compare 最大的元素，最短路径等需要最小堆时使用 mystl::greater
+// push、merge 以及把元素改大(对最小堆而言即 decrease-key)为 O(1)，pop 与 erase 均摊 O(log n)
+// 改大元素时把它所在的子树剪下再与根合并；改小元素时先删除再重新插入，均摊 O(log n)
+// 节点以“左孩子 - 右兄弟”的方式链接，prev 指向前一个兄弟，第一个孩子的 prev 指向父节点
+// pop 采用两趟合并：从左到右两两合并孩子，再从右到左依次合并，均以循环实现，不会因为递归过深而栈溢出
+// 句柄在元素被删除前一直有效，merge 之后同样有效
+
+#include <cstddef>
+
+#include "functional.h"
+#include "memory.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+    template <class T>
+        struct pairing_heap_node
+        {
+            pairing_heap_node* child;    // 第一个孩子
+            pairing_heap_node* sibling;  // 下一个兄弟
+            pairing_heap_node* prev;     // 前一个兄弟，第一个孩子的 prev 指向父节点，根节点为 nullptr
+            T                  value;
+        };
+
+    // 模板类 pairing_heap
+    // 参数一代表元素类型，参数二代表比较方式，缺省使用 mystl::less
+    template <class T, class Compared = mystl::less<T>>
+        class pairing_heap
+        {
+            public:
+                typedef T                           value_type;
+                typedef const T&                    const_reference;
+                typedef size_t                      size_type;
+                typedef Compared                    value_compare;
+                typedef pairing_heap_node<T>*       handle_type;
+
+            private:
+                typedef pairing_heap_node<T>                 node_type;
+                typedef node_type*                           node_ptr;
+                typedef mystl::allocator<T>                  data_allocator;
+                typedef mystl::allocator<node_type>          node_allocator;
+
+                node_ptr  root_;
+                size_type size_;
+                Compared  comp_;
+
+            public:
+                // 构造、复制、移动、析构函数
+                pairing_heap() noexcept
+                    :root_(nullptr), size_(0), comp_()
+                {
+                }
+
+                explicit pairing_heap(Compared comp)
+                    :root_(nullptr), size_(0), comp_(comp)
+                {
+                }
+
+                pairing_heap(pairing_heap&& rhs) noexcept
+                    :root_(rhs.root_), size_(rhs.size_), comp_(rhs.comp_)
+                {
+                    rhs.root_ = nullptr;
+                    rhs.size_ = 0;
+                }
+
+                pairing_heap& operator=(pairing_heap&& rhs) noexcept
+                {
+                    if (this != &rhs)
+                    {
+                        clear();
+                        swap(rhs);
+                    }
+                    return *this;
+                }
+
+                ~pairing_heap() { clear(); }
+
+            public:
+                bool      empty() const noexcept { return root_ == nullptr; }
+                size_type size()  const noexcept { return size_; }
+
+                // 最大的元素及其句柄
+                const_reference top()        const { return root_->value; }
+                handle_type     top_handle() const noexcept { return root_; }
+
+                // 句柄 h 对应的元素
+                const_reference operator[](handle_type h) const { return h->value; }
+
+                // 插入元素，返回它的句柄
+                handle_type push(const value_type& value) { return emplace(value); }
+                handle_type push(value_type&& value)      { return emplace(mystl::move(value)); }
+
+                template <class ...Args>
+                    handle_type emplace(Args&& ...args)
+                    {
+                        node_ptr p = create_node(mystl::forward<Args>(args)...);
+                        root_ = root_ ? link(root_, p) : p;
+                        ++size_;
+                        return p;
+                    }
+
+                // 删除最大的元素
+                void pop()
+                {
+                    MYSTL_DEBUG(!empty());
+                    node_ptr old = root_;
+                    root_ = combine_children(old);
+                    destroy_node(old);
+                    --size_;
+                }
+
+                // 把句柄 h 对应的元素改为 value，可以变大或变小
+                void update(handle_type h, const value_type& value)
+                {
+                    if (comp_(h->value, value))
+                    {
+                        h->value = value;
+                        increase(h);
+                    }
+                    else
+                    {
+                        h->value = value;
+                        decrease(h);
+                    }
+                }
+
+                void update(handle_type h, value_type&& value)
+                {
+                    if (comp_(h->value, value))
+                    {
+                        h->value = mystl::move(value);
+                        increase(h);
+                    }
+                    else
+                    {
+                        h->value = mystl::move(value);
+                        decrease(h);
+                    }
+                }
+
+                // 删除句柄 h 对应的元素，句柄随即失效
+                void erase(handle_type h)
+                {
+                    if (h == root_)
+                    {
+                        pop();
+                        return;
+                    }
+                    cut(h);
+                    node_ptr sub = combine_children(h);
+                    if (sub)
+                        root_ = link(root_, sub);
+                    destroy_node(h);
+                    --size_;
+                }
+
+                // 把 rhs 中的所有元素移入当前的堆，rhs 变为空，rhs 的句柄仍然有效
+                void merge(pairing_heap& rhs)
+                {
+                    if (this == &rhs || rhs.root_ == nullptr)
+                        return;
+                    root_ = root_ ? link(root_, rhs.root_) : rhs.root_;
+                    size_ += rhs.size_;
+                    rhs.root_ = nullptr;
+                    rhs.size_ = 0;
+                }
+
+                void clear();
+
+                void swap(pairing_heap& rhs) noexcept
+                {
+                    mystl::swap(root_, rhs.root_);
+                    mystl::swap(size_, rhs.size_);
+                    mystl::swap(comp_, rhs.comp_);
+                }
+
+            private:
+                template <class ...Args>
+                    node_ptr create_node(Args&& ...args);
+                void destroy_node(node_ptr p);
+
+                node_ptr link(node_ptr a, node_ptr b);
+                void     cut(node_ptr p);
+                node_ptr combine_children(node_ptr p);
+
+                // 元素变大：剪下以 h 为根的子树，与根合并
+                void increase(node_ptr h)
+                {
+                    if (h == root_)
+                        return;
+                    cut(h);
+                    root_ = link(root_, h);
+                }
+
+                // 元素变小：孩子中可能有比它大的元素，把孩子合并后挂回，再单独插入 h
+                void decrease(node_ptr h)
+                {
+                    node_ptr sub = combine_children(h);
+                    if (h == root_)
+                    {
+                        root_ = sub ? link(sub, h) : h;
+                        return;
+                    }
+                    cut(h);
+                    if (sub)
+                        root_ = link(root_, sub);
+                    root_ = link(root_, h);
+                }
+
+            private:
+                pairing_heap(const pairing_heap&);
+                void operator=(const pairing_heap&);
+        };
+
+    template <class T, class Compared>
+        template <class ...Args>
+        typename pairing_heap<T, Compared>::node_ptr
+        pairing_heap<T, Compared>::create_node(Args&& ...args)
+        {
+            node_ptr p = node_allocator::allocate(1);
+            try
+            {
+                data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+                p->child = nullptr;
+                p->sibling = nullptr;
+                p->prev = nullptr;
+            }
+            catch (...)
+            {
+                node_allocator::deallocate(p);
+                throw;
+            }
+            return p;
+        }
+
+    template <class T, class Compared>
+        void pairing_heap<T, Compared>::destroy_node(node_ptr p)
+        {
+            data_allocator::destroy(mystl::address_of(p->value));
+            node_allocator::deallocate(p);
+        }
+
+    // 合并两棵树 a、b(都没有兄弟)，较小的根成为较大的根的第一个孩子，返回新的根
+    template <class T, class Compared>
+        typename pairing_heap<T, Compared>::node_ptr
+        pairing_heap<T, Compared>::link(node_ptr a, node_ptr b)
+        {
+            if (comp_(a->value, b->value))
+                mystl::swap(a, b);
+            b->sibling = a->child;
+            if (a->child)
+                a->child->prev = b;
+            b->prev = a;
+            a->child = b;
+            a->sibling = nullptr;
+            a->prev = nullptr;
+            return a;
+        }
+
+    // 把以 p 为根的子树从它的父节点与兄弟之间摘下，p 不能是根
+    template <class T, class Compared>
+        void pairing_heap<T, Compared>::cut(node_ptr p)
+        {
+            if (p->prev->child == p)
+                p->prev->child = p->sibling;
+            else
+                p->prev->sibling = p->sibling;
+            if (p->sibling)
+                p->sibling->prev = p->prev;
+            p->sibling = nullptr;
+            p->prev = nullptr;
+        }
+
+    // 两趟合并 p 的所有孩子，返回合并后的根，没有孩子时返回 nullptr
+    template <class T, class Compared>
+        typename pairing_heap<T, Compared>::node_ptr
+        pairing_heap<T, Compared>::combine_children(node_ptr p)
+        {
+            node_ptr cur = p->child;
+            p->child = nullptr;
+            if (cur == nullptr)
+                return nullptr;
+            // 第一趟：从左到右两两合并，合并结果以 prev 反向串起来
+            node_ptr tail = nullptr;
+            while (cur)
+            {
+                node_ptr a = cur;
+                node_ptr b = cur->sibling;
+                if (b == nullptr)
+                {
+                    a->sibling = nullptr;
+                    a->prev = tail;
+                    tail = a;
+                    break;
+                }
+                cur = b->sibling;
+                a->sibling = nullptr;
+                b->sibling = nullptr;
+                node_ptr m = link(a, b);
+                m->prev = tail;
+                tail = m;
+            }
+            // 第二趟：从右到左依次合并
+            node_ptr result = tail;
+            tail = tail->prev;
+            result->prev = nullptr;
+            while (tail)
+            {
+                node_ptr next = tail->prev;
+                tail->prev = nullptr;
+                result = link(tail, result);
+                tail = next;
+            }
+            return result;
+        }
+
+    // 逐个销毁节点，以兄弟链表代替递归
+    template <class T, class Compared>
+        void pairing_heap<T, Compared>::clear()
+        {
+            node_ptr stack = root_;
+            while (stack)
+            {
+                node_ptr p = stack;
+                stack = p->sibling;
+                if (p->child)
+                {  // 把孩子链表接到待处理链表的前面
+                    node_ptr last_child = p->child;
+                    while (last_child->sibling)
+                        last_child = last_child->sibling;
+                    last_child->sibling = stack;
+                    stack = p->child;
+                }
+                destroy_node(p);
+            }
+            root_ = nullptr;
+            size_ = 0;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_PAIRING_HEAP_H_
@@ -0,0 +1,1215 @@
+#ifndef MYTINYSTL_PARALLEL_ALGO_H_
+#define MYTINYSTL_PARALLEL_ALGO_H_
+
+// 这个头文件包含了 mystl 的并行算法，以 thread_pool 作为执行引擎
+
+// notes:
+//
+// 每个算法都有两个版本：第一个参数为 thread_pool& 的版本在指定的线程池中执行，
+// 另一个版本使用 thread_pool::default_pool()
+// 区间被递归地二分，直到长度不超过线程池的 grain_size()，再由一个线程调用对应的串行算法处理
+// 区间长度不超过 grain_size() 或线程池没有工作线程时，直接在调用线程中执行串行算法
+// 并行算法只接受随机访问迭代器
+//
+// 文件末尾为 sort、stable_sort、partial_sort、multiway_merge、inclusive_scan、exclusive_scan、
+// transform_inclusive_scan、transform_exclusive_scan、copy_if、remove_copy_if、partition_copy
+// 提供接受执行策略(execution.h)的重载版本
+
+#include <atomic>
+#include <type_traits>
+
+#include "algo.h"
+#include "execution.h"
+#include "multiway_merge.h"
+#include "numeric.h"
+#include "thread_pool.h"
+
+namespace mystl
+{
+
+    /*****************************************************************************************/
+    // parallel_for_range
+    // 将[first, last)递归二分为不超过 grain_size 的小区间，并行地对每个小区间调用 body(first, last)
+    /*****************************************************************************************/
+    template <class RandomIter, class Body>
+        void parallel_for_range(thread_pool& pool, RandomIter first, RandomIter last, Body& body)
+        {
+            if (pool.run_inline(static_cast<size_t>(last - first)))
+            {
+                body(first, last);
+                return;
+            }
+            auto mid = first + (last - first) / 2;
+            pool.invoke([&]() { mystl::parallel_for_range(pool, first, mid, body); },
+                        [&]() { mystl::parallel_for_range(pool, mid, last, body); });
+        }
+
+    /*****************************************************************************************/
+    // parallel_map_reduce
+    // 对每个小区间调用 map(first, last) 得到部分结果，再用 combine 从左到右合并
+    /*****************************************************************************************/
+    template <class RandomIter, class Map, class Combine>
+        typename std::result_of<Map&(RandomIter, RandomIter)>::type
+        parallel_map_reduce(thread_pool& pool, RandomIter first, RandomIter last,
+                            Map& map, Combine& combine)
+        {
+            typedef typename std::result_of<Map&(RandomIter, RandomIter)>::type result_type;
+            if (pool.run_inline(static_cast<size_t>(last - first)))
+                return map(first, last);
+            auto mid = first + (last - first) / 2;
+            result_type left = result_type(), right = result_type();
+            pool.invoke([&]() { left = mystl::parallel_map_reduce(pool, first, mid, map, combine); },
+                        [&]() { right = mystl::parallel_map_reduce(pool, mid, last, map, combine); });
+            return combine(left, right);
+        }
+
+    /*****************************************************************************************/
+    // parallel_for_each
+    // 并行地对[first, last)内的每个元素调用 f，不保证调用顺序
+    /*****************************************************************************************/
+    template <class RandomIter, class Function>
+        void parallel_for_each(thread_pool& pool, RandomIter first, RandomIter last, Function f)
+        {
+            auto body = [&](RandomIter b, RandomIter e) { mystl::for_each(b, e, f); };
+            mystl::parallel_for_range(pool, first, last, body);
+        }
+
+    template <class RandomIter, class Function>
+        void parallel_for_each(RandomIter first, RandomIter last, Function f)
+        {
+            mystl::parallel_for_each(thread_pool::default_pool(), first, last, f);
+        }
+
+    /*****************************************************************************************/
+    // parallel_transform
+    // 第一个版本以 unary_op 作用于[first, last)中的每个元素并将结果保存至 result 中
+    // 第二个版本以 binary_op 作用于两个序列的相同位置，结果保存至 result 中
+    /*****************************************************************************************/
+    template <class RandomIter1, class RandomIter2, class UnaryOperation>
+        RandomIter2
+        parallel_transform(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                           RandomIter2 result, UnaryOperation unary_op)
+        {
+            auto body = [&](RandomIter1 b, RandomIter1 e)
+            { mystl::transform(b, e, result + (b - first), unary_op); };
+            mystl::parallel_for_range(pool, first, last, body);
+            return result + (last - first);
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryOperation>
+        RandomIter2
+        parallel_transform(RandomIter1 first, RandomIter1 last,
+                           RandomIter2 result, UnaryOperation unary_op)
+        {
+            return mystl::parallel_transform(thread_pool::default_pool(), first, last, result, unary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOperation>
+        RandomIter3
+        parallel_transform(thread_pool& pool, RandomIter1 first1, RandomIter1 last1,
+                           RandomIter2 first2, RandomIter3 result, BinaryOperation binary_op)
+        {
+            auto body = [&](RandomIter1 b, RandomIter1 e)
+            { mystl::transform(b, e, first2 + (b - first1), result + (b - first1), binary_op); };
+            mystl::parallel_for_range(pool, first1, last1, body);
+            return result + (last1 - first1);
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOperation>
+        RandomIter3
+        parallel_transform(RandomIter1 first1, RandomIter1 last1,
+                           RandomIter2 first2, RandomIter3 result, BinaryOperation binary_op)
+        {
+            return mystl::parallel_transform(thread_pool::default_pool(), first1, last1,
+                                             first2, result, binary_op);
+        }
+
+    /*****************************************************************************************/
+    // parallel_count / parallel_count_if
+    // 并行统计[first, last)内等于 value / 令 unary_pred 为 true 的元素个数
+    /*****************************************************************************************/
+    template <class RandomIter, class UnaryPredicate>
+        size_t parallel_count_if(thread_pool& pool, RandomIter first, RandomIter last,
+                                 UnaryPredicate unary_pred)
+        {
+            auto map = [&](RandomIter b, RandomIter e) { return mystl::count_if(b, e, unary_pred); };
+            mystl::plus<size_t> combine;
+            return mystl::parallel_map_reduce(pool, first, last, map, combine);
+        }
+
+    template <class RandomIter, class UnaryPredicate>
+        size_t parallel_count_if(RandomIter first, RandomIter last, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_count_if(thread_pool::default_pool(), first, last, unary_pred);
+        }
+
+    template <class RandomIter, class T>
+        size_t parallel_count(thread_pool& pool, RandomIter first, RandomIter last, const T& value)
+        {
+            auto map = [&](RandomIter b, RandomIter e) { return mystl::count(b, e, value); };
+            mystl::plus<size_t> combine;
+            return mystl::parallel_map_reduce(pool, first, last, map, combine);
+        }
+
+    template <class RandomIter, class T>
+        size_t parallel_count(RandomIter first, RandomIter last, const T& value)
+        {
+            return mystl::parallel_count(thread_pool::default_pool(), first, last, value);
+        }
+
+    /*****************************************************************************************/
+    // parallel_any_of / parallel_all_of / parallel_none_of
+    // 某个小区间找到结果后，其余尚未开始的小区间直接跳过
+    /*****************************************************************************************/
+    template <class RandomIter, class UnaryPredicate>
+        bool parallel_any_of(thread_pool& pool, RandomIter first, RandomIter last,
+                             UnaryPredicate unary_pred)
+        {
+            std::atomic<bool> found(false);
+            auto body = [&](RandomIter b, RandomIter e)
+            {
+                if (!found.load(std::memory_order_relaxed) && mystl::any_of(b, e, unary_pred))
+                    found.store(true, std::memory_order_relaxed);
+            };
+            mystl::parallel_for_range(pool, first, last, body);
+            return found.load();
+        }
+
+    template <class RandomIter, class UnaryPredicate>
+        bool parallel_any_of(RandomIter first, RandomIter last, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_any_of(thread_pool::default_pool(), first, last, unary_pred);
+        }
+
+    template <class RandomIter, class UnaryPredicate>
+        bool parallel_all_of(thread_pool& pool, RandomIter first, RandomIter last,
+                             UnaryPredicate unary_pred)
+        {
+            auto not_pred = [&](const typename iterator_traits<RandomIter>::value_type& x)
+            { return !unary_pred(x); };
+            return !mystl::parallel_any_of(pool, first, last, not_pred);
+        }
+
+    template <class RandomIter, class UnaryPredicate>
+        bool parallel_all_of(RandomIter first, RandomIter last, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_all_of(thread_pool::default_pool(), first, last, unary_pred);
+        }
+
+    template <class RandomIter, class UnaryPredicate>
+        bool parallel_none_of(thread_pool& pool, RandomIter first, RandomIter last,
+                              UnaryPredicate unary_pred)
+        {
+            return !mystl::parallel_any_of(pool, first, last, unary_pred);
+        }
+
+    template <class RandomIter, class UnaryPredicate>
+        bool parallel_none_of(RandomIter first, RandomIter last, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_none_of(thread_pool::default_pool(), first, last, unary_pred);
+        }
+
+    /*****************************************************************************************/
+    // parallel_sort
+    // 并行快速排序：以三点中值为枢轴分割区间，两个子区间并行排序
+    // 子区间不超过 grain_size 或分割深度达到限制时，改用串行的 mystl::sort
+    /*****************************************************************************************/
+    template <class RandomIter, class Size, class Compared>
+        void parallel_sort_aux(thread_pool& pool, RandomIter first, RandomIter last,
+                               Size depth_limit, Compared& comp)
+        {
+            if (depth_limit == 0 || pool.run_inline(static_cast<size_t>(last - first)))
+            {
+                mystl::sort(first, last, comp);
+                return;
+            }
+            --depth_limit;
+            auto pivot = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1), comp);
+            auto cut = mystl::unchecked_partition(first, last, pivot, comp);
+            pool.invoke([&]() { mystl::parallel_sort_aux(pool, first, cut, depth_limit, comp); },
+                        [&]() { mystl::parallel_sort_aux(pool, cut, last, depth_limit, comp); });
+        }
+
+    template <class RandomIter, class Compared>
+        void parallel_sort(thread_pool& pool, RandomIter first, RandomIter last, Compared comp)
+        {
+            if (first != last)
+                mystl::parallel_sort_aux(pool, first, last, slg2(last - first) * 2, comp);
+        }
+
+    template <class RandomIter, class Compared>
+        void parallel_sort(RandomIter first, RandomIter last, Compared comp)
+        {
+            mystl::parallel_sort(thread_pool::default_pool(), first, last, comp);
+        }
+
+    template <class RandomIter>
+        void parallel_sort(thread_pool& pool, RandomIter first, RandomIter last)
+        {
+            mystl::parallel_sort(pool, first, last,
+                                 mystl::less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template <class RandomIter>
+        void parallel_sort(RandomIter first, RandomIter last)
+        {
+            mystl::parallel_sort(thread_pool::default_pool(), first, last);
+        }
+
+    /*****************************************************************************************/
+    // parallel_merge
+    // 并行合并两个有序区间到 result，相等元素中来自第一个区间的排在前面
+    // 每次取较长区间的中点，在另一个区间中二分查找分割点，两侧独立地合并
+    // parallel_merge_aux 的最后一个参数为 m_true_type 时移动元素，为 m_false_type 时复制元素
+    /*****************************************************************************************/
+    // 与 mystl::merge 相同，但把元素移动到 result
+    template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+        OutputIter
+        move_merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                   OutputIter result, Compared comp)
+        {
+            for (; first1 != last1 && first2 != last2; ++result)
+            {
+                if (comp(*first2, *first1))
+                {
+                    *result = mystl::move(*first2);
+                    ++first2;
+                }
+                else
+                {
+                    *result = mystl::move(*first1);
+                    ++first1;
+                }
+            }
+            result = mystl::move(first1, last1, result);
+            return mystl::move(first2, last2, result);
+        }
+
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+        OutputIter
+        serial_merge(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                     OutputIter result, Compared& comp, m_false_type)
+        {
+            return mystl::merge(first1, last1, first2, last2, result, comp);
+        }
+
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+        OutputIter
+        serial_merge(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                     OutputIter result, Compared& comp, m_true_type)
+        {
+            return mystl::move_merge(first1, last1, first2, last2, result, comp);
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared, class MoveTag>
+        RandomIter3
+        parallel_merge_aux(thread_pool& pool, RandomIter1 first1, RandomIter1 last1,
+                           RandomIter2 first2, RandomIter2 last2, RandomIter3 result,
+                           Compared& comp, MoveTag tag)
+        {
+            const auto len1 = last1 - first1;
+            const auto len2 = last2 - first2;
+            if (pool.run_inline(static_cast<size_t>(len1 + len2)))
+                return mystl::serial_merge(first1, last1, first2, last2, result, comp, tag);
+            RandomIter1 cut1 = first1;
+            RandomIter2 cut2 = first2;
+            if (len1 >= len2)
+            {
+                cut1 = first1 + len1 / 2;
+                cut2 = mystl::lower_bound(first2, last2, *cut1, comp);
+            }
+            else
+            {
+                cut2 = first2 + len2 / 2;
+                cut1 = mystl::upper_bound(first1, last1, *cut2, comp);
+            }
+            RandomIter3 out = result + (cut1 - first1) + (cut2 - first2);
+            pool.invoke([&]() { mystl::parallel_merge_aux(pool, first1, cut1, first2, cut2, result, comp, tag); },
+                        [&]() { mystl::parallel_merge_aux(pool, cut1, last1, cut2, last2, out, comp, tag); });
+            return result + (len1 + len2);
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+        RandomIter3
+        parallel_merge(thread_pool& pool, RandomIter1 first1, RandomIter1 last1,
+                       RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compared comp)
+        {
+            return mystl::parallel_merge_aux(pool, first1, last1, first2, last2, result,
+                                             comp, m_false_type());
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+        RandomIter3
+        parallel_merge(RandomIter1 first1, RandomIter1 last1,
+                       RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compared comp)
+        {
+            return mystl::parallel_merge(thread_pool::default_pool(), first1, last1,
+                                         first2, last2, result, comp);
+        }
+
+    /*****************************************************************************************/
+    // parallel_stable_sort
+    // 并行归并排序：两半并行排序，移动到缓冲区后再并行合并回原区间
+    // 缓冲区由 scratch_buffer 一次申请整个区间的大小，申请失败时抛出 std::bad_alloc
+    /*****************************************************************************************/
+    template <class RandomIter, class Pointer, class Compared>
+        void parallel_merge_sort(thread_pool& pool, RandomIter first, RandomIter last,
+                                 Pointer buffer, Compared& comp)
+        {
+            const auto len = last - first;
+            if (pool.run_inline(static_cast<size_t>(len)))
+            {
+                mystl::stable_sort(first, last, comp);
+                return;
+            }
+            const auto half = len / 2;
+            const RandomIter middle = first + half;
+            pool.invoke([&]() { mystl::parallel_merge_sort(pool, first, middle, buffer, comp); },
+                        [&]() { mystl::parallel_merge_sort(pool, middle, last, buffer + half, comp); });
+            auto move_body = [&](RandomIter b, RandomIter e) { mystl::move(b, e, buffer + (b - first)); };
+            mystl::parallel_for_range(pool, first, last, move_body);
+            mystl::parallel_merge_aux(pool, buffer, buffer + half, buffer + half, buffer + len, first,
+                                      comp, m_true_type());
+        }
+
+    template <class RandomIter, class T, class Compared>
+        void parallel_stable_sort_aux(thread_pool& pool, RandomIter first, RandomIter last,
+                                      T*, Compared& comp)
+        {
+            scratch_buffer<T> buf(first, static_cast<size_t>(last - first));
+            mystl::parallel_merge_sort(pool, first, last, buf.begin(), comp);
+        }
+
+    template <class RandomIter, class Compared>
+        void parallel_stable_sort(thread_pool& pool, RandomIter first, RandomIter last, Compared comp)
+        {
+            if (pool.run_inline(static_cast<size_t>(last - first)))
+                mystl::stable_sort(first, last, comp);
+            else
+                mystl::parallel_stable_sort_aux(pool, first, last, value_type(first), comp);
+        }
+
+    template <class RandomIter, class Compared>
+        void parallel_stable_sort(RandomIter first, RandomIter last, Compared comp)
+        {
+            mystl::parallel_stable_sort(thread_pool::default_pool(), first, last, comp);
+        }
+
+    template <class RandomIter>
+        void parallel_stable_sort(thread_pool& pool, RandomIter first, RandomIter last)
+        {
+            mystl::parallel_stable_sort(pool, first, last,
+                                        mystl::less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template <class RandomIter>
+        void parallel_stable_sort(RandomIter first, RandomIter last)
+        {
+            mystl::parallel_stable_sort(thread_pool::default_pool(), first, last);
+        }
+
+    /*****************************************************************************************/
+    // parallel_partial_sort
+    // 先用 nth_element 把最小的 middle - first 个元素分割到前面，再对这一部分做并行排序
+    /*****************************************************************************************/
+    template <class RandomIter, class Compared>
+        void parallel_partial_sort(thread_pool& pool, RandomIter first, RandomIter middle,
+                                   RandomIter last, Compared comp)
+        {
+            if (first == middle)
+                return;
+            if (pool.run_inline(static_cast<size_t>(last - first)))
+            {
+                mystl::partial_sort(first, middle, last, comp);
+                return;
+            }
+            if (middle != last)
+                mystl::nth_element(first, middle - 1, last, comp);
+            mystl::parallel_sort(pool, first, middle, comp);
+        }
+
+    template <class RandomIter, class Compared>
+        void parallel_partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp)
+        {
+            mystl::parallel_partial_sort(thread_pool::default_pool(), first, middle, last, comp);
+        }
+
+    template <class RandomIter>
+        void parallel_partial_sort(thread_pool& pool, RandomIter first, RandomIter middle, RandomIter last)
+        {
+            mystl::parallel_partial_sort(pool, first, middle, last,
+                                         mystl::less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template <class RandomIter>
+        void parallel_partial_sort(RandomIter first, RandomIter middle, RandomIter last)
+        {
+            mystl::parallel_partial_sort(thread_pool::default_pool(), first, middle, last);
+        }
+
+    /*****************************************************************************************/
+    // parallel_multiway_merge
+    // 并行合并多个有序区间到 result，结果与 multiway_merge 相同
+    // 每次在所有区间中找出合并结果中间位置对应的分割点，分割点两侧独立地合并
+    /*****************************************************************************************/
+    // 在 runs 中找出分割点 split，使每个区间的前 split[j] 个元素恰好是合并结果的前 rank 个元素
+    // 元素按 (值, 区间序号, 位置) 的顺序比较，与 multiway_merge 的稳定顺序一致
+    // 每一轮取窗口最大的区间的中点为枢轴，统计它在所有区间中的名次，据此缩小所有区间的窗口
+    template <class RandomIter, class Compared>
+        void multiway_split(const mystl::vector<mystl::pair<RandomIter, RandomIter>>& runs,
+                            size_t rank, mystl::vector<size_t>& split, Compared comp)
+        {
+            const size_t k = runs.size();
+            mystl::vector<size_t> lo(k, 0);
+            mystl::vector<size_t> hi(k, 0);
+            mystl::vector<size_t> pos(k, 0);
+            for (size_t j = 0; j < k; ++j)
+                hi[j] = static_cast<size_t>(runs[j].second - runs[j].first);
+            while (true)
+            {
+                size_t i = 0;
+                size_t width = 0;
+                for (size_t j = 0; j < k; ++j)
+                {
+                    if (hi[j] - lo[j] > width)
+                    {
+                        width = hi[j] - lo[j];
+                        i = j;
+                    }
+                }
+                if (width == 0)
+                    break;
+                const size_t p = lo[i] + width / 2;
+                const auto& pivot = runs[i].first[p];
+                size_t pivot_rank = 0;  // 合并结果中排在枢轴之前的元素个数
+                for (size_t j = 0; j < k; ++j)
+                {
+                    if (j == i)
+                        pos[j] = p;
+                    else if (j < i)
+                        pos[j] = static_cast<size_t>(mystl::upper_bound(runs[j].first, runs[j].second,
+                                                                        pivot, comp) - runs[j].first);
+                    else
+                        pos[j] = static_cast<size_t>(mystl::lower_bound(runs[j].first, runs[j].second,
+                                                                        pivot, comp) - runs[j].first);
+                    pivot_rank += pos[j];
+                }
+                if (pivot_rank < rank)
+                {  // 枢轴及排在它之前的元素都在分割点左侧
+                    for (size_t j = 0; j < k; ++j)
+                        lo[j] = mystl::max(lo[j], pos[j]);
+                    lo[i] = p + 1;
+                }
+                else
+                {  // 枢轴及排在它之后的元素都在分割点右侧
+                    for (size_t j = 0; j < k; ++j)
+                        hi[j] = mystl::min(hi[j], pos[j]);
+                }
+            }
+            split.swap(lo);
+        }
+
+    template <class RandomIter1, class RandomIter2, class Compared>
+        void parallel_multiway_merge_aux(thread_pool& pool,
+                                         const mystl::vector<mystl::pair<RandomIter1, RandomIter1>>& runs,
+                                         size_t total, RandomIter2 result, Compared comp)
+        {
+            if (pool.run_inline(total))
+            {
+                mystl::multiway_merge(runs.begin(), runs.end(), result, comp);
+                return;
+            }
+            const size_t half = total / 2;
+            mystl::vector<size_t> split;
+            mystl::multiway_split(runs, half, split, comp);
+            mystl::vector<mystl::pair<RandomIter1, RandomIter1>> left;
+            mystl::vector<mystl::pair<RandomIter1, RandomIter1>> right;
+            left.reserve(runs.size());
+            right.reserve(runs.size());
+            for (size_t j = 0; j < runs.size(); ++j)
+            {
+                RandomIter1 cut = runs[j].first + split[j];
+                if (runs[j].first != cut)
+                    left.push_back(mystl::pair<RandomIter1, RandomIter1>(runs[j].first, cut));
+                if (cut != runs[j].second)
+                    right.push_back(mystl::pair<RandomIter1, RandomIter1>(cut, runs[j].second));
+            }
+            pool.invoke([&]() { mystl::parallel_multiway_merge_aux(pool, left, half, result, comp); },
+                        [&]() { mystl::parallel_multiway_merge_aux(pool, right, total - half,
+                                                                   result + half, comp); });
+        }
+
+    template <class RangeIter, class RandomIter, class Compared>
+        RandomIter
+        parallel_multiway_merge(thread_pool& pool, RangeIter first, RangeIter last,
+                                RandomIter result, Compared comp)
+        {
+            typedef typename iterator_traits<RangeIter>::value_type range_type;
+            typedef typename range_type::first_type                 Iter;
+            mystl::vector<mystl::pair<Iter, Iter>> runs;
+            size_t total = 0;
+            for (; first != last; ++first)
+            {
+                if ((*first).first != (*first).second)
+                {
+                    runs.push_back(mystl::pair<Iter, Iter>((*first).first, (*first).second));
+                    total += static_cast<size_t>((*first).second - (*first).first);
+                }
+            }
+            mystl::parallel_multiway_merge_aux(pool, runs, total, result, comp);
+            return result + total;
+        }
+
+    template <class RangeIter, class RandomIter>
+        RandomIter
+        parallel_multiway_merge(thread_pool& pool, RangeIter first, RangeIter last, RandomIter result)
+        {
+            typedef typename iterator_traits<RangeIter>::value_type range_type;
+            typedef typename range_type::first_type                 Iter;
+            typedef typename iterator_traits<Iter>::value_type      value_type;
+            return mystl::parallel_multiway_merge(pool, first, last, result, mystl::less<value_type>());
+        }
+
+    template <class RangeIter, class RandomIter, class Compared>
+        RandomIter
+        parallel_multiway_merge(RangeIter first, RangeIter last, RandomIter result, Compared comp)
+        {
+            return mystl::parallel_multiway_merge(thread_pool::default_pool(), first, last, result, comp);
+        }
+
+    template <class RangeIter, class RandomIter>
+        RandomIter
+        parallel_multiway_merge(RangeIter first, RangeIter last, RandomIter result)
+        {
+            return mystl::parallel_multiway_merge(thread_pool::default_pool(), first, last, result);
+        }
+
+    /*****************************************************************************************/
+    // parallel_for_chunks
+    // 把长度为 n 的区间等分为 k 块，并行地对每一块的序号 c 调用 f(c)
+    // 前缀和与 copy_if 需要知道每一块在区间中的位置，以及各块之间的先后次序，因此按块的序号切分
+    /*****************************************************************************************/
+    // 分块的个数：线程池直接执行时为 1，否则每块不少于 grain_size 个元素，块数不超过线程数的 4 倍
+    inline size_t parallel_chunk_count(thread_pool& pool, size_t n)
+    {
+        if (pool.run_inline(n))
+            return 1;
+        const size_t grain = pool.grain_size();
+        return mystl::min((n + grain - 1) / grain, 4 * (pool.size() + 1));
+    }
+
+    // 第 c 块的起始位置，前 n % k 块各多一个元素
+    inline size_t parallel_chunk_begin(size_t n, size_t k, size_t c)
+    {
+        return c * (n / k) + mystl::min(c, n % k);
+    }
+
+    template <class Function>
+        void parallel_for_chunks(thread_pool& pool, size_t lo, size_t hi, Function& f)
+        {
+            if (hi - lo == 1)
+            {
+                f(lo);
+                return;
+            }
+            const size_t mid = lo + (hi - lo) / 2;
+            pool.invoke([&]() { mystl::parallel_for_chunks(pool, lo, mid, f); },
+                        [&]() { mystl::parallel_for_chunks(pool, mid, hi, f); });
+        }
+
+    /*****************************************************************************************/
+    // parallel_transform_inclusive_scan / parallel_transform_exclusive_scan
+    // parallel_inclusive_scan / parallel_exclusive_scan
+    // 结果与 numeric.h 中对应的串行算法相同，binary_op 必须满足结合律
+    // 分三个阶段完成：
+    // 1. 并行地求出每一块(最后一块除外)的元素之和
+    // 2. 依次累加各块之和，得到每一块之前所有元素与 init 之和
+    // 3. 并行地以该和为初值，对每一块调用串行的前缀和算法
+    // 每个元素被读取两次，result 可以与 first 相同
+    /*****************************************************************************************/
+    // 求出每一块之前所有元素与 init 之和，保存在 offset 中
+    template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+        void parallel_scan_offsets(thread_pool& pool, RandomIter first, size_t n, size_t k,
+                                   mystl::vector<T>& offset, BinaryOp& binary_op, UnaryOp& unary_op)
+        {
+            auto reduce_chunk = [&](size_t c)
+            {
+                if (c + 1 == k)
+                    return;
+                RandomIter b = first + parallel_chunk_begin(n, k, c);
+                RandomIter e = first + parallel_chunk_begin(n, k, c + 1);
+                T sum = unary_op(*b);
+                for (++b; b != e; ++b)
+                    sum = binary_op(sum, unary_op(*b));
+                offset[c + 1] = mystl::move(sum);
+            };
+            mystl::parallel_for_chunks(pool, 0, k, reduce_chunk);
+            for (size_t c = 1; c < k; ++c)
+                offset[c] = binary_op(offset[c - 1], offset[c]);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class UnaryOp, class T>
+        RandomIter2
+        parallel_transform_inclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                          RandomIter2 result, BinaryOp binary_op, UnaryOp unary_op, T init)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            const size_t k = mystl::parallel_chunk_count(pool, n);
+            if (k == 1)
+                return mystl::transform_inclusive_scan(first, last, result, binary_op, unary_op, init);
+            mystl::vector<T> offset(k, init);
+            mystl::parallel_scan_offsets(pool, first, n, k, offset, binary_op, unary_op);
+            auto scan_chunk = [&](size_t c)
+            {
+                const size_t b = parallel_chunk_begin(n, k, c);
+                const size_t e = parallel_chunk_begin(n, k, c + 1);
+                mystl::transform_inclusive_scan(first + b, first + e, result + b,
+                                                binary_op, unary_op, offset[c]);
+            };
+            mystl::parallel_for_chunks(pool, 0, k, scan_chunk);
+            return result + n;
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class UnaryOp>
+        RandomIter2
+        parallel_transform_inclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                          RandomIter2 result, BinaryOp binary_op, UnaryOp unary_op)
+        {
+            if (first == last)
+                return result;
+            auto init = unary_op(*first);
+            *result = init;
+            return mystl::parallel_transform_inclusive_scan(pool, ++first, last, ++result,
+                                                            binary_op, unary_op, init);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class UnaryOp, class T>
+        RandomIter2
+        parallel_transform_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                          BinaryOp binary_op, UnaryOp unary_op, T init)
+        {
+            return mystl::parallel_transform_inclusive_scan(thread_pool::default_pool(), first, last,
+                                                            result, binary_op, unary_op, init);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class UnaryOp>
+        RandomIter2
+        parallel_transform_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                          BinaryOp binary_op, UnaryOp unary_op)
+        {
+            return mystl::parallel_transform_inclusive_scan(thread_pool::default_pool(), first, last,
+                                                            result, binary_op, unary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp, class UnaryOp>
+        RandomIter2
+        parallel_transform_exclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                          RandomIter2 result, T init, BinaryOp binary_op, UnaryOp unary_op)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            const size_t k = mystl::parallel_chunk_count(pool, n);
+            if (k == 1)
+                return mystl::transform_exclusive_scan(first, last, result, init, binary_op, unary_op);
+            mystl::vector<T> offset(k, init);
+            mystl::parallel_scan_offsets(pool, first, n, k, offset, binary_op, unary_op);
+            auto scan_chunk = [&](size_t c)
+            {
+                const size_t b = parallel_chunk_begin(n, k, c);
+                const size_t e = parallel_chunk_begin(n, k, c + 1);
+                mystl::transform_exclusive_scan(first + b, first + e, result + b,
+                                                offset[c], binary_op, unary_op);
+            };
+            mystl::parallel_for_chunks(pool, 0, k, scan_chunk);
+            return result + n;
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp, class UnaryOp>
+        RandomIter2
+        parallel_transform_exclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                          T init, BinaryOp binary_op, UnaryOp unary_op)
+        {
+            return mystl::parallel_transform_exclusive_scan(thread_pool::default_pool(), first, last,
+                                                            result, init, binary_op, unary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+        RandomIter2
+        parallel_inclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result, BinaryOp binary_op, T init)
+        {
+            typedef typename iterator_traits<RandomIter1>::value_type value_type;
+            return mystl::parallel_transform_inclusive_scan(pool, first, last, result, binary_op,
+                                                            mystl::identity<value_type>(), init);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp>
+        RandomIter2
+        parallel_inclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result, BinaryOp binary_op)
+        {
+            typedef typename iterator_traits<RandomIter1>::value_type value_type;
+            return mystl::parallel_transform_inclusive_scan(pool, first, last, result, binary_op,
+                                                            mystl::identity<value_type>());
+        }
+
+    template <class RandomIter1, class RandomIter2>
+        RandomIter2
+        parallel_inclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last, RandomIter2 result)
+        {
+            typedef typename iterator_traits<RandomIter1>::value_type value_type;
+            return mystl::parallel_inclusive_scan(pool, first, last, result, mystl::plus<value_type>());
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+        RandomIter2
+        parallel_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                BinaryOp binary_op, T init)
+        {
+            return mystl::parallel_inclusive_scan(thread_pool::default_pool(), first, last, result,
+                                                  binary_op, init);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp>
+        RandomIter2
+        parallel_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result, BinaryOp binary_op)
+        {
+            return mystl::parallel_inclusive_scan(thread_pool::default_pool(), first, last, result, binary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2>
+        RandomIter2
+        parallel_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result)
+        {
+            return mystl::parallel_inclusive_scan(thread_pool::default_pool(), first, last, result);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+        RandomIter2
+        parallel_exclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result, T init, BinaryOp binary_op)
+        {
+            typedef typename iterator_traits<RandomIter1>::value_type value_type;
+            return mystl::parallel_transform_exclusive_scan(pool, first, last, result, init, binary_op,
+                                                            mystl::identity<value_type>());
+        }
+
+    template <class RandomIter1, class RandomIter2, class T>
+        RandomIter2
+        parallel_exclusive_scan(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result, T init)
+        {
+            return mystl::parallel_exclusive_scan(pool, first, last, result, init, mystl::plus<T>());
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+        RandomIter2
+        parallel_exclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                T init, BinaryOp binary_op)
+        {
+            return mystl::parallel_exclusive_scan(thread_pool::default_pool(), first, last, result,
+                                                  init, binary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T>
+        RandomIter2
+        parallel_exclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result, T init)
+        {
+            return mystl::parallel_exclusive_scan(thread_pool::default_pool(), first, last, result, init);
+        }
+
+    /*****************************************************************************************/
+    // parallel_copy_if / parallel_remove_copy_if / parallel_partition_copy
+    // 结果与对应的串行算法相同，保持元素原来的相对次序
+    // 分三个阶段完成：并行地统计每一块中满足条件的元素个数，依次累加得到每一块的输出位置，
+    // 再并行地把每一块复制到各自的输出位置
+    // 每个元素会被 unary_pred 判断两次，unary_pred 不能有副作用，且两次判断的结果必须相同
+    // 输出区间不能与输入区间重叠
+    /*****************************************************************************************/
+    // 统计每一块中满足条件的元素个数，count[c] 为第 c 块之前满足条件的元素个数，count[k] 为总数
+    template <class RandomIter, class UnaryPredicate>
+        void parallel_count_chunks(thread_pool& pool, RandomIter first, size_t n, size_t k,
+                                   mystl::vector<size_t>& count, UnaryPredicate& unary_pred)
+        {
+            auto count_chunk = [&](size_t c)
+            {
+                count[c + 1] = mystl::count_if(first + parallel_chunk_begin(n, k, c),
+                                               first + parallel_chunk_begin(n, k, c + 1), unary_pred);
+            };
+            mystl::parallel_for_chunks(pool, 0, k, count_chunk);
+            for (size_t c = 1; c <= k; ++c)
+                count[c] += count[c - 1];
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryPredicate>
+        RandomIter2
+        parallel_copy_if(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                         RandomIter2 result, UnaryPredicate unary_pred)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            const size_t k = mystl::parallel_chunk_count(pool, n);
+            if (k == 1)
+                return mystl::copy_if(first, last, result, unary_pred);
+            mystl::vector<size_t> count(k + 1, 0);
+            mystl::parallel_count_chunks(pool, first, n, k, count, unary_pred);
+            auto copy_chunk = [&](size_t c)
+            {
+                mystl::copy_if(first + parallel_chunk_begin(n, k, c),
+                               first + parallel_chunk_begin(n, k, c + 1),
+                               result + count[c], unary_pred);
+            };
+            mystl::parallel_for_chunks(pool, 0, k, copy_chunk);
+            return result + count[k];
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryPredicate>
+        RandomIter2
+        parallel_copy_if(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                         UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_copy_if(thread_pool::default_pool(), first, last, result, unary_pred);
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryPredicate>
+        RandomIter2
+        parallel_remove_copy_if(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result, UnaryPredicate unary_pred)
+        {
+            typedef typename iterator_traits<RandomIter1>::reference reference;
+            return mystl::parallel_copy_if(pool, first, last, result,
+                                           [&](reference x) { return !unary_pred(x); });
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryPredicate>
+        RandomIter2
+        parallel_remove_copy_if(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_remove_copy_if(thread_pool::default_pool(), first, last,
+                                                  result, unary_pred);
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class UnaryPredicate>
+        mystl::pair<RandomIter2, RandomIter3>
+        parallel_partition_copy(thread_pool& pool, RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result_true, RandomIter3 result_false,
+                                UnaryPredicate unary_pred)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            const size_t k = mystl::parallel_chunk_count(pool, n);
+            if (k == 1)
+                return mystl::partition_copy(first, last, result_true, result_false, unary_pred);
+            mystl::vector<size_t> count(k + 1, 0);
+            mystl::parallel_count_chunks(pool, first, n, k, count, unary_pred);
+            auto copy_chunk = [&](size_t c)
+            {
+                // 第 c 块之前不满足条件的元素个数为该块的起始位置减去满足条件的个数
+                const size_t b = parallel_chunk_begin(n, k, c);
+                mystl::partition_copy(first + b, first + parallel_chunk_begin(n, k, c + 1),
+                                      result_true + count[c], result_false + (b - count[c]),
+                                      unary_pred);
+            };
+            mystl::parallel_for_chunks(pool, 0, k, copy_chunk);
+            return mystl::pair<RandomIter2, RandomIter3>(result_true + count[k],
+                                                         result_false + (n - count[k]));
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class UnaryPredicate>
+        mystl::pair<RandomIter2, RandomIter3>
+        parallel_partition_copy(RandomIter1 first, RandomIter1 last,
+                                RandomIter2 result_true, RandomIter3 result_false,
+                                UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_partition_copy(thread_pool::default_pool(), first, last,
+                                                  result_true, result_false, unary_pred);
+        }
+
+    /*****************************************************************************************/
+    // 执行策略版本
+    // seq 调用 algo.h 中的串行算法，par / par_unseq 调用上面的并行算法
+    /*****************************************************************************************/
+
+    // sort
+    template <class RandomIter>
+        void sort(const execution::sequenced_policy&, RandomIter first, RandomIter last)
+        {
+            mystl::sort(first, last);
+        }
+
+    template <class RandomIter, class Compared>
+        void sort(const execution::sequenced_policy&, RandomIter first, RandomIter last, Compared comp)
+        {
+            mystl::sort(first, last, comp);
+        }
+
+    template <class RandomIter>
+        void sort(const execution::parallel_policy& policy, RandomIter first, RandomIter last)
+        {
+            mystl::parallel_sort(policy.pool(), first, last);
+        }
+
+    template <class RandomIter, class Compared>
+        void sort(const execution::parallel_policy& policy, RandomIter first, RandomIter last, Compared comp)
+        {
+            mystl::parallel_sort(policy.pool(), first, last, comp);
+        }
+
+    // stable_sort
+    template <class RandomIter>
+        void stable_sort(const execution::sequenced_policy&, RandomIter first, RandomIter last)
+        {
+            mystl::stable_sort(first, last);
+        }
+
+    template <class RandomIter, class Compared>
+        void stable_sort(const execution::sequenced_policy&, RandomIter first, RandomIter last,
+                         Compared comp)
+        {
+            mystl::stable_sort(first, last, comp);
+        }
+
+    template <class RandomIter>
+        void stable_sort(const execution::parallel_policy& policy, RandomIter first, RandomIter last)
+        {
+            mystl::parallel_stable_sort(policy.pool(), first, last);
+        }
+
+    template <class RandomIter, class Compared>
+        void stable_sort(const execution::parallel_policy& policy, RandomIter first, RandomIter last,
+                         Compared comp)
+        {
+            mystl::parallel_stable_sort(policy.pool(), first, last, comp);
+        }
+
+    // partial_sort
+    template <class RandomIter>
+        void partial_sort(const execution::sequenced_policy&, RandomIter first, RandomIter middle,
+                          RandomIter last)
+        {
+            mystl::partial_sort(first, middle, last);
+        }
+
+    template <class RandomIter, class Compared>
+        void partial_sort(const execution::sequenced_policy&, RandomIter first, RandomIter middle,
+                          RandomIter last, Compared comp)
+        {
+            mystl::partial_sort(first, middle, last, comp);
+        }
+
+    template <class RandomIter>
+        void partial_sort(const execution::parallel_policy& policy, RandomIter first, RandomIter middle,
+                          RandomIter last)
+        {
+            mystl::parallel_partial_sort(policy.pool(), first, middle, last);
+        }
+
+    template <class RandomIter, class Compared>
+        void partial_sort(const execution::parallel_policy& policy, RandomIter first, RandomIter middle,
+                          RandomIter last, Compared comp)
+        {
+            mystl::parallel_partial_sort(policy.pool(), first, middle, last, comp);
+        }
+
+    // multiway_merge
+    template <class RangeIter, class OutputIter>
+        OutputIter multiway_merge(const execution::sequenced_policy&, RangeIter first, RangeIter last,
+                                  OutputIter result)
+        {
+            return mystl::multiway_merge(first, last, result);
+        }
+
+    template <class RangeIter, class OutputIter, class Compared>
+        OutputIter multiway_merge(const execution::sequenced_policy&, RangeIter first, RangeIter last,
+                                  OutputIter result, Compared comp)
+        {
+            return mystl::multiway_merge(first, last, result, comp);
+        }
+
+    template <class RangeIter, class RandomIter>
+        RandomIter multiway_merge(const execution::parallel_policy& policy, RangeIter first,
+                                  RangeIter last, RandomIter result)
+        {
+            return mystl::parallel_multiway_merge(policy.pool(), first, last, result);
+        }
+
+    template <class RangeIter, class RandomIter, class Compared>
+        RandomIter multiway_merge(const execution::parallel_policy& policy, RangeIter first,
+                                  RangeIter last, RandomIter result, Compared comp)
+        {
+            return mystl::parallel_multiway_merge(policy.pool(), first, last, result, comp);
+        }
+
+    // inclusive_scan
+    template <class InputIter, class OutputIter>
+        OutputIter inclusive_scan(const execution::sequenced_policy&, InputIter first, InputIter last,
+                                  OutputIter result)
+        {
+            return mystl::inclusive_scan(first, last, result);
+        }
+
+    template <class InputIter, class OutputIter, class BinaryOp>
+        OutputIter inclusive_scan(const execution::sequenced_policy&, InputIter first, InputIter last,
+                                  OutputIter result, BinaryOp binary_op)
+        {
+            return mystl::inclusive_scan(first, last, result, binary_op);
+        }
+
+    template <class InputIter, class OutputIter, class BinaryOp, class T>
+        OutputIter inclusive_scan(const execution::sequenced_policy&, InputIter first, InputIter last,
+                                  OutputIter result, BinaryOp binary_op, T init)
+        {
+            return mystl::inclusive_scan(first, last, result, binary_op, init);
+        }
+
+    template <class RandomIter1, class RandomIter2>
+        RandomIter2 inclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                   RandomIter1 last, RandomIter2 result)
+        {
+            return mystl::parallel_inclusive_scan(policy.pool(), first, last, result);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp>
+        RandomIter2 inclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                   RandomIter1 last, RandomIter2 result, BinaryOp binary_op)
+        {
+            return mystl::parallel_inclusive_scan(policy.pool(), first, last, result, binary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+        RandomIter2 inclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                   RandomIter1 last, RandomIter2 result, BinaryOp binary_op, T init)
+        {
+            return mystl::parallel_inclusive_scan(policy.pool(), first, last, result, binary_op, init);
+        }
+
+    // exclusive_scan
+    template <class InputIter, class OutputIter, class T>
+        OutputIter exclusive_scan(const execution::sequenced_policy&, InputIter first, InputIter last,
+                                  OutputIter result, T init)
+        {
+            return mystl::exclusive_scan(first, last, result, init);
+        }
+
+    template <class InputIter, class OutputIter, class T, class BinaryOp>
+        OutputIter exclusive_scan(const execution::sequenced_policy&, InputIter first, InputIter last,
+                                  OutputIter result, T init, BinaryOp binary_op)
+        {
+            return mystl::exclusive_scan(first, last, result, init, binary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T>
+        RandomIter2 exclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                   RandomIter1 last, RandomIter2 result, T init)
+        {
+            return mystl::parallel_exclusive_scan(policy.pool(), first, last, result, init);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+        RandomIter2 exclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                   RandomIter1 last, RandomIter2 result, T init, BinaryOp binary_op)
+        {
+            return mystl::parallel_exclusive_scan(policy.pool(), first, last, result, init, binary_op);
+        }
+
+    // transform_inclusive_scan
+    template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp>
+        OutputIter transform_inclusive_scan(const execution::sequenced_policy&, InputIter first,
+                                            InputIter last, OutputIter result,
+                                            BinaryOp binary_op, UnaryOp unary_op)
+        {
+            return mystl::transform_inclusive_scan(first, last, result, binary_op, unary_op);
+        }
+
+    template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp, class T>
+        OutputIter transform_inclusive_scan(const execution::sequenced_policy&, InputIter first,
+                                            InputIter last, OutputIter result,
+                                            BinaryOp binary_op, UnaryOp unary_op, T init)
+        {
+            return mystl::transform_inclusive_scan(first, last, result, binary_op, unary_op, init);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class UnaryOp>
+        RandomIter2 transform_inclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                             RandomIter1 last, RandomIter2 result,
+                                             BinaryOp binary_op, UnaryOp unary_op)
+        {
+            return mystl::parallel_transform_inclusive_scan(policy.pool(), first, last, result,
+                                                            binary_op, unary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class UnaryOp, class T>
+        RandomIter2 transform_inclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                             RandomIter1 last, RandomIter2 result,
+                                             BinaryOp binary_op, UnaryOp unary_op, T init)
+        {
+            return mystl::parallel_transform_inclusive_scan(policy.pool(), first, last, result,
+                                                            binary_op, unary_op, init);
+        }
+
+    // transform_exclusive_scan
+    template <class InputIter, class OutputIter, class T, class BinaryOp, class UnaryOp>
+        OutputIter transform_exclusive_scan(const execution::sequenced_policy&, InputIter first,
+                                            InputIter last, OutputIter result, T init,
+                                            BinaryOp binary_op, UnaryOp unary_op)
+        {
+            return mystl::transform_exclusive_scan(first, last, result, init, binary_op, unary_op);
+        }
+
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp, class UnaryOp>
+        RandomIter2 transform_exclusive_scan(const execution::parallel_policy& policy, RandomIter1 first,
+                                             RandomIter1 last, RandomIter2 result, T init,
+                                             BinaryOp binary_op, UnaryOp unary_op)
+        {
+            return mystl::parallel_transform_exclusive_scan(policy.pool(), first, last, result,
+                                                            init, binary_op, unary_op);
+        }
+
+    // copy_if
+    template <class InputIter, class OutputIter, class UnaryPredicate>
+        OutputIter copy_if(const execution::sequenced_policy&, InputIter first, InputIter last,
+                           OutputIter result, UnaryPredicate unary_pred)
+        {
+            return mystl::copy_if(first, last, result, unary_pred);
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryPredicate>
+        RandomIter2 copy_if(const execution::parallel_policy& policy, RandomIter1 first,
+                            RandomIter1 last, RandomIter2 result, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_copy_if(policy.pool(), first, last, result, unary_pred);
+        }
+
+    // remove_copy_if
+    template <class InputIter, class OutputIter, class UnaryPredicate>
+        OutputIter remove_copy_if(const execution::sequenced_policy&, InputIter first, InputIter last,
+                                  OutputIter result, UnaryPredicate unary_pred)
+        {
+            return mystl::remove_copy_if(first, last, result, unary_pred);
+        }
+
+    template <class RandomIter1, class RandomIter2, class UnaryPredicate>
+        RandomIter2 remove_copy_if(const execution::parallel_policy& policy, RandomIter1 first,
+                                   RandomIter1 last, RandomIter2 result, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_remove_copy_if(policy.pool(), first, last, result, unary_pred);
+        }
+
+    // partition_copy
+    template <class InputIter, class OutputIter1, class OutputIter2, class UnaryPredicate>
+        mystl::pair<OutputIter1, OutputIter2>
+        partition_copy(const execution::sequenced_policy&, InputIter first, InputIter last,
+                       OutputIter1 result_true, OutputIter2 result_false, UnaryPredicate unary_pred)
+        {
+            return mystl::partition_copy(first, last, result_true, result_false, unary_pred);
+        }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class UnaryPredicate>
+        mystl::pair<RandomIter2, RandomIter3>
+        partition_copy(const execution::parallel_policy& policy, RandomIter1 first, RandomIter1 last,
+                       RandomIter2 result_true, RandomIter3 result_false, UnaryPredicate unary_pred)
+        {
+            return mystl::parallel_partition_copy(policy.pool(), first, last,
+                                                  result_true, result_false, unary_pred);
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_PARALLEL_ALGO_H_
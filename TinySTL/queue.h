@@ -0,0 +1,228 @@
+#ifndef TINYSTL_QUEUE_H
+#define TINYSTL_QUEUE_H
+
+#include <cstddef>
+
+#include "deque.h"  // 包含deque的头文件，queue<T, mystl::deque<T>> 的使用者依赖该包含
+#include "ring_buffer.h"  // 包含底层容器growable_ring_buffer的头文件
+#include "vector.h"  // 包含 priority_queue 的底层容器vector的头文件
+#include "functional.h"
+#include "heap_algo.h"
+
+namespace mystl
+{
+
+    // 模板类 queue，T为元素类型，Container为底层容器类型，默认为mystl::growable_ring_buffer<T>：
+    // 元素存放在一块连续的环形缓冲区中，满时容量翻倍，入队、出队不分配节点
+    template <class T, class Container = mystl::growable_ring_buffer<T>>
+    class queue
+    {
+    public:
+        typedef typename Container::value_type      value_type;        // 元素类型
+        typedef typename Container::size_type       size_type;         // 大小类型
+        typedef typename Container::reference       reference;         // 引用类型
+        typedef typename Container::const_reference const_reference;   // 常量引用类型
+
+    protected:
+        Container c;  // 底层容器对象
+
+    public:
+
+        queue() = default;  // 使用默认构造函数
+
+        explicit queue(size_type n)  // 构造指定大小的队列
+            : c(n) {}
+
+        queue(size_type n, const value_type& value)  // 使用指定值构造指定大小的队列
+            : c(n, value)
+        {
+        }
+
+        template <class Iter>
+        queue(Iter first, Iter last)  // 使用迭代器范围构造队列
+            : c(first, last)
+        {
+        }
+
+        queue(std::initializer_list<T> ilist)  // 使用初始化列表构造队列
+            : c(ilist.begin(), ilist.end())
+        {
+        }
+
+        queue(const Container& c_)  // 使用已有容器构造队列
+            : c(c_)
+        {
+        }
+
+        queue(Container&& c_) noexcept(std::is_nothrow_move_constructible<Container>::value)  // 使用已有容器构造队列（移动语义）
+            : c(mystl::move(c_))
+        {
+        }
+
+        queue(const queue& rhs)  // 拷贝构造函数
+            : c(rhs.c)
+        {
+        }
+
+        queue(queue&& rhs) noexcept(std::is_nothrow_move_constructible<Container>::value)  // 移动构造函数
+            : c(mystl::move(rhs.c))
+        {
+        }
+
+        queue& operator=(const queue& rhs)  // 拷贝赋值运算符
+        {
+            c = rhs.c;
+            return *this;
+        }
+
+        queue& operator=(queue&& rhs)  // 移动赋值运算符
+        {
+            c = mystl::move(rhs.c);
+            return *this;
+        }
+
+        queue& operator=(std::initializer_list<T> ilist)  // 赋值运算符重载
+        {
+            c = ilist;
+            return *this;
+        }
+
+        bool empty() const { return c.empty(); }  // 判断队列是否为空
+        size_type size() const { return c.size(); }  // 返回队列的大小
+        reference front() { return c.front(); }  // 返回队头元素的引用
+        const_reference front() const { return c.front(); }  // 返回队头元素的常量引用
+        reference back() { return c.back(); }  // 返回队尾元素的引用
+        const_reference back() const { return c.back(); }  // 返回队尾元素的常量引用
+        template <class... Args>
+        void emplace(Args&& ...args) { c.emplace_back(mystl::forward<Args>(args)...); }  // 在队尾就地构造元素
+        void push(const value_type& value) { c.push_back(value); }  // 入队操作，将元素加入到队尾
+        void push(value_type&& value) { c.push_back(mystl::move(value)); }  // 入队操作（移动语义）
+        void pop() { c.pop_front(); }  // 出队操作，将队头元素删除
+        void shrink_to_fit() { c.shrink_to_fit(); }  // 释放底层容器缓存的空间，底层容器需支持 shrink_to_fit
+        void swap(queue& rhs) noexcept(noexcept(mystl::swap(c, rhs.c)))  // 交换两个队列的内容
+        {
+            mystl::swap(c, rhs.c);
+        }
+        void clear() { c.clear(); }  // 清空队列中的元素
+
+        // 比较运算符重载，按底层容器比较两个队列
+        friend bool operator==(const queue& lhs, const queue& rhs) { return lhs.c == rhs.c; }
+        friend bool operator!=(const queue& lhs, const queue& rhs) { return !(lhs == rhs); }
+        friend bool operator< (const queue& lhs, const queue& rhs) { return lhs.c < rhs.c; }
+        friend bool operator> (const queue& lhs, const queue& rhs) { return rhs < lhs; }
+        friend bool operator<=(const queue& lhs, const queue& rhs) { return !(rhs < lhs); }
+        friend bool operator>=(const queue& lhs, const queue& rhs) { return !(lhs < rhs); }
+
+
+    };
+
+    // 模板类 priority_queue，T为元素类型，Container为底层容器类型，默认为mystl::vector<T>
+    // Compare为比较方式，默认为mystl::less，top() 返回最大的元素
+    // D为堆中每个节点的孩子个数，默认使用4叉堆：树高只有二叉堆的一半，同一节点的孩子相邻，
+    // 元素很多时访问的缓存行更少；D为2时与 push_heap / pop_heap 的二叉堆相同
+    template <class T, class Container = mystl::vector<T>,
+              class Compare = mystl::less<typename Container::value_type>, size_t D = 4>
+    class priority_queue
+    {
+    public:
+        typedef Container                           container_type;    // 底层容器类型
+        typedef Compare                             value_compare;     // 比较方式
+        typedef typename Container::value_type      value_type;        // 元素类型
+        typedef typename Container::size_type       size_type;         // 大小类型
+        typedef typename Container::reference       reference;         // 引用类型
+        typedef typename Container::const_reference const_reference;   // 常量引用类型
+
+        static constexpr size_t arity = D;  // 每个节点的孩子个数
+
+    protected:
+        Container c;     // 底层容器对象
+        Compare   comp;  // 比较方式
+
+    public:
+
+        priority_queue() = default;  // 使用默认构造函数
+
+        explicit priority_queue(const Compare& cmp)  // 使用指定的比较方式构造
+            : c(), comp(cmp)
+        {
+        }
+
+        priority_queue(const Compare& cmp, const Container& c_)  // 使用已有容器构造，并建堆
+            : c(c_), comp(cmp)
+        {
+            mystl::d_ary_make_heap<D>(c.begin(), c.end(), comp);
+        }
+
+        priority_queue(const Compare& cmp, Container&& c_)  // 使用已有容器构造（移动语义），并建堆
+            : c(mystl::move(c_)), comp(cmp)
+        {
+            mystl::d_ary_make_heap<D>(c.begin(), c.end(), comp);
+        }
+
+        template <class Iter>
+        priority_queue(Iter first, Iter last, const Compare& cmp = Compare())  // 使用迭代器范围构造，并建堆
+            : c(first, last), comp(cmp)
+        {
+            mystl::d_ary_make_heap<D>(c.begin(), c.end(), comp);
+        }
+
+        priority_queue(std::initializer_list<T> ilist, const Compare& cmp = Compare())  // 使用初始化列表构造，并建堆
+            : c(ilist.begin(), ilist.end()), comp(cmp)
+        {
+            mystl::d_ary_make_heap<D>(c.begin(), c.end(), comp);
+        }
+
+        priority_queue(const priority_queue& rhs) = default;  // 拷贝构造函数
+        priority_queue(priority_queue&& rhs) = default;       // 移动构造函数
+
+        priority_queue& operator=(const priority_queue& rhs) = default;  // 拷贝赋值运算符
+        priority_queue& operator=(priority_queue&& rhs) = default;       // 移动赋值运算符
+
+        priority_queue& operator=(std::initializer_list<T> ilist)  // 赋值运算符重载
+        {
+            c = ilist;
+            mystl::d_ary_make_heap<D>(c.begin(), c.end(), comp);
+            return *this;
+        }
+
+        bool empty() const { return c.empty(); }  // 判断队列是否为空
+        size_type size() const { return c.size(); }  // 返回队列的大小
+        const_reference top() const { return c.front(); }  // 返回最大元素的常量引用
+        template <class... Args>
+        void emplace(Args&& ...args)  // 在队尾就地构造元素，并上溯到合适的位置
+        {
+            c.emplace_back(mystl::forward<Args>(args)...);
+            mystl::d_ary_push_heap<D>(c.begin(), c.end(), comp);
+        }
+        void push(const value_type& value)  // 入队操作
+        {
+            c.push_back(value);
+            mystl::d_ary_push_heap<D>(c.begin(), c.end(), comp);
+        }
+        void push(value_type&& value)  // 入队操作（移动语义）
+        {
+            c.push_back(mystl::move(value));
+            mystl::d_ary_push_heap<D>(c.begin(), c.end(), comp);
+        }
+        void pop()  // 出队操作，删除最大的元素
+        {
+            mystl::d_ary_pop_heap<D>(c.begin(), c.end(), comp);
+            c.pop_back();
+        }
+        void clear() { c.clear(); }  // 清空队列中的元素
+        void swap(priority_queue& rhs) noexcept(noexcept(mystl::swap(c, rhs.c)) &&
+                                                noexcept(mystl::swap(comp, rhs.comp)))  // 交换两个队列的内容
+        {
+            mystl::swap(c, rhs.c);
+            mystl::swap(comp, rhs.comp);
+        }
+
+    };
+
+    template <class T, class Container, class Compare, size_t D>
+    constexpr size_t priority_queue<T, Container, Compare, D>::arity;
+
+} // namespace mystl
+
+
+#endif //TINYSTL_QUEUE_H
@@ -0,0 +1,159 @@
+#ifndef MYTINYSTL_RADIX_HEAP_H_
+#define MYTINYSTL_RADIX_HEAP_H_
+
+// 这个头文件包含一个类模板 radix_heap
+// 基数堆：键为无符号整数的最小堆，要求插入的键不小于最近一次由 top / pop 得到的最小键(单调)，
+// 适用于 Dijkstra 最短路径、事件模拟等优先级单调递增的场合
+
+// notes:
+//
+// 记 last 为最近一次得到的最小键，键 k 放入第 bit_width(k ^ last) 号桶，即按 k 与 last 最高的不同位分桶，
+// 第 0 号桶中的键都等于 last。push 只需计算一次桶号，为 O(1)
+// top / pop 发现第 0 号桶为空时，找到第一个非空的桶 i，以其中最小的键作为新的 last，把桶 i 的元素重新分配，
+// 它们与新的 last 的最高不同位都低于第 i 位，只会落入编号更小的桶，每个元素至多下降 digits 次，
+// 因此 pop 均摊 O(log C)，C 为键的范围，与比较堆不同，不依赖元素的个数
+// 重新分配推迟到 top / pop 时进行，pop 之后、下一次 top 之前插入的键只需不小于刚刚取出的键，
+// 这正是 Dijkstra 等算法的用法；因此 top() 会修改内部状态，不能在多个线程中同时调用
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+    // 模板类 radix_heap
+    // 参数一代表键的类型，必须是无符号整数，参数二代表与键一起保存的值的类型
+    template <class Key, class T>
+        class radix_heap
+        {
+            static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value,
+                          "radix_heap requires an unsigned integral key");
+
+            public:
+                typedef Key                  key_type;
+                typedef T                    mapped_type;
+                typedef mystl::pair<Key, T>  value_type;
+                typedef const value_type&    const_reference;
+                typedef size_t               size_type;
+
+            private:
+                static constexpr int kBuckets = std::numeric_limits<Key>::digits + 1;
+
+                mutable mystl::vector<value_type> buckets_[kBuckets];
+                size_type                         size_;
+                mutable Key                       last_;  // 最近一次得到的最小键，也是插入的键的下界
+
+            public:
+                // 构造函数
+                radix_heap() noexcept
+                    :size_(0), last_(0)
+                {
+                }
+
+            public:
+                bool      empty() const noexcept { return size_ == 0; }
+                size_type size()  const noexcept { return size_; }
+
+                // 键最小的元素，键相等的元素之间的次序不确定
+                const_reference top() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    if (buckets_[0].empty())
+                        redistribute();
+                    return buckets_[0].back();
+                }
+
+                key_type top_key() const { return top().first; }
+
+                // 插入元素，key 不能小于最近一次由 top / pop 得到的最小键
+                void push(key_type key, const mapped_type& value)
+                {
+                    emplace(key, value);
+                }
+
+                void push(key_type key, mapped_type&& value)
+                {
+                    emplace(key, mystl::move(value));
+                }
+
+                template <class ...Args>
+                    void emplace(key_type key, Args&& ...args)
+                    {
+                        MYSTL_DEBUG(key >= last_);
+                        buckets_[bucket_of(key, last_)].emplace_back(
+                            key, T(mystl::forward<Args>(args)...));
+                        ++size_;
+                    }
+
+                // 删除键最小的元素
+                void pop()
+                {
+                    MYSTL_DEBUG(!empty());
+                    if (buckets_[0].empty())
+                        redistribute();
+                    buckets_[0].pop_back();
+                    --size_;
+                }
+
+                void clear()
+                {
+                    for (int i = 0; i < kBuckets; ++i)
+                        buckets_[i].clear();
+                    size_ = 0;
+                    last_ = 0;
+                }
+
+                void swap(radix_heap& rhs) noexcept
+                {
+                    for (int i = 0; i < kBuckets; ++i)
+                        buckets_[i].swap(rhs.buckets_[i]);
+                    mystl::swap(size_, rhs.size_);
+                    mystl::swap(last_, rhs.last_);
+                }
+
+            private:
+                // x 的二进制位数，x 为 0 时返回 0
+                static int bit_width(Key x) noexcept
+                {
+#if defined(__GNUC__)
+                    return x == 0 ? 0 : 64 - __builtin_clzll(static_cast<unsigned long long>(x));
+#else
+                    int n = 0;
+                    for (; x != 0; x >>= 1)
+                        ++n;
+                    return n;
+#endif
+                }
+
+                static int bucket_of(Key key, Key last) noexcept { return bit_width(key ^ last); }
+
+                void redistribute() const;
+        };
+
+    // 第 0 号桶为空时，把第一个非空的桶中的元素按新的最小键重新分配
+    template <class Key, class T>
+        void radix_heap<Key, T>::redistribute() const
+        {
+            int i = 1;
+            while (buckets_[i].empty())
+                ++i;
+            mystl::vector<value_type>& bucket = buckets_[i];
+            Key new_last = bucket.front().first;
+            for (auto it = bucket.begin() + 1; it != bucket.end(); ++it)
+            {
+                if (it->first < new_last)
+                    new_last = it->first;
+            }
+            last_ = new_last;
+            for (auto it = bucket.begin(); it != bucket.end(); ++it)
+                buckets_[bucket_of(it->first, new_last)].push_back(mystl::move(*it));
+            bucket.clear();
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_RADIX_HEAP_H_
@@ -0,0 +1,271 @@
+#ifndef MYTINYSTL_RANDOM_H_
+#define MYTINYSTL_RANDOM_H_
+
+// 这个头文件包含几个快速的伪随机数引擎，以及产生均匀分布整数的函数 uniform_int
+// splitmix64:         64 位状态，常用于把一个种子展开为其它引擎的初始状态
+// xoshiro256starstar: 256 位状态，周期为 2^256 - 1，通用的首选引擎，
+//                     jump() 可以为每个线程划分出互不重叠的子序列
+// pcg32:              64 位状态，输出 32 位，同一个种子可以选择不同的流(stream)
+
+// notes:
+//
+// 引擎满足 UniformRandomBitGenerator 的要求，也可以与 <random> 中的分布一起使用
+// 相同的种子总是产生相同的序列，便于复现；引擎对象不是线程安全的，每个线程应使用各自的引擎
+// uniform_int(g, n) 使用 Lemire 的乘法-移位方法：以 n 乘随机数取高位，只在低位落入很小的
+// 偏差区间时才需要一次取模并重新抽样，结果严格均匀，平均几乎不需要除法
+// uniform_int 接受输出为完整 32 位或 64 位无符号整数的引擎，包括 std::mt19937 与 std::mt19937_64
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mystl
+{
+
+    inline uint64_t rotl64(uint64_t x, int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 类 : splitmix64
+    // 每次把状态加上一个奇数常量，再对结果做混合，任何种子(包括 0)都可以使用
+    class splitmix64
+    {
+        public:
+            typedef uint64_t result_type;
+
+        private:
+            uint64_t state_;
+
+        public:
+            explicit splitmix64(uint64_t seed = 0) noexcept : state_(seed) {}
+
+            void seed(uint64_t seed) noexcept { state_ = seed; }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return UINT64_MAX; }
+
+            result_type operator()() noexcept
+            {
+                uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 类 : xoshiro256starstar
+    // 初始状态由 splitmix64 从种子展开，保证不会全为 0
+    class xoshiro256starstar
+    {
+        public:
+            typedef uint64_t result_type;
+
+        private:
+            uint64_t s_[4];
+
+        public:
+            explicit xoshiro256starstar(uint64_t seed = 0) noexcept { this->seed(seed); }
+
+            void seed(uint64_t seed) noexcept
+            {
+                splitmix64 sm(seed);
+                for (int i = 0; i < 4; ++i)
+                    s_[i] = sm();
+            }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return UINT64_MAX; }
+
+            result_type operator()() noexcept
+            {
+                const uint64_t result = rotl64(s_[1] * 5, 7) * 9;
+                const uint64_t t = s_[1] << 17;
+                s_[2] ^= s_[0];
+                s_[3] ^= s_[1];
+                s_[1] ^= s_[2];
+                s_[0] ^= s_[3];
+                s_[2] ^= t;
+                s_[3] = rotl64(s_[3], 45);
+                return result;
+            }
+
+            // 相当于调用 2^128 次 operator()，连续调用可以得到 2^128 个互不重叠的子序列
+            void jump() noexcept
+            {
+                static const uint64_t kJump[] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                                  0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+                uint64_t t[4] = { 0, 0, 0, 0 };
+                for (int i = 0; i < 4; ++i)
+                {
+                    for (int b = 0; b < 64; ++b)
+                    {
+                        if (kJump[i] & (1ull << b))
+                        {
+                            for (int j = 0; j < 4; ++j)
+                                t[j] ^= s_[j];
+                        }
+                        (*this)();
+                    }
+                }
+                for (int j = 0; j < 4; ++j)
+                    s_[j] = t[j];
+            }
+
+            friend bool operator==(const xoshiro256starstar& lhs, const xoshiro256starstar& rhs) noexcept
+            {
+                return lhs.s_[0] == rhs.s_[0] && lhs.s_[1] == rhs.s_[1] &&
+                       lhs.s_[2] == rhs.s_[2] && lhs.s_[3] == rhs.s_[3];
+            }
+
+            friend bool operator!=(const xoshiro256starstar& lhs, const xoshiro256starstar& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 类 : pcg32
+    // PCG-XSH-RR：64 位线性同余生成器，输出时以状态的高位决定旋转的位数
+    // stream 选择线性同余的增量，种子相同、stream 不同的两个引擎产生不同的序列
+    class pcg32
+    {
+        public:
+            typedef uint32_t result_type;
+
+        private:
+            uint64_t state_;
+            uint64_t inc_;    // 必须为奇数
+
+        public:
+            explicit pcg32(uint64_t seed = 0x853c49e6748fea9bull,
+                           uint64_t stream = 0xda3e39cb94b95bdbull) noexcept
+            {
+                this->seed(seed, stream);
+            }
+
+            void seed(uint64_t seed, uint64_t stream = 0xda3e39cb94b95bdbull) noexcept
+            {
+                state_ = 0;
+                inc_ = (stream << 1) | 1;
+                (*this)();
+                state_ += seed;
+                (*this)();
+            }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return UINT32_MAX; }
+
+            result_type operator()() noexcept
+            {
+                const uint64_t old = state_;
+                state_ = old * 6364136223846793005ull + inc_;
+                const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+                const uint32_t rot = static_cast<uint32_t>(old >> 59);
+                return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+            }
+
+            friend bool operator==(const pcg32& lhs, const pcg32& rhs) noexcept
+            {
+                return lhs.state_ == rhs.state_ && lhs.inc_ == rhs.inc_;
+            }
+
+            friend bool operator!=(const pcg32& lhs, const pcg32& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+    };
+
+    typedef xoshiro256starstar default_random_engine;
+
+    /*****************************************************************************************/
+    // uniform_int
+    // 返回 [0, n) 中均匀分布的整数，n 必须大于 0
+    /*****************************************************************************************/
+    // 引擎每次输出的随机位数：完整的 32 位或 64 位，其它引擎返回 0
+    template <class URBG>
+        struct random_engine_bits : public std::integral_constant<int,
+            URBG::min() != 0 ? 0 :
+            static_cast<uint64_t>(URBG::max()) == UINT64_MAX ? 64 :
+            static_cast<uint64_t>(URBG::max()) == UINT32_MAX ? 32 : 0> {};
+
+    // 取得 64 位随机数，32 位的引擎调用两次
+    template <class URBG>
+        uint64_t random_u64(URBG& g, std::integral_constant<int, 64>)
+        {
+            return static_cast<uint64_t>(g());
+        }
+
+    template <class URBG>
+        uint64_t random_u64(URBG& g, std::integral_constant<int, 32>)
+        {
+            const uint64_t hi = static_cast<uint32_t>(g());
+            return (hi << 32) | static_cast<uint32_t>(g());
+        }
+
+    // 返回 a * b 的高 64 位与低 64 位
+    inline uint64_t mul_hi_lo(uint64_t a, uint64_t b, uint64_t& lo) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+        lo = static_cast<uint64_t>(p);
+        return static_cast<uint64_t>(p >> 64);
+#else
+        const uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+        const uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+        const uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+        const uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+        lo = (mid << 32) | (ll & 0xffffffffu);
+        return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    }
+
+    template <class URBG>
+        uint64_t uniform_int_aux(URBG& g, uint64_t n, std::integral_constant<int, 64>)
+        {
+            typedef std::integral_constant<int, random_engine_bits<URBG>::value> bits;
+            uint64_t low;
+            uint64_t high = mystl::mul_hi_lo(mystl::random_u64(g, bits()), n, low);
+            if (low < n)
+            { // 低位小于 2^64 mod n 的结果需要舍弃
+                const uint64_t threshold = (0 - n) % n;
+                while (low < threshold)
+                    high = mystl::mul_hi_lo(mystl::random_u64(g, bits()), n, low);
+            }
+            return high;
+        }
+
+    // 32 位的引擎且 n 不超过 2^32 时只需要一次 32 位乘法
+    template <class URBG>
+        uint64_t uniform_int_aux(URBG& g, uint64_t n, std::integral_constant<int, 32>)
+        {
+            if (n > UINT32_MAX)
+                return mystl::uniform_int_aux(g, n, std::integral_constant<int, 64>());
+            const uint32_t range = static_cast<uint32_t>(n);
+            uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(g())) * range;
+            uint32_t low = static_cast<uint32_t>(m);
+            if (low < range)
+            { // 低位小于 2^32 mod n 的结果需要舍弃
+                const uint32_t threshold = static_cast<uint32_t>(0u - range) % range;
+                while (low < threshold)
+                {
+                    m = static_cast<uint64_t>(static_cast<uint32_t>(g())) * range;
+                    low = static_cast<uint32_t>(m);
+                }
+            }
+            return m >> 32;
+        }
+
+    template <class URBG>
+        uint64_t uniform_int(URBG& g, uint64_t n)
+        {
+            static_assert(random_engine_bits<URBG>::value != 0,
+                          "uniform_int requires an engine producing full 32-bit or 64-bit values");
+            return mystl::uniform_int_aux(g, n,
+                std::integral_constant<int, random_engine_bits<URBG>::value>());
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_RANDOM_H_
@@ -0,0 +1,873 @@
+#ifndef MYTINYSTL_RING_BUFFER_H_
+#define MYTINYSTL_RING_BUFFER_H_
+
+// 这个头文件包含了两个模板类 ring_buffer 与 growable_ring_buffer
+// ring_buffer         : 定长环形缓冲区，满时拒绝插入
+// growable_ring_buffer: 满时容量翻倍的环形缓冲区，作为 queue 的默认底层容器
+
+// notes:
+//
+// ring_buffer<T, N> 的容量固定为 2 的幂，下标通过与掩码按位与得到，不需要取模
+// N 不为 0 时容量在编译期确定，元素直接存放在对象内部；N 为 0 时容量在运行期指定并向上取整为 2 的幂
+// head_ 与 tail_ 为单调递增的计数器，size() == tail_ - head_，因此容量可以被完全利用
+// 元素在环上最多被分成两段连续空间，read_segments() / write_segments() 返回这两段，
+// push_n / pop_n 按段批量构造、移动元素，对 trivially copyable 的类型会退化为 memmove
+//
+// 异常保证：
+// mystl::ring_buffer<T, N> 满足基本异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_back
+//   * push_back
+//   * try_emplace_back
+//   * try_push_back
+//
+// growable_ring_buffer<T> 在内部的 ring_buffer<T> 满时先构造好新元素，再把容量翻倍，
+// 因此插入的元素引用缓冲区中的元素时也是安全的；它只提供 queue 需要的队尾插入、队头删除操作
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "iterator.h"       // 迭代器相关操作
+#include "memory.h"         // 内存相关操作
+#include "uninitialized.h"  // 未初始化空间上构造元素
+#include "util.h"           // 工具函数
+#include "exceptdef.h"      // 异常定义
+
+namespace mystl
+{
+
+    // 将 n 向上取整为 2 的幂，n 为 0 时返回 0
+    inline size_t ring_buffer_round_up(size_t n) noexcept
+    {
+        if (n == 0)
+            return 0;
+        size_t cap = 1;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    // 一段连续空间
+    template <class T>
+        struct ring_buffer_span
+        {
+            T*     data;  // 起始地址
+            size_t size;  // 元素个数
+
+            T* begin() const noexcept { return data; }
+            T* end()   const noexcept { return data + size; }
+        };
+
+    // 环形缓冲区上的两段连续空间，first 在逻辑上位于 second 之前
+    template <class T>
+        struct ring_buffer_segments
+        {
+            ring_buffer_span<T> first;
+            ring_buffer_span<T> second;
+
+            size_t size() const noexcept { return first.size + second.size; }
+        };
+
+    // ring_buffer 的迭代器设计
+    // pos 为未取模的逻辑位置，解引用时通过掩码映射到缓冲区
+    template <class T, class Ref, class Ptr>
+        struct ring_buffer_iterator : public iterator<random_access_iterator_tag, T>
+    {
+        typedef ring_buffer_iterator<T, T&, T*>             iterator;        // 迭代器类型
+        typedef ring_buffer_iterator<T, const T&, const T*> const_iterator;  // 常量迭代器类型
+        typedef ring_buffer_iterator                        self;            // 迭代器自身类型
+
+        typedef T            value_type;       // 值类型
+        typedef Ptr          pointer;          // 指针类型
+        typedef Ref          reference;        // 引用类型
+        typedef size_t       size_type;        // 大小类型
+        typedef ptrdiff_t    difference_type;  // 差值类型
+
+        T*        buf;   // 缓冲区起始地址
+        size_type mask;  // 容量减一
+        size_type pos;   // 逻辑位置
+
+        // 构造、复制函数
+        ring_buffer_iterator() noexcept
+            :buf(nullptr), mask(0), pos(0) {}
+
+        ring_buffer_iterator(T* b, size_type m, size_type p) noexcept
+            :buf(b), mask(m), pos(p) {}
+
+        ring_buffer_iterator(const iterator& rhs) noexcept
+            :buf(rhs.buf), mask(rhs.mask), pos(rhs.pos) {}
+
+        self& operator=(const iterator& rhs) noexcept
+        {
+            buf = rhs.buf;
+            mask = rhs.mask;
+            pos = rhs.pos;
+            return *this;
+        }
+
+        // 重载运算符
+        reference operator*()  const { return buf[pos & mask]; }
+        pointer   operator->() const { return buf + (pos & mask); }
+
+        difference_type operator-(const self& x) const
+        { return static_cast<difference_type>(pos - x.pos); }
+
+        self& operator++()    { ++pos; return *this; }
+        self  operator++(int) { self tmp = *this; ++pos; return tmp; }
+        self& operator--()    { --pos; return *this; }
+        self  operator--(int) { self tmp = *this; --pos; return tmp; }
+
+        self& operator+=(difference_type n) { pos += n; return *this; }
+        self& operator-=(difference_type n) { pos -= n; return *this; }
+        self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+        self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        // 重载比较操作符
+        bool operator==(const self& rhs) const { return pos == rhs.pos; }
+        bool operator!=(const self& rhs) const { return pos != rhs.pos; }
+        bool operator< (const self& rhs) const { return pos - rhs.pos > (~size_type(0) >> 1); }
+        bool operator> (const self& rhs) const { return rhs < *this; }
+        bool operator<=(const self& rhs) const { return !(rhs < *this); }
+        bool operator>=(const self& rhs) const { return !(*this < rhs); }
+    };
+
+    // ring_buffer 的存储：N 不为 0 时使用对象内部的定长数组
+    template <class T, size_t N>
+        class ring_buffer_storage
+        {
+            static_assert((N & (N - 1)) == 0, "ring_buffer capacity must be a power of two");
+
+            protected:
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_[N];
+
+                ring_buffer_storage() noexcept {}
+                explicit ring_buffer_storage(size_t n)
+                { THROW_LENGTH_ERROR_IF(n > N, "ring_buffer<T, N>'s capacity is fixed"); }
+
+                T*       buf()       noexcept { return reinterpret_cast<T*>(storage_); }
+                const T* buf() const noexcept { return reinterpret_cast<const T*>(storage_); }
+
+                static constexpr size_t cap()  noexcept { return N; }
+                static constexpr size_t mask() noexcept { return N - 1; }
+        };
+
+    // ring_buffer 的存储：N 为 0 时容量在运行期确定，从堆上分配
+    template <class T>
+        class ring_buffer_storage<T, 0>
+        {
+            protected:
+                T*     buf_;  // 缓冲区起始地址
+                size_t cap_;  // 缓冲区容量，为 0 或 2 的幂
+
+                ring_buffer_storage() noexcept
+                    :buf_(nullptr), cap_(0) {}
+                explicit ring_buffer_storage(size_t n)
+                    :buf_(nullptr), cap_(ring_buffer_round_up(n))
+                {
+                    if (cap_ != 0)
+                        buf_ = mystl::allocator<T>::allocate(cap_);
+                }
+                ~ring_buffer_storage()
+                { mystl::allocator<T>::deallocate(buf_, cap_); }
+
+                T*       buf()       noexcept { return buf_; }
+                const T* buf() const noexcept { return buf_; }
+
+                size_t cap()  const noexcept { return cap_; }
+                size_t mask() const noexcept { return cap_ == 0 ? 0 : cap_ - 1; }
+        };
+
+    // 模板类 ring_buffer
+    // 模板参数 T 代表元素类型，N 代表编译期容量，为 0 时容量在运行期指定
+    template <class T, size_t N = 0>
+        class ring_buffer : private ring_buffer_storage<T, N>
+        {
+            private:
+                typedef ring_buffer_storage<T, N> base;
+
+            public:
+                // ring_buffer 的嵌套型别定义
+                typedef mystl::allocator<T>                      allocator_type;  // 分配器类型
+                typedef mystl::allocator<T>                      data_allocator;  // 数据分配器类型
+
+                typedef typename allocator_type::value_type      value_type;       // 数据类型
+                typedef typename allocator_type::pointer         pointer;          // 指针类型
+                typedef typename allocator_type::const_pointer   const_pointer;    // 常量指针类型
+                typedef typename allocator_type::reference       reference;        // 引用类型
+                typedef typename allocator_type::const_reference const_reference;  // 常量引用类型
+                typedef typename allocator_type::size_type       size_type;        // 大小类型
+                typedef typename allocator_type::difference_type difference_type;  // 差值类型
+
+                typedef ring_buffer_iterator<T, T&, T*>             iterator;                // 迭代器类型
+                typedef ring_buffer_iterator<T, const T&, const T*> const_iterator;          // 常量迭代器类型
+                typedef mystl::reverse_iterator<iterator>           reverse_iterator;        // 反向迭代器类型
+                typedef mystl::reverse_iterator<const_iterator>     const_reverse_iterator;  // 常量反向迭代器类型
+
+                typedef ring_buffer_span<T>                      span_type;        // 一段连续空间
+                typedef ring_buffer_segments<T>                  segments_type;    // 两段连续空间
+
+                allocator_type get_allocator() { return allocator_type(); }  // 获取分配器实例
+
+            private:
+                size_type head_;  // 第一个元素的逻辑位置
+                size_type tail_;  // 最后一个元素的下一逻辑位置
+
+            public:
+                // 构造、复制、移动、析构函数
+                ring_buffer() noexcept
+                    :base(), head_(0), tail_(0) {}
+
+                // 创建一个容量至少为 n 的空 ring_buffer，N 不为 0 时 n 不能超过 N
+                explicit ring_buffer(size_type n)
+                    :base(n), head_(0), tail_(0) {}
+
+                ring_buffer(std::initializer_list<value_type> ilist)
+                    :base(ilist.size()), head_(0), tail_(0)
+                { push_n(ilist.begin(), ilist.size()); }
+
+                ring_buffer(const ring_buffer& rhs)
+                    :base(rhs.capacity()), head_(0), tail_(0)
+                { copy_init(rhs); }
+
+                ring_buffer(ring_buffer&& rhs) noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value)
+                    :base(), head_(0), tail_(0)
+                { move_init(rhs, m_bool_constant<N == 0>()); }
+
+                ring_buffer& operator=(const ring_buffer& rhs);
+                ring_buffer& operator=(ring_buffer&& rhs) noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value);
+
+                ~ring_buffer()
+                { clear(); }
+
+            public:
+                // 迭代器相关操作
+                iterator               begin()         noexcept
+                { return iterator(this->buf(), this->mask(), head_); }
+                const_iterator         begin()   const noexcept
+                { return const_iterator(const_cast<T*>(this->buf()), this->mask(), head_); }
+                iterator               end()           noexcept
+                { return iterator(this->buf(), this->mask(), tail_); }
+                const_iterator         end()     const noexcept
+                { return const_iterator(const_cast<T*>(this->buf()), this->mask(), tail_); }
+
+                reverse_iterator       rbegin()        noexcept
+                { return reverse_iterator(end()); }
+                const_reverse_iterator rbegin()  const noexcept
+                { return const_reverse_iterator(end()); }
+                reverse_iterator       rend()          noexcept
+                { return reverse_iterator(begin()); }
+                const_reverse_iterator rend()    const noexcept
+                { return const_reverse_iterator(begin()); }
+
+                const_iterator         cbegin()  const noexcept
+                { return begin(); }
+                const_iterator         cend()    const noexcept
+                { return end(); }
+                const_reverse_iterator crbegin() const noexcept
+                { return rbegin(); }
+                const_reverse_iterator crend()   const noexcept
+                { return rend(); }
+
+                // 容量相关操作
+                bool      empty()    const noexcept { return head_ == tail_; }
+                bool      full()     const noexcept { return size() == capacity(); }
+                size_type size()     const noexcept { return tail_ - head_; }
+                size_type capacity() const noexcept { return this->cap(); }
+                size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+                size_type available() const noexcept { return capacity() - size(); }
+
+                // 调整容量，仅对运行期容量的 ring_buffer 有效，已有元素按顺序搬到新缓冲区
+                void      reserve(size_type n);
+                void      shrink_to_fit();
+
+                // 访问元素相关操作
+                reference operator[](size_type n)
+                {
+                    MYSTL_DEBUG(n < size());
+                    return this->buf()[(head_ + n) & this->mask()];
+                }
+                const_reference operator[](size_type n) const
+                {
+                    MYSTL_DEBUG(n < size());
+                    return this->buf()[(head_ + n) & this->mask()];
+                }
+                reference at(size_type n)
+                {
+                    THROW_OUT_OF_RANGE_IF(!(n < size()), "ring_buffer<T>::at() subscript out of range");
+                    return (*this)[n];
+                }
+                const_reference at(size_type n) const
+                {
+                    THROW_OUT_OF_RANGE_IF(!(n < size()), "ring_buffer<T>::at() subscript out of range");
+                    return (*this)[n];
+                }
+
+                reference front()
+                {
+                    MYSTL_DEBUG(!empty());
+                    return this->buf()[head_ & this->mask()];
+                }
+                const_reference front() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return this->buf()[head_ & this->mask()];
+                }
+                reference back()
+                {
+                    MYSTL_DEBUG(!empty());
+                    return this->buf()[(tail_ - 1) & this->mask()];
+                }
+                const_reference back() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return this->buf()[(tail_ - 1) & this->mask()];
+                }
+
+                // 单个元素的入队、出队操作
+                // try_ 版本在缓冲区满或空时返回 false，其余版本在缓冲区满时抛出 length_error
+                template <class... Args>
+                    bool try_emplace_back(Args&& ...args);
+                template <class... Args>
+                    void emplace_back(Args&& ...args);
+
+                bool try_push_back(const value_type& value) { return try_emplace_back(value); }
+                bool try_push_back(value_type&& value)      { return try_emplace_back(mystl::move(value)); }
+                void push_back(const value_type& value)     { emplace_back(value); }
+                void push_back(value_type&& value)          { emplace_back(mystl::move(value)); }
+
+                void pop_front();
+                bool try_pop_front(value_type& value);
+
+                // 批量操作
+                // 两段连续空间：read_segments 为已有元素，write_segments 为尚未构造元素的空闲空间
+                segments_type read_segments()  noexcept;
+                segments_type write_segments() noexcept;
+
+                // 调用者在 write_segments 中按顺序构造了 n 个元素后，调用 commit_write 使其可见
+                void commit_write(size_type n) noexcept;
+                // 析构并移除前 n 个元素，通常在处理完 read_segments 中的元素后调用
+                void commit_read(size_type n);
+
+                // 从 first 开始复制至多 n 个元素到队尾，返回实际放入的元素个数
+                template <class InputIter>
+                    size_type push_n(InputIter first, size_type n);
+                // 将队头至多 n 个元素移动到 result 开始的区间，返回实际取出的元素个数
+                template <class OutputIter>
+                    size_type pop_n(OutputIter result, size_type n);
+
+                void clear();
+                void swap(ring_buffer& rhs) noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value)
+                { swap_aux(rhs, m_bool_constant<N == 0>()); }
+
+            private:
+                // helper functions
+                void copy_init(const ring_buffer& rhs);
+                void move_init(ring_buffer& rhs, m_true_type) noexcept;
+                void move_init(ring_buffer& rhs, m_false_type);
+                void move_assign(ring_buffer& rhs, m_true_type) noexcept;
+                void move_assign(ring_buffer& rhs, m_false_type);
+                template <class InputIter>
+                    void push_n_aux(InputIter first, size_type n, input_iterator_tag);
+                template <class ForwardIter>
+                    void push_n_aux(ForwardIter first, size_type n, forward_iterator_tag);
+                void swap_aux(ring_buffer& rhs, m_true_type) noexcept;
+                void swap_aux(ring_buffer& rhs, m_false_type);
+                void reallocate(size_type n, m_true_type);
+                void reallocate(size_type n, m_false_type);
+        };
+
+    /*****************************************************************************************/
+
+    // 复制赋值运算符
+    template <class T, size_t N>
+        ring_buffer<T, N>& ring_buffer<T, N>::operator=(const ring_buffer& rhs)
+        {
+            if (this != &rhs)
+            {
+                ring_buffer tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+    // 移动赋值运算符
+    template <class T, size_t N>
+        ring_buffer<T, N>& ring_buffer<T, N>::operator=(ring_buffer&& rhs)
+        noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this != &rhs)
+                move_assign(rhs, m_bool_constant<N == 0>());
+            return *this;
+        }
+
+    // 调整容量
+    template <class T, size_t N>
+        void ring_buffer<T, N>::reserve(size_type n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(),
+                                  "n can not larger than max_size() in ring_buffer<T>::reserve(n)");
+            if (n > capacity())
+                reallocate(n, m_bool_constant<N == 0>());
+        }
+
+    // 将容量缩小到能容纳所有元素的最小 2 的幂
+    template <class T, size_t N>
+        void ring_buffer<T, N>::shrink_to_fit()
+        {
+            if (ring_buffer_round_up(size()) < capacity())
+                reallocate(size(), m_bool_constant<N == 0>());
+        }
+
+    // 在队尾就地构造元素，缓冲区满时返回 false
+    template <class T, size_t N>
+        template <class... Args>
+        bool ring_buffer<T, N>::try_emplace_back(Args&& ...args)
+        {
+            if (full())
+                return false;
+            data_allocator::construct(this->buf() + (tail_ & this->mask()), mystl::forward<Args>(args)...);
+            ++tail_;
+            return true;
+        }
+
+    // 在队尾就地构造元素，缓冲区满时抛出 length_error
+    template <class T, size_t N>
+        template <class... Args>
+        void ring_buffer<T, N>::emplace_back(Args&& ...args)
+        {
+            THROW_LENGTH_ERROR_IF(full(), "ring_buffer<T>'s size too big");
+            data_allocator::construct(this->buf() + (tail_ & this->mask()), mystl::forward<Args>(args)...);
+            ++tail_;
+        }
+
+    // 弹出队头元素
+    template <class T, size_t N>
+        void ring_buffer<T, N>::pop_front()
+        {
+            MYSTL_DEBUG(!empty());
+            data_allocator::destroy(this->buf() + (head_ & this->mask()));
+            ++head_;
+        }
+
+    // 将队头元素移动到 value 并弹出，缓冲区为空时返回 false
+    template <class T, size_t N>
+        bool ring_buffer<T, N>::try_pop_front(value_type& value)
+        {
+            if (empty())
+                return false;
+            value = mystl::move(front());
+            pop_front();
+            return true;
+        }
+
+    // 已有元素所在的两段连续空间
+    template <class T, size_t N>
+        typename ring_buffer<T, N>::segments_type
+        ring_buffer<T, N>::read_segments() noexcept
+        {
+            segments_type seg = {{nullptr, 0}, {nullptr, 0}};
+            const size_type n = size();
+            if (n == 0)
+                return seg;
+            const size_type pos = head_ & this->mask();
+            const size_type len1 = mystl::min(n, capacity() - pos);
+            seg.first.data = this->buf() + pos;
+            seg.first.size = len1;
+            if (len1 < n)
+            {
+                seg.second.data = this->buf();
+                seg.second.size = n - len1;
+            }
+            return seg;
+        }
+
+    // 空闲空间所在的两段连续空间
+    template <class T, size_t N>
+        typename ring_buffer<T, N>::segments_type
+        ring_buffer<T, N>::write_segments() noexcept
+        {
+            segments_type seg = {{nullptr, 0}, {nullptr, 0}};
+            const size_type n = available();
+            if (n == 0)
+                return seg;
+            const size_type pos = tail_ & this->mask();
+            const size_type len1 = mystl::min(n, capacity() - pos);
+            seg.first.data = this->buf() + pos;
+            seg.first.size = len1;
+            if (len1 < n)
+            {
+                seg.second.data = this->buf();
+                seg.second.size = n - len1;
+            }
+            return seg;
+        }
+
+    // 使调用者在空闲空间中构造好的 n 个元素可见
+    template <class T, size_t N>
+        void ring_buffer<T, N>::commit_write(size_type n) noexcept
+        {
+            MYSTL_DEBUG(n <= available());
+            tail_ += n;
+        }
+
+    // 析构并移除前 n 个元素
+    template <class T, size_t N>
+        void ring_buffer<T, N>::commit_read(size_type n)
+        {
+            MYSTL_DEBUG(n <= size());
+            segments_type seg = read_segments();
+            const size_type len1 = mystl::min(n, seg.first.size);
+            data_allocator::destroy(seg.first.begin(), seg.first.begin() + len1);
+            if (n > len1)
+                data_allocator::destroy(seg.second.begin(), seg.second.begin() + (n - len1));
+            head_ += n;
+        }
+
+    // 批量复制元素到队尾
+    template <class T, size_t N>
+        template <class InputIter>
+        typename ring_buffer<T, N>::size_type
+        ring_buffer<T, N>::push_n(InputIter first, size_type n)
+        {
+            n = mystl::min(n, available());
+            push_n_aux(first, n, iterator_category(first));
+            return n;
+        }
+
+    // 批量将队头元素移出，每一段连续空间调用一次 move
+    template <class T, size_t N>
+        template <class OutputIter>
+        typename ring_buffer<T, N>::size_type
+        ring_buffer<T, N>::pop_n(OutputIter result, size_type n)
+        {
+            segments_type seg = read_segments();
+            n = mystl::min(n, seg.size());
+            const size_type len1 = mystl::min(n, seg.first.size);
+            result = mystl::move(seg.first.begin(), seg.first.begin() + len1, result);
+            if (n > len1)
+                mystl::move(seg.second.begin(), seg.second.begin() + (n - len1), result);
+            commit_read(n);
+            return n;
+        }
+
+    // 清空 ring_buffer，保留缓冲区
+    template <class T, size_t N>
+        void ring_buffer<T, N>::clear()
+        {
+            commit_read(size());
+            head_ = tail_ = 0;
+        }
+
+    /*****************************************************************************************/
+    // helper function
+
+    template <class T, size_t N>
+        void ring_buffer<T, N>::copy_init(const ring_buffer& rhs)
+        {
+            segments_type seg = const_cast<ring_buffer&>(rhs).read_segments();
+            push_n(seg.first.begin(), seg.first.size);
+            push_n(seg.second.begin(), seg.second.size);
+        }
+
+    // 运行期容量：直接接管 rhs 的缓冲区
+    template <class T, size_t N>
+        void ring_buffer<T, N>::move_init(ring_buffer& rhs, m_true_type) noexcept
+        {
+            this->buf_ = rhs.buf_;
+            this->cap_ = rhs.cap_;
+            head_ = rhs.head_;
+            tail_ = rhs.tail_;
+            rhs.buf_ = nullptr;
+            rhs.cap_ = 0;
+            rhs.head_ = rhs.tail_ = 0;
+        }
+
+    // 编译期容量：逐个移动元素
+    template <class T, size_t N>
+        void ring_buffer<T, N>::move_init(ring_buffer& rhs, m_false_type)
+        {
+            head_ = tail_ = 0;
+            segments_type seg = rhs.read_segments();
+            mystl::uninitialized_move_n(seg.first.begin(), seg.first.size, this->buf());
+            tail_ += seg.first.size;
+            mystl::uninitialized_move_n(seg.second.begin(), seg.second.size, this->buf() + seg.first.size);
+            tail_ += seg.second.size;
+            rhs.clear();
+        }
+
+    // 运行期容量：先接管 rhs 的缓冲区，原有的元素与缓冲区随临时对象释放
+    template <class T, size_t N>
+        void ring_buffer<T, N>::move_assign(ring_buffer& rhs, m_true_type) noexcept
+        {
+            ring_buffer tmp(mystl::move(rhs));
+            swap_aux(tmp, m_true_type());
+        }
+
+    // 编译期容量：析构原有元素后逐个移动
+    template <class T, size_t N>
+        void ring_buffer<T, N>::move_assign(ring_buffer& rhs, m_false_type)
+        {
+            clear();
+            move_init(rhs, m_false_type());
+        }
+
+    // input_iterator_tag 版本：只能遍历一次，逐个构造元素
+    template <class T, size_t N>
+        template <class InputIter>
+        void ring_buffer<T, N>::push_n_aux(InputIter first, size_type n, input_iterator_tag)
+        {
+            for (; n > 0; --n, ++first)
+            {
+                data_allocator::construct(this->buf() + (tail_ & this->mask()), *first);
+                ++tail_;
+            }
+        }
+
+    // forward_iterator_tag 版本：每一段连续空间调用一次 uninitialized_copy_n
+    template <class T, size_t N>
+        template <class ForwardIter>
+        void ring_buffer<T, N>::push_n_aux(ForwardIter first, size_type n, forward_iterator_tag)
+        {
+            segments_type seg = write_segments();
+            const size_type len1 = mystl::min(n, seg.first.size);
+            mystl::uninitialized_copy_n(first, len1, seg.first.data);
+            tail_ += len1;
+            if (n > len1)
+            {
+                mystl::advance(first, len1);
+                mystl::uninitialized_copy_n(first, n - len1, seg.second.data);
+                tail_ += n - len1;
+            }
+        }
+
+    template <class T, size_t N>
+        void ring_buffer<T, N>::swap_aux(ring_buffer& rhs, m_true_type) noexcept
+        {
+            mystl::swap(this->buf_, rhs.buf_);
+            mystl::swap(this->cap_, rhs.cap_);
+            mystl::swap(head_, rhs.head_);
+            mystl::swap(tail_, rhs.tail_);
+        }
+
+    template <class T, size_t N>
+        void ring_buffer<T, N>::swap_aux(ring_buffer& rhs, m_false_type)
+        {
+            ring_buffer tmp(mystl::move(rhs));
+            rhs = mystl::move(*this);
+            *this = mystl::move(tmp);
+        }
+
+    // 运行期容量：分配新缓冲区并按顺序搬移元素，搬移后第一个元素位于缓冲区头部
+    template <class T, size_t N>
+        void ring_buffer<T, N>::reallocate(size_type n, m_true_type)
+        {
+            ring_buffer tmp(n);
+            segments_type seg = read_segments();
+            mystl::uninitialized_move_n(seg.first.begin(), seg.first.size, tmp.buf_);
+            tmp.tail_ += seg.first.size;
+            mystl::uninitialized_move_n(seg.second.begin(), seg.second.size, tmp.buf_ + seg.first.size);
+            tmp.tail_ += seg.second.size;
+            swap(tmp);
+        }
+
+    // 编译期容量：容量不可改变
+    template <class T, size_t N>
+        void ring_buffer<T, N>::reallocate(size_type n, m_false_type)
+        {
+            THROW_LENGTH_ERROR_IF(n > N, "ring_buffer<T, N>'s capacity is fixed");
+        }
+
+    /*****************************************************************************************/
+    // 重载比较操作符
+    template <class T, size_t N>
+        bool operator==(const ring_buffer<T, N>& lhs, const ring_buffer<T, N>& rhs)
+        {
+            return lhs.size() == rhs.size() &&
+                mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+    template <class T, size_t N>
+        bool operator!=(const ring_buffer<T, N>& lhs, const ring_buffer<T, N>& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    // 重载 mystl 的 swap
+    template <class T, size_t N>
+        void swap(ring_buffer<T, N>& lhs, ring_buffer<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+        {
+            lhs.swap(rhs);
+        }
+
+    /*****************************************************************************************/
+    // growable_ring_buffer
+    // 满时容量翻倍的环形缓冲区，元素存放在一个运行期容量的 ring_buffer<T> 中
+    /*****************************************************************************************/
+    constexpr static size_t kGrowableRingInitSize = 8;  // 第一次插入时分配的容量
+
+    template <class T>
+        class growable_ring_buffer
+        {
+            private:
+                typedef ring_buffer<T> buffer_type;
+
+            public:
+                // growable_ring_buffer 的嵌套型别定义
+                typedef typename buffer_type::allocator_type         allocator_type;
+                typedef typename buffer_type::value_type             value_type;
+                typedef typename buffer_type::pointer                pointer;
+                typedef typename buffer_type::const_pointer          const_pointer;
+                typedef typename buffer_type::reference              reference;
+                typedef typename buffer_type::const_reference        const_reference;
+                typedef typename buffer_type::size_type              size_type;
+                typedef typename buffer_type::difference_type        difference_type;
+                typedef typename buffer_type::iterator               iterator;
+                typedef typename buffer_type::const_iterator         const_iterator;
+                typedef typename buffer_type::reverse_iterator       reverse_iterator;
+                typedef typename buffer_type::const_reverse_iterator const_reverse_iterator;
+
+            private:
+                buffer_type buf_;
+
+            public:
+                // 构造、复制、移动函数
+                growable_ring_buffer() noexcept
+                    :buf_() {}
+
+                explicit growable_ring_buffer(size_type n)
+                    :buf_(n)
+                {
+                    for (; n > 0; --n)
+                        buf_.emplace_back();
+                }
+
+                growable_ring_buffer(size_type n, const value_type& value)
+                    :buf_(n)
+                {
+                    for (; n > 0; --n)
+                        buf_.push_back(value);
+                }
+
+                template <class Iter, typename std::enable_if<
+                    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+                    growable_ring_buffer(Iter first, Iter last)
+                    :buf_()
+                    {
+                        for (; first != last; ++first)
+                            emplace_back(*first);
+                    }
+
+                growable_ring_buffer(std::initializer_list<value_type> ilist)
+                    :buf_(ilist)
+                {
+                }
+
+                growable_ring_buffer& operator=(std::initializer_list<value_type> ilist)
+                {
+                    buffer_type tmp(ilist);
+                    buf_.swap(tmp);
+                    return *this;
+                }
+
+            public:
+                // 迭代器相关操作
+                iterator               begin()         noexcept { return buf_.begin(); }
+                const_iterator         begin()   const noexcept { return buf_.begin(); }
+                iterator               end()           noexcept { return buf_.end(); }
+                const_iterator         end()     const noexcept { return buf_.end(); }
+                reverse_iterator       rbegin()        noexcept { return buf_.rbegin(); }
+                const_reverse_iterator rbegin()  const noexcept { return buf_.rbegin(); }
+                reverse_iterator       rend()          noexcept { return buf_.rend(); }
+                const_reverse_iterator rend()    const noexcept { return buf_.rend(); }
+
+                // 容量相关操作
+                bool      empty()    const noexcept { return buf_.empty(); }
+                size_type size()     const noexcept { return buf_.size(); }
+                size_type capacity() const noexcept { return buf_.capacity(); }
+                size_type max_size() const noexcept { return buf_.max_size(); }
+
+                void      reserve(size_type n) { buf_.reserve(n); }
+                void      shrink_to_fit()      { buf_.shrink_to_fit(); }
+
+                // 访问元素相关操作
+                reference       operator[](size_type n)       { return buf_[n]; }
+                const_reference operator[](size_type n) const { return buf_[n]; }
+                reference       front()                       { return buf_.front(); }
+                const_reference front()                 const { return buf_.front(); }
+                reference       back()                        { return buf_.back(); }
+                const_reference back()                  const { return buf_.back(); }
+
+                // 队尾插入、队头删除
+                template <class... Args>
+                    void emplace_back(Args&& ...args)
+                    { // try_emplace_back 在缓冲区满时不会使用参数，因此可以再次转发
+                        if (!buf_.try_emplace_back(mystl::forward<Args>(args)...))
+                            grow_emplace_back(mystl::forward<Args>(args)...);
+                    }
+                void push_back(const value_type& value) { emplace_back(value); }
+                void push_back(value_type&& value)      { emplace_back(mystl::move(value)); }
+
+                void pop_front() { buf_.pop_front(); }
+                void clear()     { buf_.clear(); }
+
+                void swap(growable_ring_buffer& rhs) noexcept { buf_.swap(rhs.buf_); }
+
+            private:
+                // 先在缓冲区外构造新元素，再扩容，args 引用缓冲区中的元素时也是安全的
+                template <class... Args>
+                    void grow_emplace_back(Args&& ...args)
+                    {
+                        value_type tmp(mystl::forward<Args>(args)...);
+                        buf_.reserve(capacity() == 0 ? kGrowableRingInitSize : capacity() * 2);
+                        buf_.emplace_back(mystl::move(tmp));
+                    }
+        };
+
+    // 重载比较操作符
+    template <class T>
+        bool operator==(const growable_ring_buffer<T>& lhs, const growable_ring_buffer<T>& rhs)
+        {
+            return lhs.size() == rhs.size() &&
+                mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+    template <class T>
+        bool operator<(const growable_ring_buffer<T>& lhs, const growable_ring_buffer<T>& rhs)
+        {
+            return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    template <class T>
+        bool operator!=(const growable_ring_buffer<T>& lhs, const growable_ring_buffer<T>& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class T>
+        bool operator>(const growable_ring_buffer<T>& lhs, const growable_ring_buffer<T>& rhs)
+        {
+            return rhs < lhs;
+        }
+
+    template <class T>
+        bool operator<=(const growable_ring_buffer<T>& lhs, const growable_ring_buffer<T>& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class T>
+        bool operator>=(const growable_ring_buffer<T>& lhs, const growable_ring_buffer<T>& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    // 重载 mystl 的 swap
+    template <class T>
+        void swap(growable_ring_buffer<T>& lhs, growable_ring_buffer<T>& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_RING_BUFFER_H_
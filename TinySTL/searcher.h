@@ -0,0 +1,372 @@
+#ifndef MYTINYSTL_SEARCHER_H_
+#define MYTINYSTL_SEARCHER_H_
+
+// 这个头文件包含了子序列查找使用的搜索器，以及接受搜索器的 search 与 find_all
+// default_searcher:              直接调用 mystl::search
+// boyer_moore_horspool_searcher: 只使用坏字符规则，预处理代价小，适合中等长度的模式
+// boyer_moore_searcher:          同时使用坏字符规则与好后缀规则，最坏情况下比较次数更少
+
+// notes:
+//
+// 搜索器在构造时对模式进行预处理，之后可以在多个区间中重复查找，
+// 调用 searcher(first, last) 返回一对迭代器，表示第一次匹配的范围，没有找到时两者都等于 last
+// 搜索器只保存模式的迭代器，使用期间模式必须保持有效
+// 单字节整数类型且使用缺省的 hash / equal_to 时，坏字符表直接以字符为下标，
+// 其它类型使用以 Hash 与 BinaryPred 查找的开放寻址表
+// 模式很短时，default_searcher 在单字节的连续区间上使用 SIMD 首尾字节过滤(simd.h)，通常更快
+
+#include <cstddef>
+#include <type_traits>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+
+namespace mystl
+{
+
+    // 判断坏字符表是否可以直接以元素为下标：单字节整数且使用缺省的 hash 与 equal_to
+    template <class T, class Hash, class BinaryPred>
+        struct searcher_use_direct_table : public m_bool_constant<
+            std::is_integral<T>::value && sizeof(T) == 1 &&
+            std::is_same<Hash, mystl::hash<T>>::value &&
+            std::is_same<BinaryPred, mystl::equal_to<T>>::value> {};
+
+    // --------------------------------------------------------------------------------------
+    // 类模板 : searcher_skip_table
+    // 坏字符表，记录每个元素在模式中(不含最后一个元素)最后一次出现的位置到模式末尾的距离，
+    // 没有出现的元素对应模式的长度
+    template <class RandomIter, class Hash, class BinaryPred, bool Direct>
+        class searcher_skip_table;
+
+    // 单字节元素直接以元素为下标
+    template <class RandomIter, class Hash, class BinaryPred>
+        class searcher_skip_table<RandomIter, Hash, BinaryPred, true>
+        {
+            public:
+                typedef typename iterator_traits<RandomIter>::value_type      value_type;
+                typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+
+            private:
+                difference_type table_[256];
+
+            public:
+                searcher_skip_table(RandomIter first, difference_type m, const Hash&, const BinaryPred&)
+                {
+                    for (size_t i = 0; i < 256; ++i)
+                        table_[i] = m;
+                    for (difference_type i = 0; i + 1 < m; ++i)
+                        table_[static_cast<unsigned char>(first[i])] = m - 1 - i;
+                }
+
+                difference_type operator[](const value_type& value) const
+                { return table_[static_cast<unsigned char>(value)]; }
+        };
+
+    // 其它类型使用线性探测的开放寻址表，表中保存元素在模式中的下标
+    template <class RandomIter, class Hash, class BinaryPred>
+        class searcher_skip_table<RandomIter, Hash, BinaryPred, false>
+        {
+            public:
+                typedef typename iterator_traits<RandomIter>::value_type      value_type;
+                typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+
+            private:
+                RandomIter                     first_;  // 模式的起始位置
+                difference_type                m_;      // 模式的长度
+                size_t                         mask_;   // 桶的个数减一，桶的个数为 2 的幂次
+                mystl::vector<difference_type> index_;  // 元素在模式中的下标，-1 表示空桶
+                mystl::vector<difference_type> skip_;   // 对应的跳跃距离
+                Hash                           hash_;
+                BinaryPred                     pred_;
+
+            public:
+                searcher_skip_table(RandomIter first, difference_type m, const Hash& hf,
+                                    const BinaryPred& pred)
+                    :first_(first), m_(m), mask_(0), hash_(hf), pred_(pred)
+                {
+                    size_t buckets = 8;
+                    while (buckets < 2 * static_cast<size_t>(m))
+                        buckets <<= 1;
+                    mask_ = buckets - 1;
+                    index_.assign(buckets, -1);
+                    skip_.assign(buckets, m);
+                    for (difference_type i = 0; i + 1 < m; ++i)
+                    {  // 相同的元素后出现的覆盖先出现的
+                        size_t h = hash_(first[i]) & mask_;
+                        while (index_[h] != -1 && !pred_(first[index_[h]], first[i]))
+                            h = (h + 1) & mask_;
+                        index_[h] = i;
+                        skip_[h] = m - 1 - i;
+                    }
+                }
+
+                difference_type operator[](const value_type& value) const
+                {
+                    size_t h = hash_(value) & mask_;
+                    while (index_[h] != -1)
+                    {
+                        if (pred_(value, first_[index_[h]]))
+                            return skip_[h];
+                        h = (h + 1) & mask_;
+                    }
+                    return m_;
+                }
+        };
+
+    /*****************************************************************************************/
+    // default_searcher
+    // 使用 mystl::search 查找，不需要预处理，模式的迭代器只需要是前向迭代器
+    /*****************************************************************************************/
+    template <class ForwardIter1,
+              class BinaryPred = mystl::equal_to<typename iterator_traits<ForwardIter1>::value_type>>
+        class default_searcher
+        {
+            private:
+                ForwardIter1 pat_first_;
+                ForwardIter1 pat_last_;
+                BinaryPred   pred_;
+
+            public:
+                default_searcher(ForwardIter1 pat_first, ForwardIter1 pat_last,
+                                 BinaryPred pred = BinaryPred())
+                    :pat_first_(pat_first), pat_last_(pat_last), pred_(pred)
+                {
+                }
+
+                template <class ForwardIter2>
+                    mystl::pair<ForwardIter2, ForwardIter2>
+                    operator()(ForwardIter2 first, ForwardIter2 last) const
+                    {
+                        auto result = search_aux(first, last, std::is_same<BinaryPred,
+                            mystl::equal_to<typename iterator_traits<ForwardIter1>::value_type>>());
+                        if (result == last)
+                            return mystl::pair<ForwardIter2, ForwardIter2>(last, last);
+                        auto match_last = result;
+                        mystl::advance(match_last, mystl::distance(pat_first_, pat_last_));
+                        return mystl::pair<ForwardIter2, ForwardIter2>(result, match_last);
+                    }
+
+            private:
+                // 缺省的 equal_to 使用 operator== 版本的 search，以便使用 SIMD 内核
+                template <class ForwardIter2>
+                    ForwardIter2 search_aux(ForwardIter2 first, ForwardIter2 last, std::true_type) const
+                    { return mystl::search(first, last, pat_first_, pat_last_); }
+
+                template <class ForwardIter2>
+                    ForwardIter2 search_aux(ForwardIter2 first, ForwardIter2 last, std::false_type) const
+                    { return mystl::search(first, last, pat_first_, pat_last_, pred_); }
+        };
+
+    /*****************************************************************************************/
+    // boyer_moore_horspool_searcher
+    // 每次从右向左比较当前窗口，失配时按窗口最后一个元素在坏字符表中的距离向右移动窗口
+    // 平均比较次数约为 N / M，最坏情况为 O(N * M)
+    /*****************************************************************************************/
+    template <class RandomIter1,
+              class Hash = mystl::hash<typename iterator_traits<RandomIter1>::value_type>,
+              class BinaryPred = mystl::equal_to<typename iterator_traits<RandomIter1>::value_type>>
+        class boyer_moore_horspool_searcher
+        {
+            public:
+                typedef typename iterator_traits<RandomIter1>::value_type      value_type;
+                typedef typename iterator_traits<RandomIter1>::difference_type difference_type;
+
+            private:
+                typedef searcher_skip_table<RandomIter1, Hash, BinaryPred,
+                    searcher_use_direct_table<value_type, Hash, BinaryPred>::value> skip_table;
+
+                RandomIter1     pat_first_;
+                difference_type m_;
+                BinaryPred      pred_;
+                skip_table      skip_;
+
+            public:
+                boyer_moore_horspool_searcher(RandomIter1 pat_first, RandomIter1 pat_last,
+                                              Hash hf = Hash(), BinaryPred pred = BinaryPred())
+                    :pat_first_(pat_first), m_(pat_last - pat_first), pred_(pred),
+                    skip_(pat_first, pat_last - pat_first, hf, pred)
+                {
+                }
+
+                template <class RandomIter2>
+                    mystl::pair<RandomIter2, RandomIter2>
+                    operator()(RandomIter2 first, RandomIter2 last) const
+                    {
+                        typedef mystl::pair<RandomIter2, RandomIter2> result_type;
+                        if (m_ == 0)
+                            return result_type(first, first);
+                        if (last - first < m_)
+                            return result_type(last, last);
+                        const RandomIter2 stop = last - m_;  // 最后一个窗口的起始位置
+                        for (RandomIter2 cur = first; ; )
+                        {
+                            difference_type i = m_ - 1;
+                            while (pred_(cur[i], pat_first_[i]))
+                            {
+                                if (i == 0)
+                                    return result_type(cur, cur + m_);
+                                --i;
+                            }
+                            const difference_type shift = skip_[cur[m_ - 1]];
+                            if (stop - cur < shift)
+                                break;
+                            cur += shift;
+                        }
+                        return result_type(last, last);
+                    }
+        };
+
+    /*****************************************************************************************/
+    // boyer_moore_searcher
+    // 在 Horspool 的基础上增加好后缀规则：失配时取两条规则中较大的移动距离
+    // 好后缀表的构造与查找过程参考 Charras 与 Lecroq 的实现，预处理为 O(M)
+    /*****************************************************************************************/
+    template <class RandomIter1,
+              class Hash = mystl::hash<typename iterator_traits<RandomIter1>::value_type>,
+              class BinaryPred = mystl::equal_to<typename iterator_traits<RandomIter1>::value_type>>
+        class boyer_moore_searcher
+        {
+            public:
+                typedef typename iterator_traits<RandomIter1>::value_type      value_type;
+                typedef typename iterator_traits<RandomIter1>::difference_type difference_type;
+
+            private:
+                typedef searcher_skip_table<RandomIter1, Hash, BinaryPred,
+                    searcher_use_direct_table<value_type, Hash, BinaryPred>::value> skip_table;
+
+                RandomIter1                    pat_first_;
+                difference_type                m_;
+                BinaryPred                     pred_;
+                skip_table                     skip_;
+                mystl::vector<difference_type> suffix_shift_;  // 在下标 i 处失配时好后缀规则的移动距离
+
+            public:
+                boyer_moore_searcher(RandomIter1 pat_first, RandomIter1 pat_last,
+                                     Hash hf = Hash(), BinaryPred pred = BinaryPred())
+                    :pat_first_(pat_first), m_(pat_last - pat_first), pred_(pred),
+                    skip_(pat_first, pat_last - pat_first, hf, pred)
+                {
+                    if (m_ > 0)
+                        build_suffix_shift();
+                }
+
+                template <class RandomIter2>
+                    mystl::pair<RandomIter2, RandomIter2>
+                    operator()(RandomIter2 first, RandomIter2 last) const
+                    {
+                        typedef mystl::pair<RandomIter2, RandomIter2> result_type;
+                        if (m_ == 0)
+                            return result_type(first, first);
+                        if (last - first < m_)
+                            return result_type(last, last);
+                        const RandomIter2 stop = last - m_;
+                        for (RandomIter2 cur = first; ; )
+                        {
+                            difference_type i = m_ - 1;
+                            while (pred_(cur[i], pat_first_[i]))
+                            {
+                                if (i == 0)
+                                    return result_type(cur, cur + m_);
+                                --i;
+                            }
+                            // 坏字符规则：让 cur[i] 与它在模式中最后一次出现的位置对齐
+                            const difference_type bad_char = skip_[cur[i]] - (m_ - 1 - i);
+                            const difference_type shift = mystl::max(suffix_shift_[i], bad_char);
+                            if (stop - cur < shift)
+                                break;
+                            cur += shift;
+                        }
+                        return result_type(last, last);
+                    }
+
+            private:
+                void build_suffix_shift();
+        };
+
+    template <class RandomIter1, class Hash, class BinaryPred>
+        void boyer_moore_searcher<RandomIter1, Hash, BinaryPred>::build_suffix_shift()
+        {
+            const difference_type m = m_;
+            // suffix[i] 为以 i 结尾的子串与模式的后缀的最长公共长度
+            mystl::vector<difference_type> suffix(static_cast<size_t>(m));
+            suffix[m - 1] = m;
+            difference_type f = m - 1;
+            difference_type g = m - 1;
+            for (difference_type i = m - 2; i >= 0; --i)
+            {
+                if (i > g && suffix[i + m - 1 - f] < i - g)
+                {
+                    suffix[i] = suffix[i + m - 1 - f];
+                }
+                else
+                {
+                    if (i < g)
+                        g = i;
+                    f = i;
+                    while (g >= 0 && pred_(pat_first_[g], pat_first_[g + m - 1 - f]))
+                        --g;
+                    suffix[i] = f - g;
+                }
+            }
+            suffix_shift_.assign(static_cast<size_t>(m), m);
+            // 匹配的后缀在模式中没有其它出现时，让模式的某个前缀与它的一个后缀对齐
+            difference_type j = 0;
+            for (difference_type i = m - 1; i >= 0; --i)
+            {
+                if (suffix[i] == i + 1)
+                {
+                    for (; j < m - 1 - i; ++j)
+                    {
+                        if (suffix_shift_[j] == m)
+                            suffix_shift_[j] = m - 1 - i;
+                    }
+                }
+            }
+            // 匹配的后缀在模式中的其它位置再次出现时，让最靠右的一次出现与它对齐
+            for (difference_type i = 0; i + 1 < m; ++i)
+                suffix_shift_[m - 1 - suffix[i]] = m - 1 - i;
+        }
+
+    /*****************************************************************************************/
+    // search
+    // 使用搜索器在[first, last)中查找，返回第一次匹配的起始位置，没有找到时返回 last
+    /*****************************************************************************************/
+    template <class ForwardIter, class Searcher>
+        ForwardIter search(ForwardIter first, ForwardIter last, const Searcher& searcher)
+        {
+            return searcher(first, last).first;
+        }
+
+    /*****************************************************************************************/
+    // find_all
+    // 使用搜索器从左到右找出[first, last)中所有互不重叠的匹配，对每个匹配调用 f(match_first, match_last)
+    // 一次匹配结束后从匹配的末尾继续查找，模式为空时在 last 之前的每个位置各匹配一次
+    // 返回匹配的个数
+    /*****************************************************************************************/
+    template <class ForwardIter, class Searcher, class Function>
+        size_t find_all(ForwardIter first, ForwardIter last, const Searcher& searcher, Function f)
+        {
+            size_t n = 0;
+            while (first != last)
+            {
+                auto result = searcher(first, last);
+                if (result.first == last)
+                    break;
+                f(result.first, result.second);
+                ++n;
+                if (result.first == result.second)
+                {
+                    first = result.first;
+                    ++first;
+                }
+                else
+                {
+                    first = result.second;
+                }
+            }
+            return n;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_SEARCHER_H_
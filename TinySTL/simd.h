@@ -0,0 +1,972 @@
+#ifndef MYTINYSTL_SIMD_H_
+#define MYTINYSTL_SIMD_H_
+
+// 这个头文件包含连续区间上的 SIMD 内核，供 find、count、equal、search、min_element、max_element、
+// minmax_element、reduce、transform_reduce 以及 set_intersection 等集合算法分派使用
+// 支持的元素类型为算术类型，x86 上使用 SSE2 / AVX2，其它平台退化为逐个元素的循环
+
+// notes:
+//
+// SSE2 是 x86-64 的基础指令集，总是可用；AVX2 内核通过 target 属性单独编译，
+// 运行时检测 CPU 支持后才会调用，因此不需要以 -mavx2 编译整个程序
+// 定义 MYSTL_NO_SIMD 可以关闭所有 SIMD 内核
+//
+// 比较结果统一转换为按字节的掩码(movemask_epi8)，元素下标为掩码中的位序号除以元素大小
+// 整数按位比较，浮点数使用 IEEE 比较：NaN 不等于任何值，+0.0 等于 -0.0
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(MYSTL_NO_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define MYSTL_HAS_SIMD 1
+#include <immintrin.h>
+#define MYSTL_SIMD_AVX2 __attribute__((target("avx2,popcnt")))
+#else
+#define MYSTL_HAS_SIMD 0
+#endif
+
+#include "type_traits.h"
+
+namespace mystl
+{
+
+    // 判断 T 是否可以使用 SIMD 内核：除 bool 以外的算术类型
+    template <class T>
+        struct is_simd_type : public m_bool_constant<
+            std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+            (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+    // 判断在 [Iter, Iter) 中查找 / 计数类型为 T 的值时是否可以使用 SIMD 内核
+    // Iter 为指向 SIMD 类型的指针，且 T 与元素同为整数，或者是相同的浮点类型
+    template <class Iter, class T>
+        struct is_simd_find : public m_false_type {};
+
+    template <class Tp, class T>
+        struct is_simd_find<Tp*, T> : public m_bool_constant<
+            is_simd_type<typename std::remove_cv<Tp>::type>::value &&
+            ((std::is_integral<Tp>::value && std::is_integral<T>::value &&
+              !std::is_same<T, bool>::value) ||
+             std::is_same<typename std::remove_cv<Tp>::type, T>::value)> {};
+
+    // 判断比较 [Iter1, Iter1) 与 Iter2 开始的区间时是否可以使用 SIMD 内核
+    template <class Iter1, class Iter2>
+        struct is_simd_equal : public m_false_type {};
+
+    template <class Tp, class Up>
+        struct is_simd_equal<Tp*, Up*> : public m_bool_constant<
+            is_simd_type<typename std::remove_cv<Tp>::type>::value &&
+            std::is_same<typename std::remove_cv<Tp>::type,
+                         typename std::remove_cv<Up>::type>::value> {};
+
+    // 判断在 [Iter, Iter) 中查找最值时是否可以使用 SIMD 内核
+    template <class Iter>
+        struct is_simd_minmax : public m_false_type {};
+
+    template <class Tp>
+        struct is_simd_minmax<Tp*> : public is_simd_type<typename std::remove_cv<Tp>::type> {};
+
+    // 判断在 [Iter1, Iter1) 中查找 [Iter2, Iter2) 时是否可以使用 SIMD 内核
+    // 两者都是指向同一种单字节整数类型的指针
+    template <class Iter1, class Iter2>
+        struct is_simd_search : public m_false_type {};
+
+    template <class Tp, class Up>
+        struct is_simd_search<Tp*, Up*> : public m_bool_constant<
+            std::is_integral<Tp>::value && sizeof(Tp) == 1 && !std::is_same<
+                typename std::remove_cv<Tp>::type, bool>::value &&
+            std::is_same<typename std::remove_cv<Tp>::type,
+                         typename std::remove_cv<Up>::type>::value> {};
+
+    // 判断在有序区间 [Iter1, Iter1) 与 [Iter2, Iter2) 之间做集合运算时是否可以使用 SIMD 内核
+    // 两者都是指向同一种 4 字节整数类型的指针
+    template <class Iter1, class Iter2>
+        struct is_simd_set : public m_false_type {};
+
+    template <class Tp, class Up>
+        struct is_simd_set<Tp*, Up*> : public m_bool_constant<
+            std::is_integral<Tp>::value && sizeof(Tp) == 4 &&
+            std::is_same<typename std::remove_cv<Tp>::type,
+                         typename std::remove_cv<Up>::type>::value> {};
+
+    // 判断区间中是否可能存在等于 value 的元素：转换为元素类型后仍与原值相等
+    // 整数超出元素类型的表示范围、或者 value 为 NaN 时，区间内没有与它相等的元素
+    template <class T, class U>
+        bool simd_representable(const U& value)
+        {
+            return static_cast<T>(value) == value;
+        }
+
+    // 逐个位置查找长度为 m(m >= 2)的单字节模式，先比较首字节再比较其余部分
+    template <class T>
+        const T* search_bytes_tail(const T* first, const T* last, const T* pattern, size_t m)
+        {
+            const T* const stop = last - (m - 1);  // 最后一个候选起点之后的位置
+            for (; first < stop; ++first)
+            {
+                if (*first == *pattern && std::memcmp(first + 1, pattern + 1, m - 1) == 0)
+                    return first;
+            }
+            return last;
+        }
+
+    // 在升序区间中跳过所有小于 value 的元素
+    template <class T>
+        const T* skip_less_tail(const T* first, const T* last, T value)
+        {
+            while (first != last && *first < value)
+                ++first;
+            return first;
+        }
+
+#if MYSTL_HAS_SIMD
+
+    // 运行时检测 CPU 是否支持 AVX2
+    inline bool simd_has_avx2() noexcept
+    {
+        static const bool result = []()
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        }();
+        return result;
+    }
+
+    constexpr static size_t kSimdMinMaxBlock = 16;  // 查找最值时每块包含的寄存器个数
+
+    // 按元素的种类选择比较指令的标签
+    struct simd_int8_tag {};
+    struct simd_int16_tag {};
+    struct simd_int32_tag {};
+    struct simd_int64_tag {};
+    struct simd_float_tag {};
+    struct simd_double_tag {};
+
+    template <class T, size_t Size = sizeof(T), bool Float = std::is_floating_point<T>::value>
+        struct simd_tag;
+
+    template <class T> struct simd_tag<T, 1, false> { typedef simd_int8_tag  type; };
+    template <class T> struct simd_tag<T, 2, false> { typedef simd_int16_tag type; };
+    template <class T> struct simd_tag<T, 4, false> { typedef simd_int32_tag type; };
+    template <class T> struct simd_tag<T, 8, false> { typedef simd_int64_tag type; };
+    template <class T> struct simd_tag<T, 4, true>  { typedef simd_float_tag type; };
+    template <class T> struct simd_tag<T, 8, true>  { typedef simd_double_tag type; };
+
+    /*****************************************************************************************/
+    // SSE2 内核
+    /*****************************************************************************************/
+
+    inline __m128i sse2_load(const void* p)
+    {
+        return _mm_loadu_si128(static_cast<const __m128i*>(p));
+    }
+
+    template <class T>
+        __m128i sse2_broadcast(T value)
+        {
+            T lanes[16 / sizeof(T)];
+            for (size_t i = 0; i < 16 / sizeof(T); ++i)
+                lanes[i] = value;
+            return sse2_load(lanes);
+        }
+
+    // 逐个元素比较，返回按字节的相等掩码
+    inline unsigned sse2_eq_mask(__m128i a, __m128i b, simd_int8_tag)
+    { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+
+    inline unsigned sse2_eq_mask(__m128i a, __m128i b, simd_int16_tag)
+    { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b))); }
+
+    inline unsigned sse2_eq_mask(__m128i a, __m128i b, simd_int32_tag)
+    { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b))); }
+
+    inline unsigned sse2_eq_mask(__m128i a, __m128i b, simd_int64_tag)
+    { // SSE2 没有 64 位的相等比较，高低 32 位都相等时 64 位才相等
+        const __m128i eq = _mm_cmpeq_epi32(a, b);
+        const __m128i swapped = _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(eq, swapped)));
+    }
+
+    inline unsigned sse2_eq_mask(__m128i a, __m128i b, simd_float_tag)
+    {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_castps_si128(
+            _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)))));
+    }
+
+    inline unsigned sse2_eq_mask(__m128i a, __m128i b, simd_double_tag)
+    {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_castpd_si128(
+            _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)))));
+    }
+
+    template <class T>
+        const T* sse2_find(const T* first, const T* last, T value)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 16 / sizeof(T);
+            const __m128i v = sse2_broadcast(value);
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+            {
+                const unsigned mask = sse2_eq_mask(sse2_load(first), v, tag());
+                if (mask != 0)
+                    return first + __builtin_ctz(mask) / sizeof(T);
+            }
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    return first;
+            }
+            return last;
+        }
+
+    template <class T>
+        size_t sse2_count(const T* first, const T* last, T value)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 16 / sizeof(T);
+            const __m128i v = sse2_broadcast(value);
+            size_t bytes = 0;  // 相等元素占用的字节数
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+                bytes += __builtin_popcount(sse2_eq_mask(sse2_load(first), v, tag()));
+            size_t n = bytes / sizeof(T);
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    ++n;
+            }
+            return n;
+        }
+
+    template <class T>
+        bool sse2_equal(const T* first1, const T* last1, const T* first2)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 16 / sizeof(T);
+            for (; static_cast<size_t>(last1 - first1) >= lanes; first1 += lanes, first2 += lanes)
+            {
+                if (sse2_eq_mask(sse2_load(first1), sse2_load(first2), tag()) != 0xffffu)
+                    return false;
+            }
+            for (; first1 != last1; ++first1, ++first2)
+            {
+                if (!(*first1 == *first2))
+                    return false;
+            }
+            return true;
+        }
+
+    // 首尾字节过滤：同时比较每个候选起点处的字节与模式的首字节、
+    // 候选起点后 m - 1 处的字节与模式的尾字节，两者都相等的位置才比较中间的部分
+    template <class T>
+        const T* sse2_search(const T* first, const T* last, const T* pattern, size_t m)
+        {
+            const __m128i head = sse2_broadcast(pattern[0]);
+            const __m128i tail = sse2_broadcast(pattern[m - 1]);
+            const T* const stop = last - (m - 1);
+            for (; stop - first >= 16; first += 16)
+            {
+                unsigned mask = sse2_eq_mask(sse2_load(first), head, simd_int8_tag()) &
+                                sse2_eq_mask(sse2_load(first + m - 1), tail, simd_int8_tag());
+                for (; mask != 0; mask &= mask - 1)
+                {
+                    const T* candidate = first + __builtin_ctz(mask);
+                    if (std::memcmp(candidate + 1, pattern + 1, m - 2) == 0)
+                        return candidate;
+                }
+            }
+            return mystl::search_bytes_tail(first, last, pattern, m);
+        }
+    // 区间按升序排列，每个寄存器中小于 value 的元素总在前部，第一个不小于 value 的位置
+    // 即为掩码中第一个为 0 的位；无符号数翻转最高位后按有符号数比较
+    template <class T>
+        const T* sse2_skip_less(const T* first, const T* last, T value)
+        {
+            const __m128i bias = _mm_set1_epi32(std::is_signed<T>::value ? 0 : INT_MIN);
+            const __m128i v = _mm_xor_si128(sse2_broadcast(value), bias);
+            for (; last - first >= 4; first += 4)
+            {
+                const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_cmpgt_epi32(v, _mm_xor_si128(sse2_load(first), bias))));
+                if (mask != 0xffffu)
+                    return first + __builtin_ctz(~mask) / 4;
+            }
+            return mystl::skip_less_tail(first, last, value);
+        }
+
+    // 逐个元素相加 / 相乘，整数按元素位宽回绕
+    inline __m128i sse2_add(__m128i a, __m128i b, simd_int8_tag)  { return _mm_add_epi8(a, b); }
+    inline __m128i sse2_add(__m128i a, __m128i b, simd_int16_tag) { return _mm_add_epi16(a, b); }
+    inline __m128i sse2_add(__m128i a, __m128i b, simd_int32_tag) { return _mm_add_epi32(a, b); }
+    inline __m128i sse2_add(__m128i a, __m128i b, simd_int64_tag) { return _mm_add_epi64(a, b); }
+
+    inline __m128i sse2_add(__m128i a, __m128i b, simd_float_tag)
+    {
+        return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+
+    inline __m128i sse2_add(__m128i a, __m128i b, simd_double_tag)
+    {
+        return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+
+    inline __m128i sse2_mul(__m128i a, __m128i b, simd_float_tag)
+    {
+        return _mm_castps_si128(_mm_mul_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+
+    inline __m128i sse2_mul(__m128i a, __m128i b, simd_double_tag)
+    {
+        return _mm_castpd_si128(_mm_mul_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+
+    // 把寄存器中的各个元素依次相加
+    template <class T>
+        T sse2_horizontal_sum(__m128i v)
+        {
+            T lanes[16 / sizeof(T)];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+            T sum = lanes[0];
+            for (size_t i = 1; i < 16 / sizeof(T); ++i)
+                sum = static_cast<T>(sum + lanes[i]);
+            return sum;
+        }
+
+    // 两个寄存器交替累加，隐藏加法的延迟
+    template <class T>
+        T sse2_sum(const T* first, const T* last)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 16 / sizeof(T);
+            __m128i acc0 = _mm_setzero_si128();
+            __m128i acc1 = _mm_setzero_si128();
+            for (; static_cast<size_t>(last - first) >= 2 * lanes; first += 2 * lanes)
+            {
+                acc0 = sse2_add(acc0, sse2_load(first), tag());
+                acc1 = sse2_add(acc1, sse2_load(first + lanes), tag());
+            }
+            acc0 = sse2_add(acc0, acc1, tag());
+            if (static_cast<size_t>(last - first) >= lanes)
+            {
+                acc0 = sse2_add(acc0, sse2_load(first), tag());
+                first += lanes;
+            }
+            T sum = sse2_horizontal_sum<T>(acc0);
+            for (; first != last; ++first)
+                sum = static_cast<T>(sum + *first);
+            return sum;
+        }
+
+    template <class T>
+        T sse2_dot(const T* first1, const T* last1, const T* first2)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 16 / sizeof(T);
+            __m128i acc0 = _mm_setzero_si128();
+            __m128i acc1 = _mm_setzero_si128();
+            for (; static_cast<size_t>(last1 - first1) >= 2 * lanes; first1 += 2 * lanes, first2 += 2 * lanes)
+            {
+                acc0 = sse2_add(acc0, sse2_mul(sse2_load(first1), sse2_load(first2), tag()), tag());
+                acc1 = sse2_add(acc1, sse2_mul(sse2_load(first1 + lanes),
+                                               sse2_load(first2 + lanes), tag()), tag());
+            }
+            acc0 = sse2_add(acc0, acc1, tag());
+            T sum = sse2_horizontal_sum<T>(acc0);
+            for (; first1 != last1; ++first1, ++first2)
+                sum += *first1 * *first2;
+            return sum;
+        }
+
+    /*****************************************************************************************/
+    // AVX2 内核
+    /*****************************************************************************************/
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_load(const void* p)
+    {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+    }
+
+    template <class T>
+        MYSTL_SIMD_AVX2 __m256i avx2_broadcast(T value)
+        {
+            T lanes[32 / sizeof(T)];
+            for (size_t i = 0; i < 32 / sizeof(T); ++i)
+                lanes[i] = value;
+            return avx2_load(lanes);
+        }
+
+    MYSTL_SIMD_AVX2 inline unsigned avx2_eq_mask(__m256i a, __m256i b, simd_int8_tag)
+    { return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+
+    MYSTL_SIMD_AVX2 inline unsigned avx2_eq_mask(__m256i a, __m256i b, simd_int16_tag)
+    { return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b))); }
+
+    MYSTL_SIMD_AVX2 inline unsigned avx2_eq_mask(__m256i a, __m256i b, simd_int32_tag)
+    { return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b))); }
+
+    MYSTL_SIMD_AVX2 inline unsigned avx2_eq_mask(__m256i a, __m256i b, simd_int64_tag)
+    { return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b))); }
+
+    MYSTL_SIMD_AVX2 inline unsigned avx2_eq_mask(__m256i a, __m256i b, simd_float_tag)
+    {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_castps_si256(
+            _mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ))));
+    }
+
+    MYSTL_SIMD_AVX2 inline unsigned avx2_eq_mask(__m256i a, __m256i b, simd_double_tag)
+    {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_castpd_si256(
+            _mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ))));
+    }
+
+    // 每次检查两个寄存器，减少循环判断的开销
+    template <class T>
+        MYSTL_SIMD_AVX2 const T* avx2_find(const T* first, const T* last, T value)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 32 / sizeof(T);
+            const __m256i v = avx2_broadcast(value);
+            for (; static_cast<size_t>(last - first) >= 2 * lanes; first += 2 * lanes)
+            {
+                const unsigned lo = avx2_eq_mask(avx2_load(first), v, tag());
+                const unsigned hi = avx2_eq_mask(avx2_load(first + lanes), v, tag());
+                if ((lo | hi) != 0)
+                {
+                    return lo != 0 ? first + __builtin_ctz(lo) / sizeof(T)
+                                   : first + lanes + __builtin_ctz(hi) / sizeof(T);
+                }
+            }
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+            {
+                const unsigned mask = avx2_eq_mask(avx2_load(first), v, tag());
+                if (mask != 0)
+                    return first + __builtin_ctz(mask) / sizeof(T);
+            }
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    return first;
+            }
+            return last;
+        }
+
+    template <class T>
+        MYSTL_SIMD_AVX2 size_t avx2_count(const T* first, const T* last, T value)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 32 / sizeof(T);
+            const __m256i v = avx2_broadcast(value);
+            size_t bytes = 0;
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+                bytes += __builtin_popcount(avx2_eq_mask(avx2_load(first), v, tag()));
+            size_t n = bytes / sizeof(T);
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    ++n;
+            }
+            return n;
+        }
+
+    template <class T>
+        MYSTL_SIMD_AVX2 bool avx2_equal(const T* first1, const T* last1, const T* first2)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 32 / sizeof(T);
+            for (; static_cast<size_t>(last1 - first1) >= lanes; first1 += lanes, first2 += lanes)
+            {
+                if (avx2_eq_mask(avx2_load(first1), avx2_load(first2), tag()) != 0xffffffffu)
+                    return false;
+            }
+            for (; first1 != last1; ++first1, ++first2)
+            {
+                if (!(*first1 == *first2))
+                    return false;
+            }
+            return true;
+        }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_add(__m256i a, __m256i b, simd_int8_tag)
+    { return _mm256_add_epi8(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_add(__m256i a, __m256i b, simd_int16_tag)
+    { return _mm256_add_epi16(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_add(__m256i a, __m256i b, simd_int32_tag)
+    { return _mm256_add_epi32(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_add(__m256i a, __m256i b, simd_int64_tag)
+    { return _mm256_add_epi64(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_add(__m256i a, __m256i b, simd_float_tag)
+    {
+        return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_add(__m256i a, __m256i b, simd_double_tag)
+    {
+        return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_mul(__m256i a, __m256i b, simd_float_tag)
+    {
+        return _mm256_castps_si256(_mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_mul(__m256i a, __m256i b, simd_double_tag)
+    {
+        return _mm256_castpd_si256(_mm256_mul_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+
+    template <class T>
+        MYSTL_SIMD_AVX2 const T* avx2_search(const T* first, const T* last, const T* pattern, size_t m)
+        {
+            const __m256i head = avx2_broadcast(pattern[0]);
+            const __m256i tail = avx2_broadcast(pattern[m - 1]);
+            const T* const stop = last - (m - 1);
+            for (; stop - first >= 32; first += 32)
+            {
+                unsigned mask = avx2_eq_mask(avx2_load(first), head, simd_int8_tag()) &
+                                avx2_eq_mask(avx2_load(first + m - 1), tail, simd_int8_tag());
+                for (; mask != 0; mask &= mask - 1)
+                {
+                    const T* candidate = first + __builtin_ctz(mask);
+                    if (std::memcmp(candidate + 1, pattern + 1, m - 2) == 0)
+                        return candidate;
+                }
+            }
+            return mystl::search_bytes_tail(first, last, pattern, m);
+        }
+    // 每次检查两个寄存器，较长的一段元素都小于 value 时减少循环判断的开销
+    template <class T>
+        MYSTL_SIMD_AVX2 const T* avx2_skip_less(const T* first, const T* last, T value)
+        {
+            const __m256i bias = _mm256_set1_epi32(std::is_signed<T>::value ? 0 : INT_MIN);
+            const __m256i v = _mm256_xor_si256(avx2_broadcast(value), bias);
+            for (; last - first >= 16; first += 16)
+            {
+                const unsigned lo = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_cmpgt_epi32(v, _mm256_xor_si256(avx2_load(first), bias))));
+                const unsigned hi = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_cmpgt_epi32(v, _mm256_xor_si256(avx2_load(first + 8), bias))));
+                if ((lo & hi) != 0xffffffffu)
+                {
+                    return lo != 0xffffffffu ? first + __builtin_ctz(~lo) / 4
+                                             : first + 8 + __builtin_ctz(~hi) / 4;
+                }
+            }
+            for (; last - first >= 8; first += 8)
+            {
+                const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_cmpgt_epi32(v, _mm256_xor_si256(avx2_load(first), bias))));
+                if (mask != 0xffffffffu)
+                    return first + __builtin_ctz(~mask) / 4;
+            }
+            return mystl::skip_less_tail(first, last, value);
+        }
+
+    // 逐个元素取较小 / 较大值，第二个标签表示整数是否有符号
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int8_tag, m_true_type)
+    { return _mm256_min_epi8(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int8_tag, m_false_type)
+    { return _mm256_min_epu8(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int16_tag, m_true_type)
+    { return _mm256_min_epi16(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int16_tag, m_false_type)
+    { return _mm256_min_epu16(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int32_tag, m_true_type)
+    { return _mm256_min_epi32(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int32_tag, m_false_type)
+    { return _mm256_min_epu32(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int64_tag, m_true_type)
+    { // AVX2 没有 64 位的 min / max，用比较结果选择
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_int64_tag, m_false_type)
+    { // 翻转符号位后按有符号数比较
+        const __m256i flip = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+        const __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, flip), _mm256_xor_si256(b, flip));
+        return _mm256_blendv_epi8(a, b, gt);
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_float_tag, m_true_type)
+    {
+        return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_min(__m256i a, __m256i b, simd_double_tag, m_true_type)
+    {
+        return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int8_tag, m_true_type)
+    { return _mm256_max_epi8(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int8_tag, m_false_type)
+    { return _mm256_max_epu8(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int16_tag, m_true_type)
+    { return _mm256_max_epi16(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int16_tag, m_false_type)
+    { return _mm256_max_epu16(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int32_tag, m_true_type)
+    { return _mm256_max_epi32(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int32_tag, m_false_type)
+    { return _mm256_max_epu32(a, b); }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int64_tag, m_true_type)
+    {
+        return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_int64_tag, m_false_type)
+    {
+        const __m256i flip = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+        const __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, flip), _mm256_xor_si256(b, flip));
+        return _mm256_blendv_epi8(b, a, gt);
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_float_tag, m_true_type)
+    {
+        return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_max(__m256i a, __m256i b, simd_double_tag, m_true_type)
+    {
+        return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    }
+
+    // 返回 NaN 元素的掩码，整数没有 NaN
+    template <class Tag>
+        MYSTL_SIMD_AVX2 __m256i avx2_unordered(__m256i, Tag)
+        {
+            return _mm256_setzero_si256();
+        }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_unordered(__m256i a, simd_float_tag)
+    {
+        const __m256 x = _mm256_castsi256_ps(a);
+        return _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    }
+
+    MYSTL_SIMD_AVX2 inline __m256i avx2_unordered(__m256i a, simd_double_tag)
+    {
+        const __m256d x = _mm256_castsi256_pd(a);
+        return _mm256_castpd_si256(_mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+    }
+
+    template <class T>
+        MYSTL_SIMD_AVX2 T avx2_horizontal_sum(__m256i v)
+        {
+            T lanes[32 / sizeof(T)];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), v);
+            T sum = lanes[0];
+            for (size_t i = 1; i < 32 / sizeof(T); ++i)
+                sum = static_cast<T>(sum + lanes[i]);
+            return sum;
+        }
+
+    // 四个寄存器交替累加
+    template <class T>
+        MYSTL_SIMD_AVX2 T avx2_sum(const T* first, const T* last)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 32 / sizeof(T);
+            __m256i acc0 = _mm256_setzero_si256();
+            __m256i acc1 = _mm256_setzero_si256();
+            __m256i acc2 = _mm256_setzero_si256();
+            __m256i acc3 = _mm256_setzero_si256();
+            for (; static_cast<size_t>(last - first) >= 4 * lanes; first += 4 * lanes)
+            {
+                acc0 = avx2_add(acc0, avx2_load(first), tag());
+                acc1 = avx2_add(acc1, avx2_load(first + lanes), tag());
+                acc2 = avx2_add(acc2, avx2_load(first + 2 * lanes), tag());
+                acc3 = avx2_add(acc3, avx2_load(first + 3 * lanes), tag());
+            }
+            for (; static_cast<size_t>(last - first) >= lanes; first += lanes)
+                acc0 = avx2_add(acc0, avx2_load(first), tag());
+            acc0 = avx2_add(avx2_add(acc0, acc1, tag()), avx2_add(acc2, acc3, tag()), tag());
+            T sum = avx2_horizontal_sum<T>(acc0);
+            for (; first != last; ++first)
+                sum = static_cast<T>(sum + *first);
+            return sum;
+        }
+
+    template <class T>
+        MYSTL_SIMD_AVX2 T avx2_dot(const T* first1, const T* last1, const T* first2)
+        {
+            typedef typename simd_tag<T>::type tag;
+            const size_t lanes = 32 / sizeof(T);
+            __m256i acc0 = _mm256_setzero_si256();
+            __m256i acc1 = _mm256_setzero_si256();
+            for (; static_cast<size_t>(last1 - first1) >= 2 * lanes; first1 += 2 * lanes, first2 += 2 * lanes)
+            {
+                acc0 = avx2_add(acc0, avx2_mul(avx2_load(first1), avx2_load(first2), tag()), tag());
+                acc1 = avx2_add(acc1, avx2_mul(avx2_load(first1 + lanes),
+                                               avx2_load(first2 + lanes), tag()), tag());
+            }
+            acc0 = avx2_add(acc0, acc1, tag());
+            T sum = avx2_horizontal_sum<T>(acc0);
+            for (; first1 != last1; ++first1, ++first2)
+                sum += *first1 * *first2;
+            return sum;
+        }
+
+    // 同时找出最小元素的第一次出现与最大元素的第一次(max_last 为 false)或最后一次出现
+    // 每 kSimdMinMaxBlock 个寄存器为一块，记录最值所在的块，最后只在该块中查找位置
+    // 区间含有 NaN 时返回 false，由调用者改用逐个比较的版本
+    template <class T>
+        MYSTL_SIMD_AVX2 bool avx2_minmax_element(const T* first, const T* last, const T*& min_pos,
+                                                 const T*& max_pos, bool max_last)
+        {
+            typedef typename simd_tag<T>::type           tag;
+            typedef m_bool_constant<std::is_signed<T>::value> sign;
+            const size_t lanes = 32 / sizeof(T);
+            const size_t block = lanes * kSimdMinMaxBlock;
+            T min_v = *first, max_v = *first;
+            const T* min_block = nullptr;
+            const T* max_block = nullptr;
+            const T* max_block_last = nullptr;
+            __m256i nan = _mm256_setzero_si256();
+            T buf[32 / sizeof(T)];
+            const T* p = first;
+            while (static_cast<size_t>(last - p) >= lanes)
+            {
+                const size_t avail = static_cast<size_t>(last - p) / lanes * lanes;
+                const T* e = p + (avail < block ? avail : block);
+                __m256i x = avx2_load(p);
+                __m256i lo = x, hi = x;
+                nan = _mm256_or_si256(nan, avx2_unordered(x, tag()));
+                for (const T* q = p + lanes; q != e; q += lanes)
+                {
+                    x = avx2_load(q);
+                    lo = avx2_min(lo, x, tag(), sign());
+                    hi = avx2_max(hi, x, tag(), sign());
+                    nan = _mm256_or_si256(nan, avx2_unordered(x, tag()));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), lo);
+                T block_min = buf[0];
+                for (size_t i = 1; i < lanes; ++i)
+                    block_min = buf[i] < block_min ? buf[i] : block_min;
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), hi);
+                T block_max = buf[0];
+                for (size_t i = 1; i < lanes; ++i)
+                    block_max = block_max < buf[i] ? buf[i] : block_max;
+                if (min_block == nullptr || block_min < min_v)
+                {
+                    min_v = block_min;
+                    min_block = p;
+                }
+                if (max_block == nullptr || (max_last ? !(block_max < max_v) : max_v < block_max))
+                {
+                    max_v = block_max;
+                    max_block = p;
+                    max_block_last = e;
+                }
+                p = e;
+            }
+            if (!_mm256_testz_si256(nan, nan))
+                return false;
+            min_pos = nullptr;
+            max_pos = nullptr;
+            for (; p != last; ++p)
+            {
+                if (!(*p == *p))
+                    return false;
+                if (*p < min_v)
+                {
+                    min_v = *p;
+                    min_pos = p;
+                }
+                if (max_last ? !(*p < max_v) : max_v < *p)
+                {
+                    max_v = *p;
+                    max_pos = p;
+                }
+            }
+            if (min_pos == nullptr)
+            {
+                for (min_pos = min_block; !(*min_pos == min_v); ++min_pos)
+                    ;
+            }
+            if (max_pos == nullptr)
+            {
+                if (max_last)
+                {
+                    for (max_pos = max_block_last - 1; !(*max_pos == max_v); --max_pos)
+                        ;
+                }
+                else
+                {
+                    for (max_pos = max_block; !(*max_pos == max_v); ++max_pos)
+                        ;
+                }
+            }
+            return true;
+        }
+
+#endif // MYSTL_HAS_SIMD
+
+    /*****************************************************************************************/
+    // 分派函数：优先使用 AVX2，其次 SSE2，都不可用时逐个元素比较
+    /*****************************************************************************************/
+
+    // 返回 [first, last) 中第一个等于 value 的元素的位置，没有找到时返回 last
+    template <class T>
+        const T* simd_find(const T* first, const T* last, T value)
+        {
+            if (first == last)
+                return last;
+            if (sizeof(T) == 1)
+            { // 单字节的查找直接使用 memchr
+                auto p = std::memchr(first, static_cast<unsigned char>(value),
+                                     static_cast<size_t>(last - first));
+                return p ? static_cast<const T*>(p) : last;
+            }
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_find(first, last, value);
+            return mystl::sse2_find(first, last, value);
+#else
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    return first;
+            }
+            return last;
+#endif
+        }
+
+    // 返回 [first1, last1) 中 [first2, last2) 首次出现的位置，没有找到时返回 last1
+    // 只支持单字节的元素类型
+    template <class T>
+        const T* simd_search(const T* first1, const T* last1, const T* first2, const T* last2)
+        {
+            const size_t m = static_cast<size_t>(last2 - first2);
+            if (m == 0)
+                return first1;
+            if (static_cast<size_t>(last1 - first1) < m)
+                return last1;
+            if (m == 1)
+                return mystl::simd_find(first1, last1, *first2);
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_search(first1, last1, first2, m);
+            return mystl::sse2_search(first1, last1, first2, m);
+#else
+            return mystl::search_bytes_tail(first1, last1, first2, m);
+#endif
+        }
+
+    // 返回升序区间 [first, last) 中第一个不小于 value 的元素的位置，没有时返回 last
+    // 从 first 开始顺序查找，适合分界点离起点较近的情形；只支持 4 字节的整数类型
+    template <class T>
+        const T* simd_skip_less(const T* first, const T* last, T value)
+        {
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_skip_less(first, last, value);
+            return mystl::sse2_skip_less(first, last, value);
+#else
+            return mystl::skip_less_tail(first, last, value);
+#endif
+        }
+
+    // 返回 [first, last) 中等于 value 的元素个数
+    template <class T>
+        size_t simd_count(const T* first, const T* last, T value)
+        {
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_count(first, last, value);
+            return mystl::sse2_count(first, last, value);
+#else
+            size_t n = 0;
+            for (; first != last; ++first)
+            {
+                if (*first == value)
+                    ++n;
+            }
+            return n;
+#endif
+        }
+
+    // 比较 [first1, last1) 与 first2 开始的区间是否相等
+    template <class T>
+        bool simd_equal(const T* first1, const T* last1, const T* first2)
+        {
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_equal(first1, last1, first2);
+            return mystl::sse2_equal(first1, last1, first2);
+#else
+            for (; first1 != last1; ++first1, ++first2)
+            {
+                if (!(*first1 == *first2))
+                    return false;
+            }
+            return true;
+#endif
+        }
+
+    // 返回 [first, last) 中所有元素的和，元素的相加顺序不确定
+    template <class T>
+        T simd_sum(const T* first, const T* last)
+        {
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_sum(first, last);
+            return mystl::sse2_sum(first, last);
+#else
+            T sum = T();
+            for (; first != last; ++first)
+                sum = static_cast<T>(sum + *first);
+            return sum;
+#endif
+        }
+
+    // 返回 [first1, last1) 与 first2 开始的区间的内积，只支持浮点类型，相加顺序不确定
+    template <class T>
+        T simd_dot(const T* first1, const T* last1, const T* first2)
+        {
+#if MYSTL_HAS_SIMD
+            if (simd_has_avx2())
+                return mystl::avx2_dot(first1, last1, first2);
+            return mystl::sse2_dot(first1, last1, first2);
+#else
+            T sum = T();
+            for (; first1 != last1; ++first1, ++first2)
+                sum += *first1 * *first2;
+            return sum;
+#endif
+        }
+
+    // 找出最小元素的第一次出现与最大元素的第一次或最后一次出现
+    // SSE2 缺少大部分整数的 min / max 指令，只在支持 AVX2 时使用 SIMD 内核，
+    // 返回 false 时(不支持 AVX2、区间过短或者含有 NaN)由调用者逐个比较
+    template <class T>
+        bool simd_minmax_element(const T* first, const T* last, const T*& min_pos,
+                                 const T*& max_pos, bool max_last)
+        {
+#if MYSTL_HAS_SIMD
+            if (static_cast<size_t>(last - first) >= 32 / sizeof(T) && simd_has_avx2())
+                return mystl::avx2_minmax_element(first, last, min_pos, max_pos, max_last);
+#else
+            (void)first; (void)last; (void)min_pos; (void)max_pos; (void)max_last;
+#endif
+            return false;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_SIMD_H_
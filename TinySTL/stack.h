@@ -1,12 +1,14 @@
 #ifndef TINYSTL_STACK_H
 #define TINYSTL_STACK_H
 
-#include "list.h"  // 包含底层容器list的头文件
+#include "list.h"    // 包含list与deque的头文件：使用 stack<T, mystl::list<T>> 或
+#include "deque.h"   // stack<T, mystl::deque<T>> 的已有代码依赖这两个包含
+#include "vector.h"  // 包含底层容器vector的头文件
 
 namespace mystl
 {
 
-    template <class T, class Container = mystl::list<T>>  // 模板类，T为元素类型，Container为底层容器类型，默认为mystl::list<T>
+    template <class T, class Container = mystl::vector<T>>  // 模板类，T为元素类型，Container为底层容器类型，默认为mystl::vector<T>
     class stack
     {
     public:
@@ -67,7 +69,7 @@ namespace mystl
             return *this;
         }
 
-        stack& operator=(const stack&& rhs)  // 移动赋值运算符
+        stack& operator=(stack&& rhs)  // 移动赋值运算符
         {
             c = mystl::move(rhs.c);
             return *this;
@@ -83,23 +85,26 @@ namespace mystl
         size_type size() const { return c.size(); }  // 返回栈的大小
         reference top() { return c.back(); }  // 返回栈顶元素的引用
         const_reference top() const { return c.back(); }  // 返回栈顶元素的常量引用
+        template <class... Args>
+        void emplace(Args&& ...args) { c.emplace_back(mystl::forward<Args>(args)...); }  // 在栈顶就地构造元素
         void push(const value_type& value) { c.push_back(value); }  // 入栈操作，将元素加入到栈顶
+        void push(value_type&& value) { c.push_back(mystl::move(value)); }  // 入栈操作（移动语义）
         void pop() { c.pop_back(); }  // 出栈操作，将栈顶元素删除
+        void reserve(size_type n) { c.reserve(n); }  // 预留容量，底层容器需支持 reserve
+        void shrink_to_fit() { c.shrink_to_fit(); }  // 释放多余的容量，底层容器需支持 shrink_to_fit
         void swap(stack& rhs) noexcept(noexcept(mystl::swap(c, rhs.c)))  // 交换两个栈的内容
         {
             mystl::swap(c, rhs.c);
         }
         void clear() { c.clear(); }  // 清空栈中的元素
 
-        bool operator==(const stack<T, Container>& x)  // 比较运算符==重载，判断两个栈是否相等
-        {
-            return c == x.c;
-        }
-
-        bool operator<(const stack<T, Container>& x)  // 比较运算符<重载，判断一个栈是否小于另一个栈
-        {
-            return c < x.c;
-        }
+        // 比较运算符重载，按底层容器比较两个栈
+        friend bool operator==(const stack& lhs, const stack& rhs) { return lhs.c == rhs.c; }
+        friend bool operator!=(const stack& lhs, const stack& rhs) { return !(lhs == rhs); }
+        friend bool operator< (const stack& lhs, const stack& rhs) { return lhs.c < rhs.c; }
+        friend bool operator> (const stack& lhs, const stack& rhs) { return rhs < lhs; }
+        friend bool operator<=(const stack& lhs, const stack& rhs) { return !(rhs < lhs); }
+        friend bool operator>=(const stack& lhs, const stack& rhs) { return !(lhs < rhs); }
 
 
     };
@@ -0,0 +1,690 @@
+#ifndef MYTINYSTL_STRING_VIEW_H_
+#define MYTINYSTL_STRING_VIEW_H_
+
+// 这个头文件包含一个类模板 basic_string_view，以及按分隔符惰性切分字符串的 split
+// basic_string_view: 不拥有字符的只读字符串视图，只保存指针与长度
+
+// notes:
+//
+// 视图只引用字符，使用期间被引用的字符串必须保持有效；substr、remove_prefix 等都不复制字符，也不分配内存
+// 所有字符操作都通过 CharTraits 进行，单字节字符且使用缺省的 char_traits 时，
+// 子串查找改用 simd_search(首尾字节过滤)
+// find_first_of 等查找字符集合的函数对单字节字符先以集合建立 256 位的位图，每个字符只需一次查表，
+// 其它字符类型对每个字符在集合中调用 traits_type::find
+// split 返回一个区间，迭代器递增时才查找下一个分隔符，每个片段都是原字符串的视图；
+// 与 Python 的 str.split(sep) 相同，相邻的分隔符之间以及首尾的分隔符之外都会得到空的片段
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+#include "basic_string.h"
+#include "iterator.h"
+#include "functional.h"
+#include "simd.h"
+#include "type_traits.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+    // 单字节字符的集合，以 256 位的位图表示
+    class byte_char_set
+    {
+        private:
+            uint64_t bits_[4];
+
+        public:
+            template <class CharType>
+                byte_char_set(const CharType* str, size_t n) noexcept
+                {
+                    bits_[0] = bits_[1] = bits_[2] = bits_[3] = 0;
+                    for (; n > 0; --n, ++str)
+                    {
+                        const unsigned char c = static_cast<unsigned char>(*str);
+                        bits_[c >> 6] |= uint64_t(1) << (c & 63);
+                    }
+                }
+
+            template <class CharType>
+                bool contains(CharType ch) const noexcept
+                {
+                    const unsigned char c = static_cast<unsigned char>(ch);
+                    return (bits_[c >> 6] >> (c & 63) & 1) != 0;
+                }
+    };
+
+    // 模板类 basic_string_view
+    // 参数一代表字符类型，参数二代表字符类型的萃取方式，缺省使用 mystl::char_traits
+    template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+        class basic_string_view
+        {
+            public:
+                typedef CharTraits                               traits_type;
+                typedef CharType                                 value_type;
+                typedef CharType*                                pointer;
+                typedef const CharType*                          const_pointer;
+                typedef CharType&                                reference;
+                typedef const CharType&                          const_reference;
+                typedef size_t                                   size_type;
+                typedef ptrdiff_t                                difference_type;
+
+                typedef const CharType*                          iterator;
+                typedef const CharType*                          const_iterator;
+                typedef mystl::reverse_iterator<const_iterator>  reverse_iterator;
+                typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+                static constexpr size_type npos = static_cast<size_type>(-1);
+
+            private:
+                const_pointer data_;
+                size_type     size_;
+
+            public:
+                // 构造函数，视图引用的字符串必须比视图活得更久
+                basic_string_view() noexcept
+                    :data_(nullptr), size_(0)
+                {
+                }
+
+                basic_string_view(const_pointer str, size_type count) noexcept
+                    :data_(str), size_(count)
+                {
+                }
+
+                basic_string_view(const_pointer str)
+                    :data_(str), size_(traits_type::length(str))
+                {
+                }
+
+                basic_string_view(const basic_string<CharType, CharTraits>& str) noexcept
+                    :data_(str.data()), size_(str.size())
+                {
+                }
+
+            public:
+                // 迭代器相关操作
+                const_iterator         begin()   const noexcept { return data_; }
+                const_iterator         end()     const noexcept { return data_ + size_; }
+                const_iterator         cbegin()  const noexcept { return data_; }
+                const_iterator         cend()    const noexcept { return data_ + size_; }
+
+                const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+                const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+                const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+                const_reverse_iterator crend()   const noexcept { return rend(); }
+
+                // 容量相关操作
+                bool      empty()    const noexcept { return size_ == 0; }
+                size_type size()     const noexcept { return size_; }
+                size_type length()   const noexcept { return size_; }
+                size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(CharType); }
+
+                // 访问元素相关操作
+                const_reference operator[](size_type n) const
+                {
+                    MYSTL_DEBUG(n < size_);
+                    return data_[n];
+                }
+
+                const_reference at(size_type n) const
+                {
+                    THROW_OUT_OF_RANGE_IF(n >= size_, "basic_string_view<Char, Traits>::at() subscript out of range");
+                    return data_[n];
+                }
+
+                const_reference front() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return data_[0];
+                }
+
+                const_reference back() const
+                {
+                    MYSTL_DEBUG(!empty());
+                    return data_[size_ - 1];
+                }
+
+                // 视图的字符不一定以空字符结尾
+                const_pointer data() const noexcept { return data_; }
+
+                // 修改视图的范围
+                void remove_prefix(size_type n)
+                {
+                    MYSTL_DEBUG(n <= size_);
+                    data_ += n;
+                    size_ -= n;
+                }
+
+                void remove_suffix(size_type n)
+                {
+                    MYSTL_DEBUG(n <= size_);
+                    size_ -= n;
+                }
+
+                void swap(basic_string_view& rhs) noexcept
+                {
+                    mystl::swap(data_, rhs.data_);
+                    mystl::swap(size_, rhs.size_);
+                }
+
+                // 复制 [pos, pos + count) 到 dst，返回复制的字符个数
+                size_type copy(pointer dst, size_type count, size_type pos = 0) const
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view<Char, Traits>::copy() position out of range");
+                    count = clamp(pos, count);
+                    traits_type::copy(dst, data_ + pos, count);
+                    return count;
+                }
+
+                // 返回 [pos, pos + count) 的视图，不复制字符
+                basic_string_view substr(size_type pos = 0, size_type count = npos) const
+                {
+                    THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view<Char, Traits>::substr() position out of range");
+                    return basic_string_view(data_ + pos, clamp(pos, count));
+                }
+
+                // 比较
+                int compare(basic_string_view v) const noexcept
+                {
+                    const int r = traits_type::compare(data_, v.data_, mystl::min(size_, v.size_));
+                    if (r != 0)
+                        return r;
+                    return size_ < v.size_ ? -1 : (v.size_ < size_ ? 1 : 0);
+                }
+                int compare(size_type pos1, size_type count1, basic_string_view v) const
+                { return substr(pos1, count1).compare(v); }
+                int compare(size_type pos1, size_type count1, basic_string_view v,
+                            size_type pos2, size_type count2) const
+                { return substr(pos1, count1).compare(v.substr(pos2, count2)); }
+                int compare(const_pointer str) const
+                { return compare(basic_string_view(str)); }
+                int compare(size_type pos1, size_type count1, const_pointer str) const
+                { return substr(pos1, count1).compare(basic_string_view(str)); }
+                int compare(size_type pos1, size_type count1, const_pointer str, size_type count2) const
+                { return substr(pos1, count1).compare(basic_string_view(str, count2)); }
+
+                // 前缀与后缀
+                bool starts_with(basic_string_view v) const noexcept
+                { return size_ >= v.size_ && traits_type::compare(data_, v.data_, v.size_) == 0; }
+                bool starts_with(value_type ch) const noexcept
+                { return size_ != 0 && data_[0] == ch; }
+                bool starts_with(const_pointer str) const
+                { return starts_with(basic_string_view(str)); }
+
+                bool ends_with(basic_string_view v) const noexcept
+                { return size_ >= v.size_ && traits_type::compare(data_ + size_ - v.size_, v.data_, v.size_) == 0; }
+                bool ends_with(value_type ch) const noexcept
+                { return size_ != 0 && data_[size_ - 1] == ch; }
+                bool ends_with(const_pointer str) const
+                { return ends_with(basic_string_view(str)); }
+
+                // 查找，找不到时返回 npos
+                size_type find(basic_string_view v, size_type pos = 0) const noexcept;
+                size_type find(value_type ch, size_type pos = 0) const noexcept;
+                size_type find(const_pointer str, size_type pos, size_type count) const noexcept
+                { return find(basic_string_view(str, count), pos); }
+                size_type find(const_pointer str, size_type pos = 0) const
+                { return find(basic_string_view(str), pos); }
+
+                size_type rfind(basic_string_view v, size_type pos = npos) const noexcept;
+                size_type rfind(value_type ch, size_type pos = npos) const noexcept;
+                size_type rfind(const_pointer str, size_type pos, size_type count) const noexcept
+                { return rfind(basic_string_view(str, count), pos); }
+                size_type rfind(const_pointer str, size_type pos = npos) const
+                { return rfind(basic_string_view(str), pos); }
+
+                size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept
+                {
+                    if (v.size_ == 1)
+                        return find(v.data_[0], pos);
+                    return scan_forward<true>(v, pos, m_bool_constant<sizeof(CharType) == 1>());
+                }
+                size_type find_first_of(value_type ch, size_type pos = 0) const noexcept
+                { return find(ch, pos); }
+                size_type find_first_of(const_pointer str, size_type pos, size_type count) const noexcept
+                { return find_first_of(basic_string_view(str, count), pos); }
+                size_type find_first_of(const_pointer str, size_type pos = 0) const
+                { return find_first_of(basic_string_view(str), pos); }
+
+                size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept
+                {
+                    if (v.size_ == 1)
+                        return rfind(v.data_[0], pos);
+                    return scan_backward<true>(v, pos, m_bool_constant<sizeof(CharType) == 1>());
+                }
+                size_type find_last_of(value_type ch, size_type pos = npos) const noexcept
+                { return rfind(ch, pos); }
+                size_type find_last_of(const_pointer str, size_type pos, size_type count) const noexcept
+                { return find_last_of(basic_string_view(str, count), pos); }
+                size_type find_last_of(const_pointer str, size_type pos = npos) const
+                { return find_last_of(basic_string_view(str), pos); }
+
+                size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept
+                { return scan_forward<false>(v, pos, m_bool_constant<sizeof(CharType) == 1>()); }
+                size_type find_first_not_of(value_type ch, size_type pos = 0) const noexcept
+                { return scan_forward<false>(basic_string_view(&ch, 1), pos, m_false_type()); }
+                size_type find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept
+                { return find_first_not_of(basic_string_view(str, count), pos); }
+                size_type find_first_not_of(const_pointer str, size_type pos = 0) const
+                { return find_first_not_of(basic_string_view(str), pos); }
+
+                size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept
+                { return scan_backward<false>(v, pos, m_bool_constant<sizeof(CharType) == 1>()); }
+                size_type find_last_not_of(value_type ch, size_type pos = npos) const noexcept
+                { return scan_backward<false>(basic_string_view(&ch, 1), pos, m_false_type()); }
+                size_type find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept
+                { return find_last_not_of(basic_string_view(str, count), pos); }
+                size_type find_last_not_of(const_pointer str, size_type pos = npos) const
+                { return find_last_not_of(basic_string_view(str), pos); }
+
+            private:
+                // 从 pos 起至多 count 个字符时实际的字符个数
+                size_type clamp(size_type pos, size_type count) const noexcept
+                { return mystl::min(count, size_ - pos); }
+
+                // 单字节字符且使用缺省的 char_traits 时，子串查找可以按字节比较
+                typedef m_bool_constant<sizeof(CharType) == 1 &&
+                    std::is_same<CharTraits, mystl::char_traits<CharType>>::value> byte_search;
+
+                size_type find_dispatch(basic_string_view v, size_type pos, m_true_type) const noexcept;
+                size_type find_dispatch(basic_string_view v, size_type pos, m_false_type) const noexcept;
+
+                // Match 为真时查找属于集合 v 的字符，为假时查找不属于集合 v 的字符
+                template <bool Match>
+                    size_type scan_forward(basic_string_view v, size_type pos, m_true_type) const noexcept;
+                template <bool Match>
+                    size_type scan_forward(basic_string_view v, size_type pos, m_false_type) const noexcept;
+                template <bool Match>
+                    size_type scan_backward(basic_string_view v, size_type pos, m_true_type) const noexcept;
+                template <bool Match>
+                    size_type scan_backward(basic_string_view v, size_type pos, m_false_type) const noexcept;
+        };
+
+    template <class CharType, class CharTraits>
+        constexpr typename basic_string_view<CharType, CharTraits>::size_type basic_string_view<CharType, CharTraits>::npos;
+
+    /*****************************************************************************************/
+    // find
+
+    template <class CharType, class CharTraits>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::find(basic_string_view v, size_type pos) const noexcept
+        {
+            if (v.size_ == 0)
+                return pos <= size_ ? pos : npos;
+            if (pos >= size_ || v.size_ > size_ - pos)
+                return npos;
+            return find_dispatch(v, pos, byte_search());
+        }
+
+    // 单字节字符：simd_search 同时比较候选起点处的首字节与尾字节
+    template <class CharType, class CharTraits>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::find_dispatch(basic_string_view v, size_type pos, m_true_type) const noexcept
+        {
+            const_pointer last = data_ + size_;
+            const_pointer r = mystl::simd_search(data_ + pos, last, v.data_, v.data_ + v.size_);
+            return r == last ? npos : static_cast<size_type>(r - data_);
+        }
+
+    // 其它字符类型：以 traits_type::find 跳到首字符出现的位置，再比较其余的字符
+    template <class CharType, class CharTraits>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::find_dispatch(basic_string_view v, size_type pos, m_false_type) const noexcept
+        {
+            const_pointer cur = data_ + pos;
+            const_pointer last = data_ + size_ - v.size_ + 1;  // 匹配的起点不能超过 last
+            while (cur < last)
+            {
+                cur = traits_type::find(cur, static_cast<size_type>(last - cur), v.data_[0]);
+                if (cur == nullptr)
+                    return npos;
+                if (traits_type::compare(cur + 1, v.data_ + 1, v.size_ - 1) == 0)
+                    return static_cast<size_type>(cur - data_);
+                ++cur;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::find(value_type ch, size_type pos) const noexcept
+        {
+            if (pos >= size_)
+                return npos;
+            const_pointer r = traits_type::find(data_ + pos, size_ - pos, ch);
+            return r == nullptr ? npos : static_cast<size_type>(r - data_);
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::rfind(basic_string_view v, size_type pos) const noexcept
+        {
+            if (v.size_ > size_)
+                return npos;
+            for (size_type i = mystl::min(pos, size_ - v.size_) + 1; i > 0; --i)
+            {
+                if (traits_type::compare(data_ + i - 1, v.data_, v.size_) == 0)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::rfind(value_type ch, size_type pos) const noexcept
+        {
+            if (size_ == 0)
+                return npos;
+            for (size_type i = mystl::min(pos, size_ - 1) + 1; i > 0; --i)
+            {
+                if (data_[i - 1] == ch)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    // 单字节字符：先以集合建立位图
+    template <class CharType, class CharTraits>
+        template <bool Match>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::scan_forward(basic_string_view v, size_type pos, m_true_type) const noexcept
+        {
+            const byte_char_set set(v.data_, v.size_);
+            for (size_type i = pos; i < size_; ++i)
+            {
+                if (set.contains(data_[i]) == Match)
+                    return i;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        template <bool Match>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::scan_forward(basic_string_view v, size_type pos, m_false_type) const noexcept
+        {
+            for (size_type i = pos; i < size_; ++i)
+            {
+                if ((traits_type::find(v.data_, v.size_, data_[i]) != nullptr) == Match)
+                    return i;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        template <bool Match>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::scan_backward(basic_string_view v, size_type pos, m_true_type) const noexcept
+        {
+            if (size_ == 0)
+                return npos;
+            const byte_char_set set(v.data_, v.size_);
+            for (size_type i = mystl::min(pos, size_ - 1) + 1; i > 0; --i)
+            {
+                if (set.contains(data_[i - 1]) == Match)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    template <class CharType, class CharTraits>
+        template <bool Match>
+        typename basic_string_view<CharType, CharTraits>::size_type
+        basic_string_view<CharType, CharTraits>::scan_backward(basic_string_view v, size_type pos, m_false_type) const noexcept
+        {
+            if (size_ == 0)
+                return npos;
+            for (size_type i = mystl::min(pos, size_ - 1) + 1; i > 0; --i)
+            {
+                if ((traits_type::find(v.data_, v.size_, data_[i - 1]) != nullptr) == Match)
+                    return i - 1;
+            }
+            return npos;
+        }
+
+    /*****************************************************************************************/
+    // 重载全局操作符
+
+    // 重载比较操作符
+    template <class CharType, class CharTraits>
+        bool operator==(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) noexcept
+        {
+            return lhs.size() == rhs.size() && CharTraits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator==(basic_string_view<CharType, CharTraits> lhs, const CharType* rhs)
+        {
+            return lhs == basic_string_view<CharType, CharTraits>(rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator==(const CharType* lhs, basic_string_view<CharType, CharTraits> rhs)
+        {
+            return basic_string_view<CharType, CharTraits>(lhs) == rhs;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator!=(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator!=(basic_string_view<CharType, CharTraits> lhs, const CharType* rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator!=(const CharType* lhs, basic_string_view<CharType, CharTraits> rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator<=(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class CharType, class CharTraits>
+        bool operator>=(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+    // 重载 mystl 的 swap
+    template <class CharType, class CharTraits>
+        void swap(basic_string_view<CharType, CharTraits>& lhs, basic_string_view<CharType, CharTraits>& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+    template <class CharType, class CharTraits>
+        std::basic_ostream<CharType>&
+        operator<<(std::basic_ostream<CharType>& os, basic_string_view<CharType, CharTraits> str)
+        {
+            return os << std::basic_string<CharType>(str.data(), str.size());
+        }
+
+    // 视图的哈希函数偏特化版本，与 basic_string 的结果相同
+    template <class CharType, class CharTraits>
+        struct hash<basic_string_view<CharType, CharTraits>>
+        {
+            size_t operator()(basic_string_view<CharType, CharTraits> str) const noexcept
+            {
+                return bitwise_hash(reinterpret_cast<const unsigned char*>(str.data()),
+                                    str.size() * sizeof(CharType));
+            }
+        };
+
+    typedef basic_string_view<char>     string_view;
+    typedef basic_string_view<wchar_t>  wstring_view;
+    typedef basic_string_view<char16_t> u16string_view;
+    typedef basic_string_view<char32_t> u32string_view;
+
+    /*****************************************************************************************/
+    // split
+
+    // 单个字符的分隔符
+    template <class CharType, class CharTraits>
+        struct split_char_delimiter
+        {
+            CharType ch;
+
+            size_t size() const noexcept { return 1; }
+            size_t find(basic_string_view<CharType, CharTraits> str) const noexcept { return str.find(ch); }
+        };
+
+    // 字符串分隔符，不能为空
+    template <class CharType, class CharTraits>
+        struct split_string_delimiter
+        {
+            basic_string_view<CharType, CharTraits> delim;
+
+            size_t size() const noexcept { return delim.size(); }
+            size_t find(basic_string_view<CharType, CharTraits> str) const noexcept { return str.find(delim); }
+        };
+
+    // 模板类 split_view
+    // 参数一代表字符类型，参数二代表字符类型的萃取方式，参数三代表分隔符的类型
+    template <class CharType, class CharTraits, class Delimiter>
+        class split_view
+        {
+            public:
+                typedef basic_string_view<CharType, CharTraits> value_type;
+
+                // 前向迭代器，指向的片段在迭代器中保存，递增时才查找下一个分隔符
+                class iterator
+                {
+                    public:
+                        typedef forward_iterator_tag iterator_category;
+                        typedef typename split_view::value_type value_type;
+                        typedef ptrdiff_t            difference_type;
+                        typedef const value_type*    pointer;
+                        typedef const value_type&    reference;
+
+                    private:
+                        value_type rest_;   // 当前片段及其之后的字符
+                        value_type token_;  // 当前片段
+                        Delimiter  delim_;
+                        bool       done_;
+
+                    public:
+                        iterator()
+                            :delim_(), done_(true)
+                        {
+                        }
+
+                        iterator(value_type str, Delimiter delim)
+                            :rest_(str), delim_(delim), done_(false)
+                        {
+                            next_token();
+                        }
+
+                        reference operator*()  const { return token_; }
+                        pointer   operator->() const { return &token_; }
+
+                        iterator& operator++()
+                        {
+                            MYSTL_DEBUG(!done_);
+                            if (token_.size() == rest_.size())
+                            {  // 最后一个片段
+                                done_ = true;
+                            }
+                            else
+                            {
+                                rest_.remove_prefix(token_.size() + delim_.size());
+                                next_token();
+                            }
+                            return *this;
+                        }
+
+                        iterator operator++(int)
+                        {
+                            iterator tmp = *this;
+                            ++*this;
+                            return tmp;
+                        }
+
+                        bool operator==(const iterator& rhs) const
+                        { return done_ == rhs.done_ && (done_ || token_.data() == rhs.token_.data()); }
+                        bool operator!=(const iterator& rhs) const
+                        { return !(*this == rhs); }
+
+                    private:
+                        void next_token()
+                        {
+                            const size_t i = delim_.find(rest_);
+                            token_ = value_type(rest_.data(), i == value_type::npos ? rest_.size() : i);
+                        }
+                };
+
+            private:
+                value_type str_;
+                Delimiter  delim_;
+
+            public:
+                split_view(value_type str, Delimiter delim)
+                    :str_(str), delim_(delim)
+                {
+                }
+
+                iterator begin() const { return iterator(str_, delim_); }
+                iterator end()   const { return iterator(); }
+        };
+
+    // 按分隔符切分字符串，返回由原字符串的视图组成的区间，n 个分隔符得到 n + 1 个片段
+    template <class CharType, class CharTraits>
+        split_view<CharType, CharTraits, split_char_delimiter<CharType, CharTraits>>
+        split(basic_string_view<CharType, CharTraits> str, CharType delim)
+        {
+            return split_view<CharType, CharTraits, split_char_delimiter<CharType, CharTraits>>(
+                str, split_char_delimiter<CharType, CharTraits>{ delim });
+        }
+
+    template <class CharType, class CharTraits>
+        split_view<CharType, CharTraits, split_string_delimiter<CharType, CharTraits>>
+        split(basic_string_view<CharType, CharTraits> str, basic_string_view<CharType, CharTraits> delim)
+        {
+            MYSTL_DEBUG(!delim.empty());
+            return split_view<CharType, CharTraits, split_string_delimiter<CharType, CharTraits>>(
+                str, split_string_delimiter<CharType, CharTraits>{ delim });
+        }
+
+    template <class CharType, class CharTraits>
+        split_view<CharType, CharTraits, split_string_delimiter<CharType, CharTraits>>
+        split(basic_string_view<CharType, CharTraits> str, const CharType* delim)
+        {
+            return mystl::split(str, basic_string_view<CharType, CharTraits>(delim));
+        }
+
+    // 片段引用 str 中的字符，因此不接受临时的字符串
+    template <class CharType, class CharTraits>
+        split_view<CharType, CharTraits, split_char_delimiter<CharType, CharTraits>>
+        split(const basic_string<CharType, CharTraits>& str, CharType delim)
+        {
+            return mystl::split(basic_string_view<CharType, CharTraits>(str), delim);
+        }
+
+    template <class CharType, class CharTraits>
+        void split(const basic_string<CharType, CharTraits>&& str, CharType delim) = delete;
+
+} // namespace mystl
+#endif // !MYTINYSTL_STRING_VIEW_H_
@@ -0,0 +1,544 @@
+#ifndef MYTINYSTL_THREAD_POOL_H_
+#define MYTINYSTL_THREAD_POOL_H_
+
+// 这个头文件包含一个工作窃取(work-stealing)线程池 thread_pool，是并行算法的执行引擎
+
+// notes:
+//
+// 每个工作线程拥有一个 Chase-Lev 双端队列 work_stealing_deque：
+// 线程自己从底部压入、弹出任务(LIFO)，其它线程从顶部窃取任务(FIFO)
+// 空闲的线程随机选择一个线程进行窃取，都失败时再检查外部线程提交的任务，最后进入睡眠
+//
+// 线程池只支持 fork/join 形式的任务：invoke(f1, f2) 把 f2 作为任务压入队列，
+// 当前线程执行 f1，然后在等待 f2 完成的同时帮助执行其它任务，因此任务对象可以放在栈上
+// 任务中抛出的异常会在 join 时重新抛出
+//
+// 工作线程的个数可以在构造时指定，为 0 时所有任务都在调用线程中直接执行
+// default_pool() 返回全局默认线程池，其线程个数由 set_default_concurrency 决定(需在首次使用前设置)
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <type_traits>
+
+#include "construct.h"  // 构造、析构对象
+#include "allocator.h"  // 内存分配
+#include "deque.h"      // 外部提交任务的队列
+#include "vector.h"     // 工作线程列表
+#include "util.h"       // 工具函数
+
+namespace mystl
+{
+
+#ifndef MYSTL_PARALLEL_GRAIN_SIZE
+#define MYSTL_PARALLEL_GRAIN_SIZE 2048  // 并行算法中每个任务至少处理的元素个数
+#endif
+
+#ifndef MYSTL_WORK_STEALING_INIT_SIZE
+#define MYSTL_WORK_STEALING_INIT_SIZE 256
+#endif
+
+    /*****************************************************************************************/
+    // pool_task
+    // 线程池中的任务，run 时捕获异常，完成后设置 done 标记
+    /*****************************************************************************************/
+    class pool_task
+    {
+        public:
+            pool_task() noexcept : done_(false) {}
+            virtual ~pool_task() {}
+
+            pool_task(const pool_task&) = delete;
+            pool_task& operator=(const pool_task&) = delete;
+
+            void run() noexcept
+            {
+                try
+                {
+                    execute();
+                }
+                catch (...)
+                {
+                    error_ = std::current_exception();
+                }
+                done_.store(true, std::memory_order_release);
+            }
+
+            bool done() const noexcept { return done_.load(std::memory_order_acquire); }
+
+            // 重新抛出任务中的异常
+            void rethrow() const
+            {
+                if (error_)
+                    std::rethrow_exception(error_);
+            }
+
+        protected:
+            virtual void execute() = 0;
+
+        private:
+            std::atomic<bool>  done_;   // 任务是否已完成
+            std::exception_ptr error_;  // 任务中抛出的异常
+    };
+
+    // 以可调用对象 f 的引用构造的任务
+    template <class Function>
+        class function_task : public pool_task
+        {
+            public:
+                explicit function_task(Function& f) noexcept : f_(f) {}
+
+            protected:
+                void execute() override { f_(); }
+
+            private:
+                Function& f_;
+        };
+
+    /*****************************************************************************************/
+    // work_stealing_deque
+    // Chase-Lev 双端队列，push / pop 只能由所有者线程调用，steal 可以由任意线程调用
+    // 空间不足时扩容为原来的两倍，旧的数组要等到队列析构时才释放，因为窃取者可能仍在读取
+    /*****************************************************************************************/
+    template <class T>
+        class work_stealing_deque
+        {
+            private:
+                // 环形数组
+                struct ring
+                {
+                    typedef mystl::allocator<std::atomic<T>> slot_allocator;
+
+                    ptrdiff_t       cap;    // 容量，为 2 的幂
+                    std::atomic<T>* slots;  // 槽位
+
+                    explicit ring(ptrdiff_t n)
+                        :cap(n), slots(slot_allocator::allocate(static_cast<size_t>(n)))
+                    {
+                        for (ptrdiff_t i = 0; i < n; ++i)
+                            mystl::construct(slots + i, T());
+                    }
+                    ~ring()
+                    { slot_allocator::deallocate(slots, static_cast<size_t>(cap)); }
+
+                    T    get(ptrdiff_t i) const noexcept { return slots[i & (cap - 1)].load(std::memory_order_relaxed); }
+                    void put(ptrdiff_t i, T x) noexcept  { slots[i & (cap - 1)].store(x, std::memory_order_relaxed); }
+                };
+                typedef mystl::allocator<ring> ring_allocator;
+
+                // top_ 与 bottom_ 之间填充一个缓存行，避免窃取者与所有者之间的伪共享
+                // 这里不使用 alignas，因为队列对象由 mystl::allocator 分配，不保证超过 max_align_t 的对齐
+                std::atomic<ptrdiff_t> top_;                                  // 窃取端
+                char                   pad_[64 - sizeof(std::atomic<ptrdiff_t>)];
+                std::atomic<ptrdiff_t> bottom_;                               // 所有者端
+                std::atomic<ring*>     array_;                                // 当前使用的数组
+                mystl::vector<ring*>   garbage_;                              // 扩容后废弃的数组
+
+            public:
+                explicit work_stealing_deque(ptrdiff_t n = MYSTL_WORK_STEALING_INIT_SIZE)
+                    :top_(0), bottom_(0), array_(nullptr)
+                { array_.store(create_ring(n), std::memory_order_relaxed); }
+
+                work_stealing_deque(const work_stealing_deque&) = delete;
+                work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+                ~work_stealing_deque()
+                {
+                    destroy_ring(array_.load(std::memory_order_relaxed));
+                    for (auto r : garbage_)
+                        destroy_ring(r);
+                }
+
+                bool empty() const noexcept
+                {
+                    return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+                }
+
+                void push(T x);
+                T    pop();
+                T    steal();
+
+            private:
+                static ring* create_ring(ptrdiff_t n)
+                {
+                    ring* r = ring_allocator::allocate();
+                    try
+                    {
+                        mystl::construct(r, n);
+                    }
+                    catch (...)
+                    {
+                        ring_allocator::deallocate(r);
+                        throw;
+                    }
+                    return r;
+                }
+                static void destroy_ring(ring* r)
+                {
+                    mystl::destroy(r);
+                    ring_allocator::deallocate(r);
+                }
+        };
+
+    // 所有者线程在底部压入任务
+    template <class T>
+        void work_stealing_deque<T>::push(T x)
+        {
+            const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+            const ptrdiff_t t = top_.load(std::memory_order_acquire);
+            ring* a = array_.load(std::memory_order_relaxed);
+            if (b - t > a->cap - 1)
+            { // 数组已满，扩容
+                ring* na = create_ring(a->cap * 2);
+                for (ptrdiff_t i = t; i < b; ++i)
+                    na->put(i, a->get(i));
+                garbage_.push_back(a);
+                array_.store(na, std::memory_order_release);
+                a = na;
+            }
+            a->put(b, x);
+            bottom_.store(b + 1, std::memory_order_release);
+        }
+
+    // 所有者线程从底部弹出任务，队列为空时返回 T()
+    template <class T>
+        T work_stealing_deque<T>::pop()
+        {
+            const ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+            ring* a = array_.load(std::memory_order_relaxed);
+            bottom_.store(b, std::memory_order_seq_cst);
+            ptrdiff_t t = top_.load(std::memory_order_seq_cst);
+            if (t > b)
+            { // 队列为空
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return T();
+            }
+            T x = a->get(b);
+            if (t == b)
+            { // 只剩最后一个任务，与窃取者竞争
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                    x = T();
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+            return x;
+        }
+
+    // 其它线程从顶部窃取任务，队列为空或竞争失败时返回 T()
+    template <class T>
+        T work_stealing_deque<T>::steal()
+        {
+            ptrdiff_t t = top_.load(std::memory_order_seq_cst);
+            const ptrdiff_t b = bottom_.load(std::memory_order_seq_cst);
+            if (t >= b)
+                return T();
+            ring* a = array_.load(std::memory_order_acquire);
+            T x = a->get(t);
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+                return T();
+            return x;
+        }
+
+    /*****************************************************************************************/
+    // thread_pool
+    // 工作窃取线程池
+    /*****************************************************************************************/
+    class thread_pool
+    {
+        private:
+            // 工作线程
+            struct worker
+            {
+                work_stealing_deque<pool_task*> tasks;   // 本线程的任务队列
+                std::thread                     thread;  // 线程对象
+            };
+            typedef mystl::allocator<worker> worker_allocator;
+
+            // 当前线程所属的线程池及其编号
+            struct context
+            {
+                thread_pool* pool;
+                size_t       index;
+            };
+
+            mystl::vector<worker*>    workers_;   // 工作线程
+            size_t                    grain_;     // 每个任务至少处理的元素个数
+            mystl::deque<pool_task*>  injected_;  // 外部线程提交的任务
+            std::mutex                mtx_;       // 保护 injected_ 与睡眠
+            std::condition_variable   cv_;        // 空闲线程在此等待
+            std::atomic<size_t>       pending_;   // 已提交但尚未被取走的任务个数
+            std::atomic<size_t>       sleeping_;  // 正在睡眠的线程个数
+            std::atomic<bool>         stop_;      // 是否停止
+
+        public:
+            // 创建一个有 n 个工作线程的线程池，n 为 0 时所有任务都在调用线程中执行
+            explicit thread_pool(size_t n = default_concurrency(),
+                                 size_t grain = MYSTL_PARALLEL_GRAIN_SIZE)
+                :grain_(grain == 0 ? 1 : grain), pending_(0), sleeping_(0), stop_(false)
+            {
+                workers_.reserve(n);
+                try
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        worker* w = worker_allocator::allocate();
+                        try
+                        {
+                            mystl::construct(w);
+                        }
+                        catch (...)
+                        {
+                            worker_allocator::deallocate(w);
+                            throw;
+                        }
+                        workers_.push_back(w);
+                    }
+                    for (size_t i = 0; i < n; ++i)
+                        workers_[i]->thread = std::thread(&thread_pool::worker_loop, this, i);
+                }
+                catch (...)
+                { // 创建线程失败：停止并等待已经启动的线程，释放所有工作线程后重新抛出异常
+                    shutdown();
+                    throw;
+                }
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            ~thread_pool()
+            { shutdown(); }
+
+        public:
+            size_t size() const noexcept { return workers_.size(); }
+
+            // 小于等于 grain_size 个元素的区间不再切分，由一个线程直接处理
+            size_t grain_size() const noexcept { return grain_; }
+            void   set_grain_size(size_t n) noexcept { grain_ = n == 0 ? 1 : n; }
+
+            // 判断长度为 n 的区间是否应当在当前线程中直接处理
+            bool   run_inline(size_t n) const noexcept { return workers_.empty() || n <= grain_; }
+
+            // fork/join：并行执行 f1 与 f2，两者都完成后返回
+            template <class F1, class F2>
+                void invoke(F1&& f1, F2&& f2);
+
+            // 提交一个任务，任务对象在完成前必须保持有效
+            void submit(pool_task* task);
+            // 等待任务完成，等待期间帮助执行其它任务，任务中的异常会被重新抛出
+            void wait(pool_task* task);
+
+            // 默认线程池
+            static thread_pool& default_pool()
+            {
+                static thread_pool pool(default_concurrency());
+                return pool;
+            }
+            static size_t default_concurrency() noexcept
+            {
+                const size_t n = default_concurrency_ref().load(std::memory_order_relaxed);
+                if (n != static_cast<size_t>(-1))
+                    return n;
+                const size_t hw = std::thread::hardware_concurrency();
+                return hw > 1 ? hw - 1 : 0;  // 调用线程也会参与计算
+            }
+            // 设置默认线程池的工作线程个数，需要在首次调用 default_pool 之前设置
+            static void set_default_concurrency(size_t n) noexcept
+            {
+                default_concurrency_ref().store(n, std::memory_order_relaxed);
+            }
+
+        private:
+            static std::atomic<size_t>& default_concurrency_ref() noexcept
+            {
+                static std::atomic<size_t> n(static_cast<size_t>(-1));
+                return n;
+            }
+            static context& current() noexcept
+            {
+                static thread_local context ctx = { nullptr, 0 };
+                return ctx;
+            }
+
+            void       join(pool_task* task) noexcept;
+            pool_task* find_task(size_t& seed) noexcept;
+            pool_task* take_injected() noexcept;
+            void       worker_loop(size_t index);
+            void       shutdown() noexcept;
+    };
+
+    /*****************************************************************************************/
+
+    template <class F1, class F2>
+        void thread_pool::invoke(F1&& f1, F2&& f2)
+        {
+            if (workers_.empty())
+            {
+                f1();
+                f2();
+                return;
+            }
+            function_task<typename std::remove_reference<F2>::type> task(f2);
+            submit(&task);
+            try
+            {
+                f1();
+            }
+            catch (...)
+            { // task 位于栈上，必须等它完成后才能离开
+                join(&task);
+                throw;
+            }
+            wait(&task);
+        }
+
+    inline void thread_pool::submit(pool_task* task)
+    {
+        if (workers_.empty())
+        { // 没有工作线程时直接在调用线程中执行，wait 随即返回
+            task->run();
+            return;
+        }
+        pending_.fetch_add(1, std::memory_order_seq_cst);
+        context& ctx = current();
+        if (ctx.pool == this)
+        {
+            workers_[ctx.index]->tasks.push(task);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            injected_.push_back(task);
+        }
+        if (sleeping_.load(std::memory_order_seq_cst) != 0)
+        {
+            { std::lock_guard<std::mutex> lk(mtx_); }
+            cv_.notify_one();
+        }
+    }
+
+    inline void thread_pool::wait(pool_task* task)
+    {
+        join(task);
+        task->rethrow();
+    }
+
+    inline void thread_pool::join(pool_task* task) noexcept
+    {
+        size_t seed = reinterpret_cast<size_t>(task);
+        while (!task->done())
+        {
+            pool_task* t = find_task(seed);
+            if (t != nullptr)
+                t->run();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    // 依次尝试：本线程的队列、随机窃取其它线程、外部提交的任务
+    inline pool_task* thread_pool::find_task(size_t& seed) noexcept
+    {
+        pool_task* t = nullptr;
+        context& ctx = current();
+        const bool is_worker = ctx.pool == this;
+        if (is_worker)
+            t = workers_[ctx.index]->tasks.pop();
+        if (t == nullptr && !workers_.empty())
+        {
+            // xorshift 随机选择窃取的起点
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            const size_t n = workers_.size();
+            const size_t start = seed % n;
+            for (size_t k = 0; k < n && t == nullptr; ++k)
+            {
+                const size_t victim = (start + k) % n;
+                if (!(is_worker && victim == ctx.index))
+                    t = workers_[victim]->tasks.steal();
+            }
+        }
+        if (t == nullptr)
+            t = take_injected();
+        if (t != nullptr)
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+        return t;
+    }
+
+    inline pool_task* thread_pool::take_injected() noexcept
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (injected_.empty())
+            return nullptr;
+        pool_task* t = injected_.front();
+        injected_.pop_front();
+        return t;
+    }
+
+    // 通知所有线程停止，全部 join 之后再释放工作线程，避免仍在运行的线程从已释放的队列中窃取任务
+    inline void thread_pool::shutdown() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stop_.store(true);
+        }
+        cv_.notify_all();
+        for (auto w : workers_)
+        {
+            if (w->thread.joinable())
+                w->thread.join();
+        }
+        for (auto w : workers_)
+        {
+            mystl::destroy(w);
+            worker_allocator::deallocate(w);
+        }
+        workers_.clear();
+    }
+
+    inline void thread_pool::worker_loop(size_t index)
+    {
+        context& ctx = current();
+        ctx.pool = this;
+        ctx.index = index;
+        size_t seed = index * 0x9e3779b97f4a7c15ULL + 1;
+        while (!stop_.load(std::memory_order_acquire))
+        {
+            pool_task* t = find_task(seed);
+            if (t != nullptr)
+            {
+                t->run();
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(mtx_);
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            while (!stop_.load(std::memory_order_relaxed) &&
+                   pending_.load(std::memory_order_seq_cst) == 0)
+                cv_.wait(lk);
+            sleeping_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /*****************************************************************************************/
+    // parallel_invoke
+    // 在默认线程池中并行执行若干个可调用对象，全部完成后返回
+    /*****************************************************************************************/
+    template <class F1, class F2>
+        void parallel_invoke(F1&& f1, F2&& f2)
+        {
+            thread_pool::default_pool().invoke(f1, f2);
+        }
+
+    template <class F1, class F2, class F3>
+        void parallel_invoke(F1&& f1, F2&& f2, F3&& f3)
+        {
+            thread_pool& pool = thread_pool::default_pool();
+            pool.invoke(f1, [&]() { pool.invoke(f2, f3); });
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_THREAD_POOL_H_
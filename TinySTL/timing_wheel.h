@@ -0,0 +1,326 @@
+#ifndef MYTINYSTL_TIMING_WHEEL_H_
+#define MYTINYSTL_TIMING_WHEEL_H_
+
+// 这个头文件包含一个类模板 timing_wheel
+// 分层时间轮：按到期时间(以 tick 计的无符号 64 位整数)调度大量定时器
+
+// notes:
+//
+// 共 11 层，每层 64 个槽，第 l 层的一个槽对应 64^l 个 tick
+// 到期时间为 d 的定时器放在 d 与当前时间 now 最高的不同的 6 位一组所在的层，槽号为 d 在该层的 6 位，
+// 因此第 0 层的槽中的定时器恰好在该 tick 到期，较高层的槽在时间进入其范围时整体下放(cascade)到低层
+// schedule 与 cancel 为 O(1)；每个定时器至多下放 10 次，advance 的均摊代价与定时器个数成正比
+// 每层以一个 64 位的掩码记录非空的槽，advance 直接跳到下一个非空槽对应的时间，不必逐个 tick 前进
+// 每个槽是一个连续的数组，保存到期时间与定时器的编号，下放时顺序读写，不必像链表那样逐个节点随机访问；
+// 取消只把定时器标记为失效，槽中的记录在下放或到期时被丢弃
+// 句柄是定时器的编号，定时器到期或取消后句柄失效，编号随后会被新的定时器重复使用
+// 同一 tick 到期的定时器按调度的先后次序触发；回调中可以调度或取消定时器，但不能再调用 advance，
+// 到期时间不晚于当前时间的定时器在下一次 advance 时触发：时间前进前先把它们从当前的槽中取出，
+// advance 结束时按新的当前时间重新放入，到期时间也随之改为新的当前时间
+
+#include <cstddef>
+#include <cstdint>
+
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+    // 模板类 timing_wheel
+    // 参数一代表定时器携带的值的类型
+    template <class T>
+        class timing_wheel
+        {
+            public:
+                typedef T         value_type;
+                typedef size_t    size_type;
+                typedef size_t    handle_type;
+                typedef uint64_t  time_type;
+
+            private:
+                static constexpr int kSlotBits = 6;
+                static constexpr int kSlots = 1 << kSlotBits;
+                static constexpr int kLevels = (64 + kSlotBits - 1) / kSlotBits;
+
+                struct timer
+                {
+                    T         value;
+                    time_type deadline;
+                    uint32_t  gen;     // 编号每被使用一次加一，用于识别槽中过期的记录
+                    bool      active;
+                };
+
+                struct entry
+                {
+                    time_type deadline;
+                    uint32_t  index;
+                    uint32_t  gen;
+                };
+
+                mystl::vector<timer>    timers_;   // 所有定时器，包括已经失效、等待重复使用的编号
+                mystl::vector<uint32_t> free_;     // 可以重复使用的编号
+                mystl::vector<entry>    slots_[kLevels][kSlots];
+                mystl::vector<entry>    firing_;   // 正在触发的槽
+                mystl::vector<entry>    deferred_; // advance 中调度到当时的当前时间、留到下一次 advance 的定时器
+                uint64_t                occupied_[kLevels];  // 每层非空的槽
+                time_type               now_;
+                size_type               size_;
+
+            public:
+                // 构造函数，now 为初始时间
+                explicit timing_wheel(time_type now = 0)
+                    :now_(now), size_(0)
+                {
+                    for (int l = 0; l < kLevels; ++l)
+                        occupied_[l] = 0;
+                }
+
+            public:
+                bool      empty() const noexcept { return size_ == 0; }
+                size_type size()  const noexcept { return size_; }
+                time_type now()   const noexcept { return now_; }
+
+                // 句柄 h 对应的定时器是否仍在等待
+                bool pending(handle_type h) const noexcept
+                { return h < timers_.size() && timers_[h].active; }
+
+                time_type deadline(handle_type h) const { return timers_[h].deadline; }
+
+                void reserve(size_type n) { timers_.reserve(n); }
+
+                // 调度一个在 deadline 到期的定时器，早于当前时间时视为当前时间，返回它的句柄
+                handle_type schedule(time_type deadline, const value_type& value)
+                {
+                    return schedule_aux(deadline, value);
+                }
+
+                handle_type schedule(time_type deadline, value_type&& value)
+                {
+                    return schedule_aux(deadline, mystl::move(value));
+                }
+
+                // 取消句柄 h 对应的定时器
+                void cancel(handle_type h)
+                {
+                    MYSTL_DEBUG(pending(h));
+                    static_cast<void>(T(mystl::move(timers_[h].value)));  // 立即释放值持有的资源
+                    release(static_cast<uint32_t>(h));
+                }
+
+                // 把时间推进到 now，依次对到期(deadline <= now)的定时器调用 f(deadline, value)，
+                // 返回触发的定时器个数
+                template <class Func>
+                    size_type advance(time_type now, Func f);
+
+                // 最早的到期时间的下界：从当前时间起第一个非空槽对应的时间，没有定时器时返回 UINT64_MAX
+                // 第 0 层的槽对应准确的到期时间，较高层的槽对应其范围的起点，槽中也可能只有已取消的定时器
+                time_type next_event() const noexcept
+                { return size_ == 0 ? UINT64_MAX : next_event_aux(true); }
+
+                void clear()
+                {
+                    timers_.clear();
+                    free_.clear();
+                    deferred_.clear();
+                    for (int l = 0; l < kLevels; ++l)
+                    {
+                        occupied_[l] = 0;
+                        for (int s = 0; s < kSlots; ++s)
+                            slots_[l][s].clear();
+                    }
+                    size_ = 0;
+                }
+
+            private:
+                static int bit_width(uint64_t x) noexcept
+                {
+#if defined(__GNUC__)
+                    return x == 0 ? 0 : 64 - __builtin_clzll(static_cast<unsigned long long>(x));
+#else
+                    int n = 0;
+                    for (; x != 0; x >>= 1)
+                        ++n;
+                    return n;
+#endif
+                }
+
+                static int count_trailing_zeros(uint64_t x) noexcept
+                {
+#if defined(__GNUC__)
+                    return __builtin_ctzll(static_cast<unsigned long long>(x));
+#else
+                    int n = 0;
+                    for (; (x & 1) == 0; x >>= 1)
+                        ++n;
+                    return n;
+#endif
+                }
+
+                static int slot_index(time_type t, int level) noexcept
+                { return static_cast<int>((t >> (level * kSlotBits)) & (kSlots - 1)); }
+
+                template <class V>
+                    handle_type schedule_aux(time_type deadline, V&& value);
+
+                time_type next_event_aux(bool include_current) const noexcept;
+
+                // 按到期时间与当前时间把记录放入对应的槽的尾部
+                void link(const entry& e)
+                {
+                    const int level = e.deadline == now_ ? 0 : (bit_width(e.deadline ^ now_) - 1) / kSlotBits;
+                    const int s = slot_index(e.deadline, level);
+                    slots_[level][s].push_back(e);
+                    occupied_[level] |= uint64_t(1) << s;
+                }
+
+                // 时间前进前把第 0 层当前的槽(回调中调度到当前时间的定时器)移入 deferred_
+                void defer_current()
+                {
+                    const int s = slot_index(now_, 0);
+                    if ((occupied_[0] >> s & 1) == 0)
+                        return;
+                    occupied_[0] &= ~(uint64_t(1) << s);
+                    mystl::vector<entry>& sl = slots_[0][s];
+                    for (const entry* e = sl.begin(); e != sl.end(); ++e)
+                        deferred_.push_back(*e);
+                    sl.clear();
+                }
+
+                bool live(const entry& e) const noexcept
+                { return timers_[e.index].gen == e.gen && timers_[e.index].active; }
+
+                void release(uint32_t i)
+                {
+                    timers_[i].active = false;
+                    ++timers_[i].gen;
+                    free_.push_back(i);
+                    --size_;
+                }
+        };
+
+    template <class T>
+        constexpr int timing_wheel<T>::kSlotBits;
+    template <class T>
+        constexpr int timing_wheel<T>::kSlots;
+    template <class T>
+        constexpr int timing_wheel<T>::kLevels;
+
+    template <class T>
+        template <class V>
+        typename timing_wheel<T>::handle_type
+        timing_wheel<T>::schedule_aux(time_type deadline, V&& value)
+        {
+            uint32_t i;
+            if (free_.empty())
+            {
+                MYSTL_DEBUG(timers_.size() < UINT32_MAX);
+                timers_.push_back(timer{ mystl::forward<V>(value), 0, 0, false });
+                i = static_cast<uint32_t>(timers_.size() - 1);
+            }
+            else
+            {
+                i = free_.back();
+                free_.pop_back();
+                timers_[i].value = mystl::forward<V>(value);
+            }
+            timer& t = timers_[i];
+            t.deadline = deadline < now_ ? now_ : deadline;
+            t.active = true;
+            link(entry{ t.deadline, i, t.gen });
+            ++size_;
+            return i;
+        }
+
+    // 各层中位于当前槽之后的第一个非空槽对应的时间的最小值，include_current 为真时包括第 0 层当前的槽
+    // 较低层的非空槽总是在当前较高层的槽的范围之内，早于较高层之后的任何一个槽
+    template <class T>
+        typename timing_wheel<T>::time_type
+        timing_wheel<T>::next_event_aux(bool include_current) const noexcept
+        {
+            for (int l = 0; l < kLevels; ++l)
+            {
+                if (occupied_[l] == 0)
+                    continue;
+                const int cur = slot_index(now_, l);
+                // 较高层的当前槽总是空的
+                const int from = l == 0 && include_current ? cur : cur + 1;
+                const uint64_t mask = from == kSlots ? 0 : ~uint64_t(0) << from;
+                const uint64_t later = occupied_[l] & mask;
+                if (later == 0)
+                    continue;
+                const int s = count_trailing_zeros(later);
+                const int shift = (l + 1) * kSlotBits;
+                const time_type base = shift >= 64 ? 0 : (now_ >> shift) << shift;
+                return base | (static_cast<time_type>(s) << (l * kSlotBits));
+            }
+            return UINT64_MAX;
+        }
+
+    template <class T>
+        template <class Func>
+        typename timing_wheel<T>::size_type
+        timing_wheel<T>::advance(time_type now, Func f)
+        {
+            size_type fired = 0;
+            // 第一轮包括当前时间的槽(上一次 advance 之后调度的、已经到期的定时器)，
+            // 之后每一轮都刚刚处理过当前时间的槽，其中新调度的定时器留到下一次 advance
+            for (bool include_current = true; size_ != 0; include_current = false)
+            {
+                const time_type next = next_event_aux(include_current);
+                if (next > now)
+                    break;
+                if (next != now_)
+                    defer_current();
+                now_ = next;
+                // 从高到低下放范围刚刚开始的槽，下放的定时器可能一直落到第 0 层当前的槽中
+                for (int l = kLevels - 1; l > 0; --l)
+                {
+                    const int s = slot_index(now_, l);
+                    if ((occupied_[l] >> s & 1) == 0)
+                        continue;
+                    occupied_[l] &= ~(uint64_t(1) << s);
+                    mystl::vector<entry>& sl = slots_[l][s];
+                    for (const entry* e = sl.begin(); e != sl.end(); ++e)
+                    {
+                        if (live(*e))
+                            link(*e);
+                    }
+                    sl.clear();
+                }
+                // 触发第 0 层当前的槽，先把它换出，回调中调度的定时器放入新的槽
+                const int s = slot_index(now_, 0);
+                occupied_[0] &= ~(uint64_t(1) << s);
+                firing_.swap(slots_[0][s]);
+                for (const entry* e = firing_.begin(); e != firing_.end(); ++e)
+                {
+                    if (!live(*e))
+                        continue;
+                    T value = mystl::move(timers_[e->index].value);
+                    release(e->index);
+                    ++fired;
+                    f(e->deadline, value);
+                }
+                firing_.clear();
+                if (slots_[0][s].empty())
+                    firing_.swap(slots_[0][s]);  // 保留槽原来的空间
+            }
+            if (now > now_)
+            {
+                defer_current();
+                now_ = now;
+            }
+            for (const entry* e = deferred_.begin(); e != deferred_.end(); ++e)
+            {
+                if (!live(*e))
+                    continue;
+                timers_[e->index].deadline = now_;
+                link(entry{ now_, e->index, e->gen });
+            }
+            deferred_.clear();
+            return fired;
+        }
+
+} // namespace mystl
+#endif // !MYTINYSTL_TIMING_WHEEL_H_
@@ -35,10 +35,11 @@ namespace mystl {
             }
             catch (...)
             {
-                for (; result != cur; --cur)
+                for (; result != cur; ++result)
                 {// 析构已经构造好的对象
-                    mystl::destroy(&*cur);
+                    mystl::destroy(&*result);
                 }
+                throw;
             }
             return cur;
         }
@@ -76,10 +77,11 @@ namespace mystl {
             }
             catch (...)
             {
-                for (; result != cur; --cur)
+                for (; result != cur; ++result)
                 {// 析构已经构造好的对象
-                    mystl::destroy(&*cur);
+                    mystl::destroy(&*result);
                 }
+                throw;
             }
             return cur;
         }
@@ -49,6 +49,10 @@ namespace mystl
             template<class ...Args>
                 void insert_aux(iterator position, Args&& ...args);
 
+            // 空间已满时在尾部构造元素：分配新空间，先构造新元素再移动原有元素
+            template<class ...Args>
+                void reallocate_emplace_back(Args&& ...args);
+
             void deallocate();                               // 释放内存
             void fill_initialize(size_type n, const T& value);     // 初始化，将n个元素置为value
             void try_init() noexcept;                         // 对象初始化
@@ -98,6 +102,7 @@ namespace mystl
             size_type max_size() const noexcept;                  // 返回容器的最大容量
             size_type capacity() const noexcept;                  // 返回容器的当前容量
             void      reserve(size_type n);                        // 分配内存空间，以便存储n个元素
+            void      shrink_to_fit();                             // 放弃多余的容量
 
             // 访问元素相关操作
             reference operator[](size_type n);                     // 重载[]运算符，返回索引为n的元素的引用
@@ -148,6 +153,283 @@ namespace mystl
             void resize(size_type new_size, const T& value);       // 调整容器的大小，并用value填充新添加的元素
         };
 
+
+    /****************************************************************/
+    // 构造、赋值、析构函数
+
+    template <class T>
+        vector<T>::vector()
+        {
+            try_init();
+        }
+
+    template <class T>
+        vector<T>::vector(size_type n)
+        {
+            fill_initialize(n, value_type());
+        }
+
+    template <class T>
+        vector<T>::vector(size_type n, const T& value)
+        {
+            fill_initialize(n, value);
+        }
+
+    template <class T>
+        template <class Iter, typename std::enable_if<
+        mystl::is_input_iterator<Iter>::value, int>::type>
+        vector<T>::vector(Iter first, Iter last)
+        {
+            range_initialize(first, last);
+        }
+
+    template <class T>
+        vector<T>::vector(const vector<T>& other)
+        {
+            range_initialize(other.start, other.finish);
+        }
+
+    template <class T>
+        vector<T>::vector(vector<T>&& other)
+        : start(other.start), finish(other.finish), end_of_storage(other.end_of_storage)
+        {
+            other.start = other.finish = other.end_of_storage = nullptr;
+        }
+
+    template <class T>
+        vector<T>::vector(std::initializer_list<T> ilist)
+        {
+            range_initialize(ilist.begin(), ilist.end());
+        }
+
+    template <class T>
+        vector<T>& vector<T>::operator=(std::initializer_list<T> ilist)
+        {
+            vector<T> tmp(ilist.begin(), ilist.end());
+            swap(tmp);
+            return *this;
+        }
+
+    template <class T>
+        vector<T>::~vector()
+        {
+            clear();
+        }
+
+    /****************************************************************/
+    // 迭代器相关操作
+
+    template <class T>
+        typename vector<T>::iterator vector<T>::begin() noexcept
+        { return start; }
+
+    template <class T>
+        typename vector<T>::const_iterator vector<T>::begin() const noexcept
+        { return start; }
+
+    template <class T>
+        typename vector<T>::iterator vector<T>::end() noexcept
+        { return finish; }
+
+    template <class T>
+        typename vector<T>::const_iterator vector<T>::end() const noexcept
+        { return finish; }
+
+    template <class T>
+        typename vector<T>::reverse_iterator vector<T>::rbegin() noexcept
+        { return reverse_iterator(end()); }
+
+    template <class T>
+        typename vector<T>::const_reverse_iterator vector<T>::rbegin() const noexcept
+        { return const_reverse_iterator(end()); }
+
+    template <class T>
+        typename vector<T>::reverse_iterator vector<T>::rend() noexcept
+        { return reverse_iterator(begin()); }
+
+    template <class T>
+        typename vector<T>::const_reverse_iterator vector<T>::rend() const noexcept
+        { return const_reverse_iterator(begin()); }
+
+    template <class T>
+        typename vector<T>::const_iterator vector<T>::cbegin() const noexcept
+        { return begin(); }
+
+    template <class T>
+        typename vector<T>::const_iterator vector<T>::cend() const noexcept
+        { return end(); }
+
+    template <class T>
+        typename vector<T>::const_reverse_iterator vector<T>::crbegin() const noexcept
+        { return rbegin(); }
+
+    template <class T>
+        typename vector<T>::const_reverse_iterator vector<T>::crend() const noexcept
+        { return rend(); }
+
+    /****************************************************************/
+    // 容器基本属性与元素访问
+
+    template <class T>
+        bool vector<T>::empty() const noexcept
+        { return start == finish; }
+
+    template <class T>
+        typename vector<T>::size_type vector<T>::size() const noexcept
+        { return static_cast<size_type>(finish - start); }
+
+    template <class T>
+        typename vector<T>::size_type vector<T>::max_size() const noexcept
+        { return static_cast<size_type>(-1) / sizeof(T); }
+
+    template <class T>
+        typename vector<T>::size_type vector<T>::capacity() const noexcept
+        { return static_cast<size_type>(end_of_storage - start); }
+
+    template <class T>
+        typename vector<T>::reference vector<T>::operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return *(start + n);
+        }
+
+    template <class T>
+        typename vector<T>::const_reference vector<T>::operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return *(start + n);
+        }
+
+    template <class T>
+        typename vector<T>::reference vector<T>::at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+    template <class T>
+        typename vector<T>::const_reference vector<T>::at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+    template <class T>
+        typename vector<T>::reference vector<T>::front()
+        {
+            MYSTL_DEBUG(!empty());
+            return *start;
+        }
+
+    template <class T>
+        typename vector<T>::const_reference vector<T>::front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *start;
+        }
+
+    template <class T>
+        typename vector<T>::reference vector<T>::back()
+        {
+            MYSTL_DEBUG(!empty());
+            return *(finish - 1);
+        }
+
+    template <class T>
+        typename vector<T>::const_reference vector<T>::back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *(finish - 1);
+        }
+
+    /****************************************************************/
+    // 修改容器相关操作
+
+    template <class T>
+        void vector<T>::assign(size_type n, const T& value)
+        {
+            fill_assign(n, value);
+        }
+
+    template <class T>
+        template <class Iter, typename std::enable_if<
+        mystl::is_input_iterator<Iter>::value, int>::type>
+        void vector<T>::assign(Iter first, Iter last)
+        {
+            copy_assign(first, last, iterator_category(first));
+        }
+
+    template <class T>
+        void vector<T>::assign(std::initializer_list<value_type> il)
+        {
+            copy_assign(il.begin(), il.end(), mystl::forward_iterator_tag{});
+        }
+
+    template <class T>
+        void vector<T>::push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+    template <class T>
+        void vector<T>::push_back(T&& value)
+        {
+            emplace_back(mystl::move(value));
+        }
+
+    template <class T>
+        void vector<T>::pop_back()
+        {
+            MYSTL_DEBUG(!empty());
+            data_allocator::destroy(finish - 1);
+            --finish;
+        }
+
+    template <class T>
+        typename vector<T>::iterator
+        vector<T>::insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+    template <class T>
+        typename vector<T>::iterator
+        vector<T>::insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, mystl::move(value));
+        }
+
+    template <class T>
+        typename vector<T>::iterator
+        vector<T>::insert(const_iterator pos)
+        {
+            return emplace(pos);
+        }
+
+    template <class T>
+        template <class Iter, typename std::enable_if<
+        mystl::is_input_iterator<Iter>::value, int>::type>
+        void vector<T>::insert(const_iterator pos, Iter first, Iter last)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos <= end());
+            range_insert(pos, first, last);
+        }
+
+    template <class T>
+        void vector<T>::reverse()
+        {
+            if (size() < 2)
+                return;
+            for (iterator first = start, last = finish - 1; first < last; ++first, --last)
+                mystl::iter_swap(first, last);
+        }
+
+    template <class T>
+        void vector<T>::resize(size_type new_size)
+        {
+            resize(new_size, value_type());
+        }
+
     /****************************************************************/
 
     template <class T>
@@ -210,11 +492,10 @@ namespace mystl
         template <class Iter>
         void vector<T>::range_initialize(Iter first, Iter last)
         {
-            /* 此处只考虑线性容器的迭代器 */
             // 初始化容量为 last - first 的空间，并使用 [first, last) 范围内的值填充每个元素
-            const size_type init_size = mystl::max(static_cast<size_type>(16),
-                    static_cast<size_type>(last - first));
-            space_initialize(static_cast<size_type>(last - first), init_size);
+            const size_type len = static_cast<size_type>(mystl::distance(first, last));
+            const size_type init_size = mystl::max(static_cast<size_type>(16), len);
+            space_initialize(len, init_size);
             mystl::uninitialized_copy(first, last, start);
         }
 
@@ -243,7 +524,7 @@ namespace mystl
                     // 如果当前大小小于 rhs 的大小，则先复制当前向量前 size() 个元素，再构造剩余的元素
                     mystl::copy(rhs.begin(), rhs.begin() + size(), start);
                     mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), finish);
-                    end_of_storage = finish = start + len;
+                    finish = start + len;
                 }
             }
             return *this;
@@ -272,7 +553,7 @@ namespace mystl
                 const auto old_size = size();
                 // 分配新的内存空间，并将原有元素移动到新空间中
                 auto tmp = data_allocator::allocate(n);
-                mystl::move((iterator)start, (iterator)finish, (iterator)tmp);
+                mystl::uninitialized_move(start, finish, tmp);
                 clear();
                 start = tmp;
                 finish = tmp + old_size;
@@ -280,6 +561,22 @@ namespace mystl
             }
         }
 
+    // 将容量收缩到与元素个数相同
+    template <class T>
+        void vector<T>::shrink_to_fit()
+        {
+            if (finish < end_of_storage)
+            {
+                const auto old_size = size();
+                auto tmp = data_allocator::allocate(old_size);
+                mystl::uninitialized_move(start, finish, tmp);
+                clear();
+                start = tmp;
+                finish = tmp + old_size;
+                end_of_storage = tmp + old_size;
+            }
+        }
+
     template <class T>
         void vector<T>::fill_assign(size_type n, const T& value)
         {
@@ -379,12 +676,46 @@ namespace mystl
             if (finish < end_of_storage)
             {
                 // 如果还有剩余空间，则直接在末尾构造元素
-                data_allocator::construct(end(), forward<Args>(args)...);
+                data_allocator::construct(end(), mystl::forward<Args>(args)...);
                 ++finish;
             }
             else
-                // 否则调用 insert_aux() 函数，在末尾插入元素
-                insert_aux(end(), forward<Args>(args)...);
+                // 否则重新分配空间后在末尾构造元素，不经过 insert_aux() 中移动元素的分支
+                reallocate_emplace_back(mystl::forward<Args>(args)...);
+        }
+
+    template <class T>
+        template <class ...Args>
+        void vector<T>::reallocate_emplace_back(Args&& ...args)
+        {
+            const size_type old_size = size();
+            const size_type len = old_size != 0 ? 2 * old_size : 1;
+            iterator new_start = data_allocator::allocate(len);
+            try
+            {
+                // 先构造新元素，args 引用容器中的元素时也是安全的
+                data_allocator::construct(new_start + old_size, mystl::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(new_start, len);
+                throw;
+            }
+            try
+            {
+                mystl::uninitialized_move(start, finish, new_start);
+            }
+            catch (...)
+            {
+                data_allocator::destroy(new_start + old_size);
+                data_allocator::deallocate(new_start, len);
+                throw;
+            }
+            data_allocator::destroy(start, finish);
+            data_allocator::deallocate(start, static_cast<size_type>(end_of_storage - start));
+            start = new_start;
+            finish = new_start + old_size + 1;
+            end_of_storage = new_start + len;
         }
 
     // insert
@@ -400,7 +731,7 @@ namespace mystl
                 data_allocator::construct(finish, *(finish - 1));
                 ++finish;
                 // 将 position 到 finish-2 之间的元素往后移动一位
-                copy_backward(position, finish - 2, finish - 1);
+                mystl::copy_backward(position, finish - 2, finish - 1);
                 // 在 position 处插入一个新元素
                 *position = value_type(mystl::forward<Args>(args)...);
             }
@@ -446,7 +777,7 @@ namespace mystl
                 data_allocator::construct(finish, *(finish - 1));
                 ++finish;
                 // 复制 position 到 finish-2 之间的元素往后移动一位
-                copy_backward(position, finish - 2, finish - 1);
+                mystl::copy_backward(position, finish - 2, finish - 1);
                 // 在 position 处插入一个新元素
                 *position = value;
             }
@@ -590,7 +921,7 @@ namespace mystl
                 else
                 {
                     const size_type old_size = size();
-                    const size_type len = old_size + max(old_size, n);
+                    const size_type len = old_size + mystl::max(old_size, n);
                     iterator new_start = data_allocator::allocate(len);
                     iterator new_finish = new_start;
                     try
@@ -680,6 +1011,51 @@ namespace mystl
             start = finish = end_of_storage = nullptr;
         }
 
+    // 重载比较操作符
+    template <class T>
+        bool operator==(const vector<T>& lhs, const vector<T>& rhs)
+        {
+            return lhs.size() == rhs.size() &&
+                mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+    template <class T>
+        bool operator<(const vector<T>& lhs, const vector<T>& rhs)
+        {
+            return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    template <class T>
+        bool operator!=(const vector<T>& lhs, const vector<T>& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    template <class T>
+        bool operator>(const vector<T>& lhs, const vector<T>& rhs)
+        {
+            return rhs < lhs;
+        }
+
+    template <class T>
+        bool operator<=(const vector<T>& lhs, const vector<T>& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+    template <class T>
+        bool operator>=(const vector<T>& lhs, const vector<T>& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    // 重载 mystl 的 swap
+    template <class T>
+        void swap(vector<T>& lhs, vector<T>& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
 } // namespace mystl
 
 #endif //TINYSTL_VECTOR_H